@@ -51,6 +51,24 @@ inline int lx_dup(int fd)
 }
 
 
+enum { LX_MFD_CLOEXEC = 0x1, LX_MFD_HUGETLB = 0x4 };
+
+/**
+ * Create anonymous memory file
+ *
+ * \return  file descriptor, or a negative error code
+ */
+inline int lx_memfd_create(char const *name, unsigned flags)
+{
+#ifdef SYS_memfd_create
+	return lx_syscall(SYS_memfd_create, name, flags);
+#else
+	enum { LX_ENOSYS = 38 };
+	return -LX_ENOSYS;
+#endif
+}
+
+
 /*******************************************************
  ** Functions used by core's rom-session support code **
  *******************************************************/
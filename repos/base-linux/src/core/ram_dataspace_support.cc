@@ -33,26 +33,138 @@ using namespace Genode;
 
 static int ram_ds_cnt = 0;  /* counter for creating unique dataspace IDs */
 
+
+/**
+ * List of Unix environment variables, initialized by the startup code
+ */
+extern char **lx_environ;
+
+
+/**
+ * Minimum size of RAM dataspaces backed by huge pages
+ *
+ * Huge pages are used only if core is started with the environment
+ * variable 'GENODE_HUGETLB_THRESHOLD' set to a size, e.g., "64M". The huge
+ * pages must be reserved at the host via '/proc/sys/vm/nr_hugepages'.
+ * Otherwise, regular pages are used.
+ *
+ * Components can attach such dataspaces only at huge-page-aligned addresses
+ * and offsets with huge-page-aligned sizes. The threshold should therefore
+ * select only large buffers that are attached as a whole, e.g., not program
+ * segments that the dynamic linker attaches at fixed addresses.
+ */
+static size_t hugetlb_threshold()
+{
+	struct Threshold
+	{
+		size_t value = 0;
+
+		Threshold()
+		{
+			char   const *key     = "GENODE_HUGETLB_THRESHOLD";
+			size_t const  key_len = Genode::strlen(key);
+
+			for (char **curr = lx_environ; curr && *curr; curr++) {
+				if (Genode::strcmp(*curr, key, key_len) == 0 && (*curr)[key_len] == '=') {
+					Number_of_bytes n { 0 };
+					ascii_to(*curr + key_len + 1, n);
+					value = n;
+				}
+			}
+		}
+	};
+
+	static Threshold threshold;
+	return threshold.value;
+}
+
+
+/**
+ * Create memory file of the given size
+ *
+ * \return  file descriptor, or a negative value on failure
+ */
+static int create_memfd(char const *name, size_t size, unsigned flags)
+{
+	int const fd = lx_memfd_create(name, LX_MFD_CLOEXEC | flags);
+	if (fd < 0)
+		return fd;
+
+	if (lx_ftruncate(fd, size) < 0) {
+		lx_close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+
+/**
+ * Create memory file backed by huge pages
+ *
+ * The huge pages of a shared mapping are reserved for the file at mapping
+ * time. By mapping the file once, we ensure that the pages are available,
+ * so that accesses of the dataspace cannot fail later on.
+ */
+static int create_hugetlb_memfd(char const *name, size_t size)
+{
+	enum { HUGE_PAGE_SIZE = 2*1024*1024 };
+
+	if (size % HUGE_PAGE_SIZE)
+		return -1;
+
+	int const fd = create_memfd(name, size, LX_MFD_HUGETLB);
+	if (fd < 0)
+		return fd;
+
+	void * const addr = lx_mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (((long)addr < 0) && ((long)addr > -4095)) {
+		lx_close(fd);
+		return -1;
+	}
+
+	lx_munmap(addr, size);
+	return fd;
+}
+
+
 void Ram_dataspace_factory::_export_ram_ds(Dataspace_component &ds)
 {
 	char fname[Linux_dataspace::FNAME_LEN];
+	snprintf(fname, sizeof(fname), "ds-%d", ram_ds_cnt++);
 
-	/* create file using a unique file name in the resource path */
-	snprintf(fname, sizeof(fname), "%s/ds-%d", resource_path(), ram_ds_cnt++);
-	lx_unlink(fname);
-	int const fd = lx_open(fname, O_CREAT|O_RDWR|O_TRUNC|LX_O_CLOEXEC, S_IRWXU);
-	lx_ftruncate(fd, ds.size());
+	/*
+	 * Create anonymous memory file, which does not involve any file-system
+	 * operations
+	 */
+	size_t const threshold = hugetlb_threshold();
+
+	int fd = -1;
+	if (threshold && ds.size() >= threshold)
+		fd = create_hugetlb_memfd(fname, ds.size());
+
+	if (fd < 0)
+		fd = create_memfd(fname, ds.size(), 0);
+
+	/* fall back to a file in the resource path if memfd is not supported */
+	if (fd < 0) {
+
+		snprintf(fname, sizeof(fname), "%s/ds-%d", resource_path(), ram_ds_cnt - 1);
+		lx_unlink(fname);
+		fd = lx_open(fname, O_CREAT|O_RDWR|O_TRUNC|LX_O_CLOEXEC, S_IRWXU);
+		lx_ftruncate(fd, ds.size());
+
+		/*
+		 * Wipe the file from the Linux file system. The kernel will still
+		 * keep the then unnamed file around until the last reference to the
+		 * file will be gone (i.e., an open file descriptor referring to the
+		 * file). A process w/o the right file descriptor won't be able to
+		 * open and access the file.
+		 */
+		lx_unlink(fname);
+	}
 
 	/* remember file descriptor in dataspace component object */
 	ds.fd(fd);
-
-	/*
-	 * Wipe the file from the Linux file system. The kernel will still keep the
-	 * then unnamed file around until the last reference to the file will be
-	 * gone (i.e., an open file descriptor referring to the file). A process
-	 * w/o the right file descriptor won't be able to open and access the file.
-	 */
-	lx_unlink(fname);
 }
 
 
@@ -17,7 +17,15 @@
 #include <base/stdint.h>
 #include <base/internal/server_socket_pair.h>
 
-namespace Genode { struct Native_thread; }
+namespace Genode {
+
+	struct Native_thread;
+
+	/**
+	 * Close the reply channel of a thread that is about to vanish
+	 */
+	void destroy_reply_channel(Native_thread &);
+}
 
 struct Genode::Native_thread
 {
@@ -48,6 +56,23 @@ struct Genode::Native_thread
 
 	Socket_pair socket_pair { };
 
+	/**
+	 * Socket pair for receiving RPC replies
+	 *
+	 * The pair is created by the first RPC call of the thread and reused by
+	 * all subsequent calls. The remote socket is passed to the server along
+	 * with each request. Each call is tagged with a sequence number, which
+	 * the server echoes in its reply.
+	 */
+	struct Reply_channel
+	{
+		int           local_sd  = -1;
+		int           remote_sd = -1;
+		unsigned long seq       =  0;
+	};
+
+	Reply_channel reply_channel { };
+
 	Native_thread() { }
 };
 
@@ -71,8 +71,11 @@ class Genode::Region_map_mmap : public Region_map, public Dataspace
 
 		/**
 		 * Map dataspace into local address space
+		 *
+		 * \param ds_size  size of the entire dataspace
 		 */
 		void *_map_local(Dataspace_capability ds,
+		                 size_t               ds_size,
 		                 size_t               size,
 		                 addr_t               offset,
 		                 bool                 use_local_addr,
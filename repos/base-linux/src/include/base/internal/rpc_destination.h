@@ -22,8 +22,14 @@ namespace Genode {
 	{
 		int socket = -1;
 
+		/* sequence number of the call, to be echoed by the reply */
+		unsigned long reply_seq = 0;
+
 		explicit Rpc_destination(int socket) : socket(socket) { }
 
+		Rpc_destination(int socket, unsigned long reply_seq)
+		: socket(socket), reply_seq(reply_seq) { }
+
 		Rpc_destination() { }
 	};
 
@@ -49,11 +49,13 @@ namespace {
  * The request message layout is:
  *
  *   long  local_name;
+ *   long  sequence number
  *   ...call arguments, starting with the opcode...
  *
  * Response messages look like this:
  *
  *   long  exception code
+ *   long  sequence number of the call
  *   ...call results...
  *
  * First data word of message, used to transfer the local name of the invoked
@@ -67,6 +69,9 @@ struct Protocol_header
 	/* badge of invoked object (on call) / exception code (on reply) */
 	unsigned long protocol_word;
 
+	/* sequence number of the call, echoed by the reply */
+	unsigned long seq;
+
 	Genode::size_t num_caps;
 
 	/* badges of the transferred capability arguments */
@@ -332,13 +337,15 @@ static void extract_sds_from_message(unsigned start_index,
 /**
  * Send reply to client
  */
-static inline void lx_reply(int reply_socket, Rpc_exception_code exception_code,
+static inline void lx_reply(Rpc_destination reply_dst, Rpc_exception_code exception_code,
                             Genode::Msgbuf_base &snd_msgbuf)
 {
+	int const reply_socket = reply_dst.socket;
 
 	Protocol_header &header = snd_msgbuf.header<Protocol_header>();
 
 	header.protocol_word = exception_code.value;
+	header.seq           = reply_dst.reply_seq;
 
 	Message msg(header.msg_start(), sizeof(Protocol_header) + snd_msgbuf.data_size());
 
@@ -363,6 +370,54 @@ static inline void lx_reply(int reply_socket, Rpc_exception_code exception_code,
  ** IPC client **
  ****************/
 
+static void close_reply_channel(Native_thread::Reply_channel &channel)
+{
+	if (channel.local_sd  != -1) lx_close(channel.local_sd);
+	if (channel.remote_sd != -1) lx_close(channel.remote_sd);
+
+	channel = Native_thread::Reply_channel();
+}
+
+
+void Genode::destroy_reply_channel(Native_thread &native_thread)
+{
+	close_reply_channel(native_thread.reply_channel);
+}
+
+
+/**
+ * Return reply channel of the calling thread, create it on first use
+ *
+ * Reusing the channel for all calls of a thread saves the creation and
+ * destruction of a socket pair per RPC.
+ */
+static Native_thread::Reply_channel &thread_reply_channel()
+{
+	/* the main thread is not represented by a 'Thread' object */
+	static Native_thread::Reply_channel main_reply_channel;
+
+	Thread * const myself = Thread::myself();
+
+	Native_thread::Reply_channel &channel =
+		myself ? myself->native_thread().reply_channel : main_reply_channel;
+
+	if (channel.local_sd != -1)
+		return channel;
+
+	int sd[2] = { -1, -1 };
+
+	int const ret = lx_socketpair(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0, sd);
+	if (ret < 0) {
+		raw("[", lx_gettid(), "] lx_socketpair failed with ", ret);
+		throw Genode::Ipc_error();
+	}
+
+	channel.local_sd  = sd[0];
+	channel.remote_sd = sd[1];
+	return channel;
+}
+
+
 Rpc_exception_code Genode::ipc_call(Native_capability dst,
                                     Msgbuf_base &snd_msgbuf, Msgbuf_base &rcv_msgbuf,
                                     size_t)
@@ -373,42 +428,15 @@ Rpc_exception_code Genode::ipc_call(Native_capability dst,
 	Message snd_msg(snd_header.msg_start(),
 	                sizeof(Protocol_header) + snd_msgbuf.data_size());
 
-	/*
-	 * Create reply channel
-	 *
-	 * The reply channel will be closed when leaving the scope of 'lx_call'.
-	 */
-	struct Reply_channel
-	{
-		enum { LOCAL_SOCKET = 0, REMOTE_SOCKET = 1 };
-		int sd[2];
-
-		Reply_channel()
-		{
-			sd[LOCAL_SOCKET] = -1; sd[REMOTE_SOCKET] = -1;
-
-			int ret = lx_socketpair(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0, sd);
-			if (ret < 0) {
-				raw("[", lx_gettid(), "] lx_socketpair failed with ", ret);
-				throw Genode::Ipc_error();
-			}
-		}
-
-		~Reply_channel()
-		{
-			if (sd[LOCAL_SOCKET]  != -1) lx_close(sd[LOCAL_SOCKET]);
-			if (sd[REMOTE_SOCKET] != -1) lx_close(sd[REMOTE_SOCKET]);
-		}
-
-		int local_socket()  const { return sd[LOCAL_SOCKET];  }
-		int remote_socket() const { return sd[REMOTE_SOCKET]; }
+	Native_thread::Reply_channel &reply_channel = thread_reply_channel();
 
-	} reply_channel;
+	unsigned long const seq = ++reply_channel.seq;
+	snd_header.seq = seq;
 
 	/* assemble message */
 
 	/* marshal reply capability */
-	snd_msg.marshal_socket(reply_channel.remote_socket());
+	snd_msg.marshal_socket(reply_channel.remote_sd);
 
 	/* marshal capabilities contained in 'snd_msgbuf' */
 	insert_sds_into_message(snd_msg, snd_header, snd_msgbuf);
@@ -429,10 +457,38 @@ Rpc_exception_code Genode::ipc_call(Native_capability dst,
 
 	Message rcv_msg(rcv_header.msg_start(),
 	                sizeof(Protocol_header) + rcv_msgbuf.capacity());
-	rcv_msg.accept_sockets(Message::MAX_SDS_PER_MSG);
 
-	rcv_msgbuf.reset();
-	int const recv_ret = lx_recvmsg(reply_channel.local_socket(), rcv_msg.msg(), 0);
+	/*
+	 * Any server that received the remote socket of the reply channel may
+	 * have kept it. Drop messages that do not carry the sequence number of
+	 * this call, e.g., late replies to canceled calls or forged replies,
+	 * along with the sockets they carry.
+	 */
+	bool stale = false;
+	int  recv_ret;
+	for (;;) {
+		rcv_msg.accept_sockets(Message::MAX_SDS_PER_MSG);
+		rcv_msgbuf.reset();
+
+		recv_ret = lx_recvmsg(reply_channel.local_sd, rcv_msg.msg(), 0);
+		if (recv_ret < 0)
+			break;
+
+		if ((size_t)recv_ret >= sizeof(Protocol_header) && rcv_header.seq == seq)
+			break;
+
+		for (unsigned i = 0; i < rcv_msg.num_sockets(); i++)
+			lx_close(rcv_msg.socket_at_index(i));
+
+		stale = true;
+	}
+
+	/*
+	 * The server may still reply to a canceled call. Replace the reply
+	 * channel so that no server can use the former remote socket anymore.
+	 */
+	if (recv_ret < 0 || stale)
+		close_reply_channel(reply_channel);
 
 	/* system call got interrupted by a signal */
 	if (recv_ret == -LX_EINTR)
@@ -456,9 +512,9 @@ Rpc_exception_code Genode::ipc_call(Native_capability dst,
 void Genode::ipc_reply(Native_capability caller, Rpc_exception_code exc,
                        Msgbuf_base &snd_msg)
 {
-	int const reply_socket = Capability_space::ipc_cap_data(caller).dst.socket;
+	Rpc_destination const reply_dst = Capability_space::ipc_cap_data(caller).dst;
 
-	try { lx_reply(reply_socket, exc, snd_msg); } catch (Ipc_error) { }
+	try { lx_reply(reply_dst, exc, snd_msg); } catch (Ipc_error) { }
 }
 
 
@@ -469,7 +525,7 @@ Genode::Rpc_request Genode::ipc_reply_wait(Reply_capability const &last_caller,
 {
 	/* when first called, there was no request yet */
 	if (last_caller.valid() && exc.value != Rpc_exception_code::INVALID_OBJECT)
-		lx_reply(Capability_space::ipc_cap_data(last_caller).dst.socket, exc, reply_msg);
+		lx_reply(Capability_space::ipc_cap_data(last_caller).dst, exc, reply_msg);
 
 	/*
 	 * Block infinitely if called from the main thread. This may happen if the
@@ -504,11 +560,13 @@ Genode::Rpc_request Genode::ipc_reply_wait(Reply_capability const &last_caller,
 
 		int           const reply_socket = msg.socket_at_index(0);
 		unsigned long const badge        = header.protocol_word;
+		unsigned long const reply_seq    = header.seq;
 
 		/* start at offset 1 to skip the reply channel */
 		extract_sds_from_message(1, msg, header, request_msg);
 
-		return Rpc_request(Capability_space::import(Rpc_destination(reply_socket),
+		return Rpc_request(Capability_space::import(Rpc_destination(reply_socket,
+		                                                            reply_seq),
 		                                            Rpc_obj_key()), badge);
 	}
 }
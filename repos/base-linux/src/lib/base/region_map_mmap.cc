@@ -60,6 +60,22 @@ static bool is_sub_rm_session(Dataspace_capability ds)
 }
 
 
+enum { HUGE_PAGE_SIZE = 2*1024*1024 };
+
+
+/**
+ * Return true if the file is backed by huge pages
+ *
+ * Core backs large RAM dataspaces by huge pages if configured. Such files
+ * can be mapped only at huge-page-aligned addresses, offsets, and sizes.
+ */
+static bool hugetlb_file(int fd)
+{
+	struct stat64 s;
+	return lx_fstat(fd, &s) == 0 && s.st_blksize >= HUGE_PAGE_SIZE;
+}
+
+
 /**
  * Lock for protecting mmap/unmap sequences and region-map meta data
  */
@@ -100,6 +116,32 @@ addr_t Region_map_mmap::_reserve_local(bool           use_local_addr,
 	int const flags       = MAP_ANONYMOUS | MAP_PRIVATE;
 	int const prot        = PROT_NONE;
 	void * const addr_in  = use_local_addr ? (void *)local_addr : 0;
+
+	/*
+	 * Align the reservation of large sub RM sessions to the huge-page size
+	 * so that huge-page-backed dataspaces can be attached within. For this,
+	 * we reserve an additional huge page and release the unaligned head and
+	 * tail.
+	 */
+	if (!use_local_addr && size >= HUGE_PAGE_SIZE) {
+		addr_t const addr = (addr_t)lx_mmap(0, size + HUGE_PAGE_SIZE, prot,
+		                                    flags, -1, 0);
+		if (((long)addr < 0) && ((long)addr > -4095)) {
+			error("_reserve_local: lx_mmap failed (addr_out=", (long)addr, ")");
+			throw Region_map::Region_conflict();
+		}
+
+		addr_t const aligned = align_addr(addr, log2((addr_t)HUGE_PAGE_SIZE));
+		addr_t const end     = aligned + align_addr(size, 12);
+
+		if (aligned > addr)
+			lx_munmap((void *)addr, aligned - addr);
+
+		lx_munmap((void *)end, addr + align_addr(size, 12) + HUGE_PAGE_SIZE - end);
+
+		return aligned;
+	}
+
 	void * const addr_out = lx_mmap(addr_in, size, prot, flags, -1, 0);
 
 	/* reserve at local address failed - unmap incorrect mapping */
@@ -118,6 +160,7 @@ addr_t Region_map_mmap::_reserve_local(bool           use_local_addr,
 
 
 void *Region_map_mmap::_map_local(Dataspace_capability ds,
+                                  Genode::size_t       ds_size,
                                   Genode::size_t       size,
                                   addr_t               offset,
                                   bool                 use_local_addr,
@@ -129,6 +172,28 @@ void *Region_map_mmap::_map_local(Dataspace_capability ds,
 	int  const  fd        = _dataspace_fd(ds);
 	bool const  writable  = _dataspace_writable(ds) && writeable;
 
+	/*
+	 * The kernel would reject unaligned mappings of huge-page-backed files
+	 * with EINVAL. Report the cause instead of a generic mmap error. Mappings
+	 * without a local address are placed at aligned addresses by the kernel.
+	 *
+	 * Core backs only dataspaces of a multiple of the huge-page size by
+	 * huge pages. So the file must be inspected only for the few unaligned
+	 * attachments of such dataspaces.
+	 */
+	bool const candidate = ds_size && (ds_size % HUGE_PAGE_SIZE) == 0;
+	bool const unaligned = (use_local_addr && (local_addr % HUGE_PAGE_SIZE))
+	                    || (offset % HUGE_PAGE_SIZE) || (size % HUGE_PAGE_SIZE);
+
+	if (candidate && unaligned && hugetlb_file(fd)) {
+		lx_close(fd);
+		error("_map_local: dataspace backed by huge pages must be attached "
+		      "at huge-page-aligned address, offset, and size "
+		      "(addr=", Hex(local_addr), ", offset=", Hex(offset), ", "
+		      "size=", Hex(size), ")");
+		throw Region_map::Region_conflict();
+	}
+
 	int  const  flags     = MAP_SHARED | (overmap ? MAP_FIXED : 0);
 	int  const  prot      = PROT_READ
 	                      | (writable   ? PROT_WRITE : 0)
@@ -156,6 +221,14 @@ void *Region_map_mmap::_map_local(Dataspace_capability ds,
 		throw Region_map::Region_conflict();
 	}
 
+	/*
+	 * Advise the kernel to back large writeable mappings by transparent huge
+	 * pages to relieve the TLB. The advice has no effect for files that
+	 * cannot be backed by huge pages.
+	 */
+	if (writable && size >= HUGE_PAGE_SIZE)
+		lx_madvise(addr_out, size, LX_MADV_HUGEPAGE);
+
 	return addr_out;
 }
 
@@ -188,8 +261,10 @@ Region_map::Local_addr Region_map_mmap::attach(Dataspace_capability ds,
 		throw Region_conflict();
 	}
 
-	size_t const remaining_ds_size = _dataspace_size(ds) > (addr_t)offset
-	                               ? _dataspace_size(ds) - (addr_t)offset : 0;
+	size_t const ds_size = _dataspace_size(ds);
+
+	size_t const remaining_ds_size = ds_size > (addr_t)offset
+	                               ? ds_size - (addr_t)offset : 0;
 
 	/* determine size of virtual address region */
 	size_t const region_size = size ? min(remaining_ds_size, size)
@@ -240,7 +315,7 @@ Region_map::Local_addr Region_map_mmap::attach(Dataspace_capability ds,
 		 * argument as the region was reserved by a PROT_NONE mapping.
 		 */
 		if (_is_attached())
-			_map_local(ds, region_size, offset, true, _base + (addr_t)local_addr, executable, true, writeable);
+			_map_local(ds, ds_size, region_size, offset, true, _base + (addr_t)local_addr, executable, true, writeable);
 
 		return (void *)local_addr;
 
@@ -289,7 +364,8 @@ Region_map::Local_addr Region_map_mmap::attach(Dataspace_capability ds,
 				 * We have to enforce the mapping via the 'overmap' argument as
 				 * the region was reserved by a PROT_NONE mapping.
 				 */
-				_map_local(region.dataspace(), region.size(), region.offset(),
+				_map_local(region.dataspace(), _dataspace_size(region.dataspace()),
+				           region.size(), region.offset(),
 				           true, rm->_base + region.start() + region.offset(),
 				           executable, true, writeable);
 			}
@@ -304,7 +380,7 @@ Region_map::Local_addr Region_map_mmap::attach(Dataspace_capability ds,
 			 * Boring, a plain dataspace is attached to a root RM session.
 			 * Note, we do not overmap.
 			 */
-			void *addr = _map_local(ds, region_size, offset, use_local_addr,
+			void *addr = _map_local(ds, ds_size, region_size, offset, use_local_addr,
 			                        local_addr, executable, false, writeable);
 
 			_add_to_rmap(Region((addr_t)addr, offset, ds, region_size));
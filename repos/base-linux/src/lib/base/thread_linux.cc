@@ -132,6 +132,8 @@ void Thread::_deinit_platform_thread()
 		lx_nanosleep(&ts, 0);
 	}
 
+	destroy_reply_channel(native_thread());
+
 	/* inform core about the killed thread */
 	_cpu_session->kill_thread(_thread_cap);
 }
@@ -561,6 +561,8 @@ Thread::~Thread()
 	if (meta_data)
 		destroy(global_alloc(), meta_data);
 
+	destroy_reply_channel(native_thread());
+
 	_native_thread = nullptr;
 
 	/* inform core about the killed thread */
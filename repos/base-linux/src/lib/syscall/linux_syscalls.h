@@ -52,6 +52,7 @@
 #include <sys/un.h>
 #include <sys/socket.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 
 
 #undef size_t
@@ -214,6 +215,24 @@ inline int lx_munmap(void *addr, Genode::size_t length)
 }
 
 
+inline int lx_fstat(int fd, struct stat64 *buf)
+{
+#ifdef _LP64
+	return lx_syscall(SYS_fstat, fd, buf);
+#else
+	return lx_syscall(SYS_fstat64, fd, buf);
+#endif
+}
+
+
+enum { LX_MADV_HUGEPAGE = 14 };
+
+inline int lx_madvise(void *addr, Genode::size_t length, int advice)
+{
+	return lx_syscall(SYS_madvise, addr, length, advice);
+}
+
+
 /***********************************************************************
  ** Functions used by thread lib and core's cancel-blocking mechanism **
  ***********************************************************************/
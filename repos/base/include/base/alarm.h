@@ -15,6 +15,7 @@
 #define _INCLUDE__BASE__ALARM_H_
 
 #include <base/lock.h>
+#include <util/pairing_heap.h>
 
 namespace Genode {
 	class Alarm_scheduler;
@@ -22,7 +23,7 @@ namespace Genode {
 }
 
 
-class Genode::Alarm
+class Genode::Alarm : private Pairing_heap<Alarm>::Element
 {
 	public:
 
@@ -31,6 +32,7 @@ class Genode::Alarm
 	private:
 
 		friend class Alarm_scheduler;
+		friend class Pairing_heap<Alarm>;
 
 		struct Raw
 		{
@@ -44,7 +46,6 @@ class Genode::Alarm
 		Lock             _dispatch_lock { };          /* taken during handle method   */
 		Raw              _raw           { };
 		int              _active        { 0 };        /* set to one when active       */
-		Alarm           *_next          { nullptr };  /* next alarm in alarm list     */
 		Alarm_scheduler *_scheduler     { nullptr };  /* currently assigned scheduler */
 
 		void _assign(Time             period,
@@ -59,7 +60,7 @@ class Genode::Alarm
 		}
 
 		void _reset() {
-			_assign(0, 0, false, 0), _active = 0, _next = 0; }
+			_assign(0, 0, false, 0), _active = 0; }
 
 		/*
 		 * Noncopyable
@@ -90,11 +91,17 @@ class Genode::Alarm_scheduler
 {
 	private:
 
-		Lock         _lock       { };         /* protect alarm list                     */
-		Alarm       *_head       { nullptr }; /* head of alarm list                     */
-		Alarm::Time  _now        { 0UL };     /* recent time (updated by handle method) */
-		bool         _now_period { false };
-		Alarm::Raw   _min_handle_period { };
+		Lock                _lock       { };      /* protect alarm queue                    */
+		Pairing_heap<Alarm> _queue      { };      /* alarms ordered by deadline             */
+		Alarm::Time         _now        { 0UL };  /* recent time (updated by handle method) */
+		bool                _now_period { false };
+		Alarm::Raw           _min_handle_period { };
+
+		/**
+		 * Return true if the deadline of alarm 'a' is not after the one of 'b'
+		 */
+		static bool _precedes(Alarm const &a, Alarm const &b) {
+			return a._raw.is_pending_at(b._raw.deadline, b._raw.deadline_period); }
 
 		/**
 		 * Enqueue alarm into alarm queue
@@ -109,7 +116,7 @@ class Genode::Alarm_scheduler
 		void _unsynchronized_dequeue(Alarm *alarm);
 
 		/**
-		 * Dequeue next pending alarm from alarm list
+		 * Dequeue next pending alarm from alarm queue
 		 *
 		 * \return  dequeued pending alarm
 		 * \retval  0  no alarm pending
@@ -183,7 +190,7 @@ class Genode::Alarm_scheduler
 		 * \param alarm  alarm object
 		 * \return true if alarm is head element of timeout queue
 		 */
-		bool head_timeout(const Alarm * alarm) { return _head == alarm; }
+		bool head_timeout(const Alarm * alarm) { return _queue.first() == alarm; }
 };
 
 #endif /* _INCLUDE__BASE__ALARM_H_ */
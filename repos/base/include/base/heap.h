@@ -25,6 +25,7 @@ namespace Genode {
 
 	class Heap;
 	class Sliced_heap;
+	class Thread;
 }
 
 
@@ -89,7 +90,22 @@ class Genode::Heap : public Allocator
 					ram_alloc = ram, region_map = rm; }
 		};
 
+		/*
+		 * Optional front end for small allocations, enabled via
+		 * 'enable_size_class_caches'
+		 */
+		struct Size_class_cache;
+
+		friend void release_heap_slots(Thread &);
+
+		/*
+		 * Noncopyable
+		 */
+		Heap(Heap const &);
+		Heap &operator = (Heap const &);
+
 		Lock                           _lock { };
+		Size_class_cache              *_cache { nullptr };
 		Reconstructible<Allocator_avl> _alloc;        /* local allocator    */
 		Dataspace_pool                 _ds_pool;      /* list of dataspaces */
 		size_t                         _quota_limit { 0 };
@@ -151,6 +167,24 @@ class Genode::Heap : public Allocator
 		void reassign_resources(Ram_allocator *ram, Region_map *rm) {
 			_ds_pool.reassign_resources(ram, rm); }
 
+		/**
+		 * Serve small allocations from size-class caches
+		 *
+		 * Once enabled, allocations of up to 1 KiB are served from free
+		 * lists per size class. Each thread keeps a few free blocks per
+		 * size class such that most allocations and deallocations neither
+		 * take the heap lock nor search the AVL tree of the heap. Larger
+		 * allocations are not affected.
+		 *
+		 * The memory of the size-class caches is held in dedicated
+		 * dataspaces, which are not released before the destruction of
+		 * the heap. Free blocks kept by threads do not count as consumed.
+		 * They are returned to the heap when their thread is destructed.
+		 *
+		 * \return  false if the size-class caches could not be allocated
+		 */
+		bool enable_size_class_caches();
+
 
 		/*************************
 		 ** Allocator interface **
@@ -158,7 +192,7 @@ class Genode::Heap : public Allocator
 
 		bool   alloc(size_t, void **) override;
 		void   free(void *, size_t) override;
-		size_t consumed() const override { return _quota_used; }
+		size_t consumed() const override;
 		size_t overhead(size_t size) const override { return _alloc->overhead(size); }
 		bool   need_size_for_free() const override { return false; }
 };
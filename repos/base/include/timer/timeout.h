@@ -24,6 +24,7 @@
 #include <base/lock.h>
 #include <base/log.h>
 #include <base/duration.h>
+#include <util/pairing_heap.h>
 
 namespace Genode {
 
@@ -152,9 +153,10 @@ class Genode::Timeout : private Noncopyable
 
 	private:
 
-		class Alarm
+		class Alarm : private Pairing_heap<Alarm>::Element
 		{
 			friend class Alarm_timeout_scheduler;
+			friend class Pairing_heap<Alarm>;
 
 			private:
 
@@ -172,7 +174,7 @@ class Genode::Timeout : private Noncopyable
 				Lock                     _dispatch_lock { };
 				Raw                      _raw           { };
 				int                      _active        { 0 };
-				Alarm                   *_next          { nullptr };
+				Alarm                   *_next          { nullptr };  /* in pending list */
 				Alarm_timeout_scheduler *_scheduler     { nullptr };
 
 				void _alarm_assign(Time                     period,
@@ -238,13 +240,16 @@ class Genode::Alarm_timeout_scheduler : private Noncopyable,
 
 		using Alarm = Timeout::Alarm;
 
-		Time_source     &_time_source;
-		Lock             _lock              { };
-		Alarm           *_active_head       { nullptr };
-		Alarm           *_pending_head      { nullptr };
-		Alarm::Time      _now               { 0UL };
-		bool             _now_period        { false };
-		Alarm::Raw       _min_handle_period { };
+		Time_source         &_time_source;
+		Lock                 _lock              { };
+		Pairing_heap<Alarm>  _active_queue      { };
+		Alarm               *_pending_head      { nullptr };
+		Alarm::Time          _now               { 0UL };
+		bool                 _now_period        { false };
+		Alarm::Raw           _min_handle_period { };
+
+		static bool _precedes(Alarm const &a, Alarm const &b) {
+			return a._raw.is_pending_at(b._raw.deadline, b._raw.deadline_period); }
 
 		void _alarm_unsynchronized_enqueue(Alarm *alarm);
 
@@ -284,7 +289,7 @@ class Genode::Alarm_timeout_scheduler : private Noncopyable,
 
 		bool _alarm_next_deadline(Alarm::Time *deadline);
 
-		bool _alarm_head_timeout(const Alarm * alarm) { return _active_head == alarm; }
+		bool _alarm_head_timeout(const Alarm * alarm) { return _active_queue.first() == alarm; }
 
 		Alarm_timeout_scheduler(Alarm_timeout_scheduler const &);
 		Alarm_timeout_scheduler &operator = (Alarm_timeout_scheduler const &);
@@ -27,7 +27,7 @@ struct Genode::Trace::Session_client : Genode::Rpc_client<Genode::Trace::Session
 
 		/**
 		 * Shared-memory buffer used for carrying the payload of the
-		 * 'subjects()' RPC function.
+		 * 'subjects()' and 'subject_infos()' RPC functions.
 		 */
 		class Argument_buffer
 		{
@@ -86,6 +86,41 @@ struct Genode::Trace::Session_client : Genode::Rpc_client<Genode::Trace::Session
 			return num_subjects;
 		}
 
+		/**
+		 * Call 'fn' for each subject with its ID and information
+		 *
+		 * In contrast to calling 'subject_info' for each subject, the
+		 * information of all subjects is obtained by a single RPC. The
+		 * number of subjects is limited by the size of the argument buffer
+		 * (see 'Session::max_subject_infos').
+		 *
+		 * The functor is called with a 'Subject_id' and a 'Subject_info
+		 * const &' argument. The information refers to the argument buffer
+		 * and is valid only until the next call of 'subjects' or
+		 * 'for_each_subject_info'.
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 *
+		 * \return  number of subjects
+		 */
+		template <typename FN>
+		size_t for_each_subject_info(FN const &fn)
+		{
+			size_t const max_subjects = max_subject_infos(_argument_buffer.size);
+			size_t const num_subjects = min(call<Rpc_subject_infos>(), max_subjects);
+
+			Subject_info const * const infos =
+				(Subject_info const *)_argument_buffer.base;
+			Subject_id const * const ids =
+				(Subject_id const *)(infos + max_subjects);
+
+			for (size_t i = 0; i < num_subjects; i++)
+				fn(ids[i], infos[i]);
+
+			return num_subjects;
+		}
+
 		Policy_id alloc_policy(size_t size) override {
 			return call<Rpc_alloc_policy>(size); }
 
@@ -31,6 +31,20 @@ struct Genode::Trace::Session : Genode::Session
 
 	enum { CAP_QUOTA = 4 };
 
+	/**
+	 * Maximum number of subjects reported by one 'subject_infos' call
+	 *
+	 * The 'subject_infos' RPC function fills the argument buffer with an
+	 * array of 'Subject_info' records followed by an array of the
+	 * corresponding subject IDs.
+	 *
+	 * \noapi
+	 */
+	static constexpr size_t max_subject_infos(size_t arg_buffer_size)
+	{
+		return arg_buffer_size / (sizeof(Subject_info) + sizeof(Subject_id));
+	}
+
 	/**
 	 * Allocate policy-module backing store
 	 *
@@ -142,6 +156,8 @@ struct Genode::Trace::Session : Genode::Session
 	                 Subject_id);
 	GENODE_RPC_THROW(Rpc_subjects, size_t, subjects,
 	                 GENODE_TYPE_LIST(Out_of_ram, Out_of_caps));
+	GENODE_RPC_THROW(Rpc_subject_infos, size_t, subject_infos,
+	                 GENODE_TYPE_LIST(Out_of_ram, Out_of_caps));
 	GENODE_RPC_THROW(Rpc_subject_info, Subject_info, subject_info,
 	                 GENODE_TYPE_LIST(Nonexistent_subject), Subject_id);
 	GENODE_RPC_THROW(Rpc_buffer, Dataspace_capability, buffer,
@@ -152,8 +168,8 @@ struct Genode::Trace::Session : Genode::Session
 
 	GENODE_RPC_INTERFACE(Rpc_dataspace, Rpc_alloc_policy, Rpc_policy,
 	                     Rpc_unload_policy, Rpc_trace, Rpc_rule, Rpc_pause,
-	                     Rpc_resume, Rpc_subjects, Rpc_subject_info, Rpc_buffer,
-	                     Rpc_free);
+	                     Rpc_resume, Rpc_subjects, Rpc_subject_infos,
+	                     Rpc_subject_info, Rpc_buffer, Rpc_free);
 };
 
 #endif /* _INCLUDE__TRACE_SESSION__TRACE_SESSION_H_ */
@@ -0,0 +1,192 @@
+/*
+ * \brief  Intrusive pairing heap
+ * \author Genode Labs
+ * \date   2026-10-15
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__UTIL__PAIRING_HEAP_H_
+#define _INCLUDE__UTIL__PAIRING_HEAP_H_
+
+namespace Genode { template <typename> class Pairing_heap; }
+
+
+/**
+ * Pairing heap
+ *
+ * \param T  heap element type, must inherit 'Pairing_heap<T>::Element'
+ *
+ * If 'T' inherits the element type non-publicly, it must declare
+ * 'Pairing_heap<T>' as friend.
+ *
+ * The heap keeps its elements in the order defined by the functor
+ * 'precedes' of type 'bool (T const &a, T const &b)' that is passed to
+ * each modifying operation. It must return true if 'a' is to be placed
+ * before or at the same position as 'b'.
+ *
+ * Inserting an element takes constant time. Removing the first element or
+ * any other element takes amortized logarithmic time.
+ */
+template <typename T>
+class Genode::Pairing_heap
+{
+	public:
+
+		class Element
+		{
+			private:
+
+				friend class Pairing_heap;
+
+				T *_child   = nullptr;  /* first child                */
+				T *_sibling = nullptr;  /* next sibling               */
+				T *_prev    = nullptr;  /* parent or previous sibling */
+
+				/*
+				 * Noncopyable
+				 */
+				Element(Element const &);
+				Element &operator = (Element const &);
+
+			protected:
+
+				~Element() { }
+
+			public:
+
+				Element() { }
+		};
+
+	private:
+
+		T *_first = nullptr;
+
+		static Element &_e(T &t) { return static_cast<Element &>(t); }
+
+		/**
+		 * Link two heap trees, return root of resulting tree
+		 */
+		template <typename PRECEDES>
+		static T *_meld(T *a, T *b, PRECEDES const &precedes)
+		{
+			if (!a) return b;
+			if (!b) return a;
+
+			if (!precedes(*a, *b)) {
+				T *tmp = a; a = b; b = tmp; }
+
+			/* make 'b' the first child of 'a' */
+			_e(*b)._prev    = a;
+			_e(*b)._sibling = _e(*a)._child;
+			if (_e(*a)._child)
+				_e(*_e(*a)._child)._prev = b;
+			_e(*a)._child = b;
+			return a;
+		}
+
+		/**
+		 * Combine list of sibling trees into one tree
+		 *
+		 * The siblings are linked pairwise from left to right first. The
+		 * resulting trees are then linked from right to left.
+		 */
+		template <typename PRECEDES>
+		static T *_merge_pairs(T *first, PRECEDES const &precedes)
+		{
+			T *pairs = nullptr;
+
+			while (first) {
+				T *a = first;
+				T *b = _e(*a)._sibling;
+				first = b ? _e(*b)._sibling : nullptr;
+
+				_e(*a)._sibling = _e(*a)._prev = nullptr;
+				if (b)
+					_e(*b)._sibling = _e(*b)._prev = nullptr;
+
+				T *tree = _meld(a, b, precedes);
+				_e(*tree)._sibling = pairs;
+				pairs = tree;
+			}
+
+			T *result = nullptr;
+			while (pairs) {
+				T *next = _e(*pairs)._sibling;
+				_e(*pairs)._sibling = nullptr;
+				result = _meld(result, pairs, precedes);
+				pairs  = next;
+			}
+			return result;
+		}
+
+	public:
+
+		/**
+		 * Return first element according to the heap order
+		 */
+		T       *first()       { return _first; }
+		T const *first() const { return _first; }
+
+		/**
+		 * Insert element into heap
+		 */
+		template <typename PRECEDES>
+		void insert(T &t, PRECEDES const &precedes)
+		{
+			_e(t)._child = _e(t)._sibling = _e(t)._prev = nullptr;
+			_first = _meld(_first, &t, precedes);
+		}
+
+		/**
+		 * Remove element from heap
+		 *
+		 * The element must be a member of the heap.
+		 */
+		template <typename PRECEDES>
+		void remove(T &t, PRECEDES const &precedes)
+		{
+			Element &e = _e(t);
+
+			if (&t == _first) {
+				_first = _merge_pairs(e._child, precedes);
+
+			} else {
+
+				/* cut subtree of element from the heap */
+				if (_e(*e._prev)._child == &t)
+					_e(*e._prev)._child = e._sibling;
+				else
+					_e(*e._prev)._sibling = e._sibling;
+
+				if (e._sibling)
+					_e(*e._sibling)._prev = e._prev;
+
+				/* re-insert the children of the element */
+				_first = _meld(_first, _merge_pairs(e._child, precedes), precedes);
+			}
+
+			e._child = e._sibling = e._prev = nullptr;
+		}
+
+		/**
+		 * Remove first element from heap
+		 *
+		 * \return  removed element or nullptr if heap is empty
+		 */
+		template <typename PRECEDES>
+		T *remove_first(PRECEDES const &precedes)
+		{
+			T * const t = _first;
+			if (t)
+				remove(*t, precedes);
+			return t;
+		}
+};
+
+#endif /* _INCLUDE__UTIL__PAIRING_HEAP_H_ */
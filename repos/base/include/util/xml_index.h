@@ -0,0 +1,765 @@
+/*
+ * \brief  Pre-indexed view of XML data
+ * \author Genode Labs
+ * \date   2026-10-15
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__UTIL__XML_INDEX_H_
+#define _INCLUDE__UTIL__XML_INDEX_H_
+
+#include <util/xml_node.h>
+#include <base/allocator.h>
+
+namespace Genode { class Xml_index; }
+
+
+/**
+ * Index of the nodes and attributes of XML data
+ *
+ * 'Xml_node' tokenizes the XML data on demand. Each node construction scans
+ * the whole sub tree for the matching end tag, the access of a sub node by
+ * index walks all preceding siblings, and each attribute access re-scans the
+ * start tag. For large XML data that is queried repeatedly, this becomes
+ * expensive.
+ *
+ * 'Xml_index' parses the XML data once and records the location of each node
+ * and attribute in tables. The 'Xml_index::Node' type provides the read
+ * accessors of 'Xml_node'. Accessing a sub node by index, the next sibling,
+ * or an attribute by index takes constant time. Looking up a sub node or an
+ * attribute by name merely compares names.
+ *
+ * The index refers to the XML data, which must remain unmodified during the
+ * lifetime of the index. Malformed start or end tags are rejected by the
+ * constructor, whereas 'Xml_node' would report the syntax error only when
+ * accessing the affected part of the data.
+ */
+class Genode::Xml_index
+{
+	public:
+
+		class Node;
+		class Attribute;
+
+		typedef Xml_node::Invalid_syntax        Invalid_syntax;
+		typedef Xml_node::Nonexistent_sub_node  Nonexistent_sub_node;
+		typedef Xml_node::Nonexistent_attribute Nonexistent_attribute;
+
+	private:
+
+		enum { INVALID = ~0U };
+
+		struct Node_entry
+		{
+			unsigned offset;        /* start of node relative to XML data  */
+			unsigned size;          /* size including start and end tag     */
+			unsigned content;       /* start of content relative to data    */
+			unsigned content_size;
+			unsigned name_len;      /* name starts right after the '<'      */
+			unsigned parent;
+			unsigned first_attr;    /* index into '_attrs'                  */
+			unsigned num_attrs;
+			unsigned first_child;   /* index into '_children'               */
+			unsigned num_children;
+			unsigned child_pos;     /* position within parent's children    */
+			bool     empty;         /* empty-element tag                    */
+		};
+
+		struct Attr_entry
+		{
+			unsigned name;          /* offset relative to XML data          */
+			unsigned name_len;
+			unsigned value;         /* offset of value without quotes       */
+			unsigned value_len;
+		};
+
+		/**
+		 * Array that grows on demand
+		 */
+		template <typename T>
+		struct Table
+		{
+			Allocator &_alloc;
+			T         *_elements = nullptr;
+			unsigned   _capacity = 0;
+			unsigned   _count    = 0;
+
+			/*
+			 * Noncopyable
+			 */
+			Table(Table const &);
+			Table &operator = (Table const &);
+
+			Table(Allocator &alloc) : _alloc(alloc) { }
+
+			~Table()
+			{
+				if (_elements)
+					_alloc.free(_elements, _capacity*sizeof(T));
+			}
+
+			void reserve(unsigned capacity)
+			{
+				if (capacity <= _capacity)
+					return;
+
+				T *elements = (T *)_alloc.alloc(capacity*sizeof(T));
+				if (_elements) {
+					memcpy(elements, _elements, _count*sizeof(T));
+					_alloc.free(_elements, _capacity*sizeof(T));
+				}
+				_elements = elements;
+				_capacity = capacity;
+			}
+
+			unsigned append(T const &t)
+			{
+				if (_count == _capacity)
+					reserve(_capacity ? 2*_capacity : 16);
+
+				_elements[_count] = t;
+				return _count++;
+			}
+
+			T       &operator [] (unsigned i)       { return _elements[i]; }
+			T const &operator [] (unsigned i) const { return _elements[i]; }
+
+			unsigned count() const { return _count; }
+		};
+
+		char const *_base;
+
+		Table<Node_entry> _nodes;
+		Table<Attr_entry> _attrs;
+		Table<unsigned>   _children;
+
+		/*
+		 * Noncopyable
+		 */
+		Xml_index(Xml_index const &);
+		Xml_index &operator = (Xml_index const &);
+
+		/**
+		 * Scanner for a single pass over the XML data
+		 */
+		struct Scanner
+		{
+			char const * const base;
+			size_t       const max_len;
+
+			size_t pos = 0;
+
+			Scanner(char const *base, size_t max_len)
+			: base(base), max_len(max_len) { }
+
+			char at(size_t i) const { return i < max_len ? base[i] : 0; }
+
+			char curr() const { return at(pos); }
+
+			bool end() const { return !curr(); }
+
+			bool matches(char const *s) const
+			{
+				for (size_t i = 0; s[i]; i++)
+					if (at(pos + i) != s[i])
+						return false;
+				return true;
+			}
+
+			void skip_whitespace() { while (is_whitespace(curr())) pos++; }
+
+			static bool ident_char(char c, unsigned i) {
+				return is_letter(c) || c == '_' || c == ':'
+				    || (i && (c == '-' || c == '.' || is_digit(c))); }
+
+			/**
+			 * Consume identifier, return its length
+			 */
+			unsigned ident()
+			{
+				unsigned len = 0;
+				for (; ident_char(curr(), len); len++, pos++);
+				return len;
+			}
+
+			/**
+			 * Consume comment
+			 *
+			 * \throw Invalid_syntax  comment is not terminated
+			 */
+			void comment()
+			{
+				for (pos += 4; !matches("-->"); pos++)
+					if (end())
+						throw Invalid_syntax();
+				pos += 3;
+			}
+
+			/**
+			 * Consume quoted string, return length of its content
+			 *
+			 * \throw Invalid_syntax  string is not terminated
+			 */
+			unsigned quoted_string()
+			{
+				size_t const start = pos;
+				for (; !(at(pos) != '\\' && at(pos + 1) == '"'); pos++)
+					if (!at(pos + 1))
+						throw Invalid_syntax();
+
+				pos += 2;
+				return (unsigned)(pos - start - 2);
+			}
+		};
+
+		/**
+		 * Parse start tag at the scanner position, which points to the '<'
+		 *
+		 * \return  true if the tag is an empty-element tag
+		 */
+		bool _parse_start_tag(Scanner &s, unsigned parent)
+		{
+			Node_entry node { };
+			node.offset     = (unsigned)s.pos;
+			node.parent     = parent;
+			node.first_attr = _attrs.count();
+
+			s.pos++;
+			node.name_len = s.ident();
+
+			for (;;) {
+				s.skip_whitespace();
+
+				Attr_entry attr { };
+				attr.name     = (unsigned)s.pos;
+				attr.name_len = s.ident();
+				if (!attr.name_len)
+					break;
+
+				if (s.curr() != '=' || s.at(s.pos + 1) != '"')
+					throw Invalid_syntax();
+
+				s.pos += 1;
+				attr.value     = (unsigned)s.pos + 1;
+				attr.value_len = s.quoted_string();
+
+				_attrs.append(attr);
+			}
+			node.num_attrs = _attrs.count() - node.first_attr;
+
+			node.empty = (s.curr() == '/');
+			if (node.empty)
+				s.pos++;
+
+			if (s.curr() != '>')
+				throw Invalid_syntax();
+
+			s.pos++;
+			node.content = (unsigned)s.pos;
+			if (node.empty)
+				node.size = (unsigned)s.pos - node.offset;
+
+			_nodes.append(node);
+			return node.empty;
+		}
+
+		/**
+		 * Parse end tag at the scanner position, which points to the '<'
+		 */
+		void _parse_end_tag(Scanner &s, Node_entry &node)
+		{
+			size_t const end_tag = s.pos;
+
+			s.pos += 2;
+			char const *name     = s.base + s.pos;
+			unsigned    name_len = s.ident();
+
+			s.skip_whitespace();
+			if (s.curr() != '>')
+				throw Invalid_syntax();
+
+			s.pos++;
+
+			if (name_len != node.name_len
+			 || strcmp(name, _base + node.offset + 1, name_len))
+				throw Invalid_syntax();
+
+			node.content_size = (unsigned)end_tag - node.content;
+			node.size         = (unsigned)s.pos - node.offset;
+		}
+
+		/**
+		 * Parse XML data, record nodes and attributes in pre order
+		 */
+		void _parse(size_t max_len)
+		{
+			Scanner s(_base, max_len);
+
+			unsigned open = INVALID;  /* innermost node lacking its end tag */
+
+			while (!s.end()) {
+
+				if (s.curr() != '<') {
+					s.pos++;
+					continue;
+				}
+
+				if (s.matches("<!--")) {
+					s.comment();
+					continue;
+				}
+
+				if (s.at(s.pos + 1) == '/' && open != INVALID) {
+					_parse_end_tag(s, _nodes[open]);
+					open = _nodes[open].parent;
+					if (open == INVALID)
+						return;
+					continue;
+				}
+
+				/* skip '<' characters that do not start a tag */
+				if (!Scanner::ident_char(s.at(s.pos + 1), 0)) {
+					s.pos++;
+					continue;
+				}
+
+				/* ignore any data following the top-level node */
+				bool const top_level = (_nodes.count() == 0);
+
+				bool const empty = _parse_start_tag(s, open);
+
+				if (top_level && empty)
+					return;
+
+				if (!empty)
+					open = _nodes.count() - 1;
+			}
+
+			/* data ended without top-level node or with unclosed nodes */
+			throw Invalid_syntax();
+		}
+
+		/**
+		 * Populate '_children' such that the children of each node are
+		 * located consecutively
+		 */
+		void _index_children()
+		{
+			unsigned const num_nodes = _nodes.count();
+
+			for (unsigned i = 1; i < num_nodes; i++)
+				_nodes[_nodes[i].parent].num_children++;
+
+			unsigned next = 0;
+			for (unsigned i = 0; i < num_nodes; i++) {
+				_nodes[i].first_child = next;
+				next += _nodes[i].num_children;
+				_nodes[i].num_children = 0;
+			}
+
+			/* the root node is no child */
+			_children.reserve(num_nodes);
+			_children._count = num_nodes - 1;
+
+			for (unsigned i = 1; i < num_nodes; i++) {
+				Node_entry &parent = _nodes[_nodes[i].parent];
+				_nodes[i].child_pos = parent.num_children++;
+				_children[parent.first_child + _nodes[i].child_pos] = i;
+			}
+		}
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param alloc    allocator used for the index tables
+		 * \param addr     XML data
+		 * \param max_len  maximum length of XML data
+		 *
+		 * \throw Invalid_syntax
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		Xml_index(Allocator &alloc, char const *addr, size_t max_len = ~0UL)
+		:
+			_base(addr), _nodes(alloc), _attrs(alloc), _children(alloc)
+		{
+			_parse(max_len);
+			_index_children();
+		}
+
+		/**
+		 * Constructor
+		 *
+		 * \param node  XML node, which must be valid during the lifetime of
+		 *              the index
+		 */
+		Xml_index(Allocator &alloc, Xml_node const &node)
+		:
+			_base(nullptr), _nodes(alloc), _attrs(alloc), _children(alloc)
+		{
+			node.with_raw_node([&] (char const *start, size_t length) {
+				_base = start;
+				_parse(length);
+			});
+			_index_children();
+		}
+
+		/**
+		 * Return top-level node
+		 */
+		inline Node node() const;
+
+		/**
+		 * Return number of indexed nodes
+		 */
+		unsigned num_nodes() const { return _nodes.count(); }
+};
+
+
+/**
+ * Attribute of an indexed XML node
+ *
+ * The accessors correspond to those of 'Xml_attribute'.
+ */
+class Genode::Xml_index::Attribute
+{
+	private:
+
+		friend class Xml_index::Node;
+
+		char const *_name;
+		size_t      _name_len;
+		char const *_value;
+		size_t      _value_len;
+
+		Attribute(char const *base, Attr_entry const &attr)
+		:
+			_name(base + attr.name),   _name_len(attr.name_len),
+			_value(base + attr.value), _value_len(attr.value_len)
+		{ }
+
+	public:
+
+		typedef Xml_attribute::Name Name;
+
+		Name name() const { return Name(Cstring(_name, _name_len)); }
+
+		/**
+		 * Return true if attribute has specified type
+		 */
+		bool has_type(char const *type) const {
+			return strlen(type) == _name_len
+			    && strcmp(type, _name, _name_len) == 0; }
+
+		/**
+		 * Return size of the value in bytes
+		 */
+		size_t value_size() const { return _value_len; }
+
+		/**
+		 * Return true if attribute has the specified value
+		 */
+		bool has_value(char const *value) const {
+			return strlen(value) == _value_len
+			    && !strcmp(value, _value, _value_len); }
+
+		/**
+		 * Call functor 'fn' with the data of the attribute value as argument
+		 *
+		 * The functor is called with the start pointer ('char const *') and
+		 * size (size_t) of the attribute value as arguments.
+		 */
+		template <typename FN>
+		void with_raw_value(FN const &fn) const { fn(_value, _value_len); }
+
+		/**
+		 * Return attribute value as typed value
+		 *
+		 * \return  true on success, or false if value conversion failed
+		 */
+		template <typename T>
+		bool value(T &out) const {
+			return ascii_to(_value, out) == _value_len; }
+
+		/**
+		 * Return attribute value as 'Genode::String'
+		 */
+		template <size_t N>
+		void value(String<N> &out) const {
+			out = String<N>(Cstring(_value, _value_len)); }
+};
+
+
+/**
+ * Indexed XML node
+ *
+ * The accessors correspond to those of 'Xml_node'. A 'Node' is a light-weight
+ * reference into the 'Xml_index' and must not outlive the index.
+ */
+class Genode::Xml_index::Node
+{
+	private:
+
+		friend class Xml_index;
+
+		Xml_index const *_index;
+		unsigned         _id;
+
+		Node(Xml_index const &index, unsigned id) : _index(&index), _id(id) { }
+
+		Node_entry const &_entry() const { return _index->_nodes[_id]; }
+
+		char const *_addr() const { return _index->_base + _entry().offset; }
+
+		Node _child(unsigned i) const {
+			return Node(*_index, _index->_children[_entry().first_child + i]); }
+
+	public:
+
+		typedef Xml_node::Type Type;
+
+		Type type() const { return Type(Cstring(_addr() + 1, _entry().name_len)); }
+
+		/**
+		 * Return true if tag is of specified type
+		 */
+		bool has_type(char const *type) const {
+			return strlen(type) == _entry().name_len
+			    && !strcmp(type, _addr() + 1, _entry().name_len); }
+
+		/**
+		 * Return size of node including start and end tags in bytes
+		 */
+		size_t size() const { return _entry().size; }
+
+		/**
+		 * Return size of node content
+		 */
+		size_t content_size() const { return _entry().content_size; }
+
+		/**
+		 * Call functor 'fn' with the node data '(char const *, size_t)'
+		 */
+		template <typename FN>
+		void with_raw_node(FN const &fn) const { fn(_addr(), size()); }
+
+		/**
+		 * Call functor 'fn' with content '(char const *, size_t) as argument'
+		 *
+		 * If the node has no content, the functor 'fn' is not called.
+		 */
+		template <typename FN>
+		void with_raw_content(FN const &fn) const
+		{
+			if (!_entry().empty)
+				fn(_index->_base + _entry().content, content_size());
+		}
+
+		/**
+		 * Return node as 'Xml_node'
+		 *
+		 * Note that the construction of the 'Xml_node' scans the whole node.
+		 */
+		Xml_node xml() const { return Xml_node(_addr(), size()); }
+
+		/**
+		 * Return the number of the XML node's immediate sub nodes
+		 */
+		size_t num_sub_nodes() const { return _entry().num_children; }
+
+		/**
+		 * Return XML node following the current one
+		 *
+		 * \throw Nonexistent_sub_node  subsequent node does not exist
+		 */
+		Node next() const
+		{
+			Node_entry const &entry = _entry();
+
+			if (entry.parent == INVALID)
+				throw Nonexistent_sub_node();
+
+			Node const parent(*_index, entry.parent);
+			if (entry.child_pos + 1 >= parent.num_sub_nodes())
+				throw Nonexistent_sub_node();
+
+			return parent._child(entry.child_pos + 1);
+		}
+
+		/**
+		 * Return next XML node of specified type
+		 *
+		 * \param type  type of XML node, or nullptr for matching any type
+		 *
+		 * \throw Nonexistent_sub_node  subsequent node does not exist
+		 */
+		Node next(char const *type) const
+		{
+			Node node = next();
+			for (; type && !node.has_type(type); node = node.next());
+			return node;
+		}
+
+		/**
+		 * Return true if node is the last of a node sequence
+		 */
+		bool last(char const *type = 0) const
+		{
+			try { next(type); return false; }
+			catch (Nonexistent_sub_node) { return true; }
+		}
+
+		/**
+		 * Return sub node with specified index
+		 *
+		 * \throw Nonexistent_sub_node  no such sub node exists
+		 */
+		Node sub_node(unsigned idx = 0U) const
+		{
+			if (idx >= num_sub_nodes())
+				throw Nonexistent_sub_node();
+
+			return _child(idx);
+		}
+
+		/**
+		 * Return first sub node that matches the specified type
+		 *
+		 * \throw Nonexistent_sub_node  no such sub node exists
+		 */
+		Node sub_node(char const *type) const
+		{
+			for (unsigned i = 0; i < num_sub_nodes(); i++)
+				if (_child(i).has_type(type))
+					return _child(i);
+
+			throw Nonexistent_sub_node();
+		}
+
+		/**
+		 * Return true if sub node of specified type exists
+		 */
+		bool has_sub_node(char const *type) const
+		{
+			for (unsigned i = 0; i < num_sub_nodes(); i++)
+				if (_child(i).has_type(type))
+					return true;
+
+			return false;
+		}
+
+		/**
+		 * Apply functor 'fn' to first sub node of specified type
+		 *
+		 * If no matching sub node exists, the functor is not called.
+		 */
+		template <typename FN>
+		void with_sub_node(char const *type, FN const &fn) const
+		{
+			for (unsigned i = 0; i < num_sub_nodes(); i++)
+				if (_child(i).has_type(type)) {
+					fn(_child(i));
+					return;
+				}
+		}
+
+		/**
+		 * Execute functor 'fn' for each sub node of specified type
+		 */
+		template <typename FN>
+		void for_each_sub_node(char const *type, FN const &fn) const
+		{
+			for (unsigned i = 0; i < num_sub_nodes(); i++) {
+				Node const node = _child(i);
+				if (!type || node.has_type(type))
+					fn(node);
+			}
+		}
+
+		/**
+		 * Execute functor 'fn' for each sub node
+		 */
+		template <typename FN>
+		void for_each_sub_node(FN const &fn) const
+		{
+			for_each_sub_node(nullptr, fn);
+		}
+
+		/**
+		 * Return Nth attribute of XML node
+		 *
+		 * \throw Nonexistent_attribute  no such attribute exists
+		 */
+		Attribute attribute(unsigned idx) const
+		{
+			if (idx >= _entry().num_attrs)
+				throw Nonexistent_attribute();
+
+			return Attribute(_index->_base,
+			                 _index->_attrs[_entry().first_attr + idx]);
+		}
+
+		/**
+		 * Return attribute of specified type
+		 *
+		 * \throw Nonexistent_attribute  no such attribute exists
+		 */
+		Attribute attribute(char const *type) const
+		{
+			for (unsigned i = 0; i < _entry().num_attrs; i++) {
+				Attribute const a = attribute(i);
+				if (a.has_type(type))
+					return a;
+			}
+			throw Nonexistent_attribute();
+		}
+
+		/**
+		 * Read attribute value from XML node
+		 *
+		 * \param type           attribute name
+		 * \param default_value  value returned if no attribute with the
+		 *                       name 'type' is present.
+		 * \return               attribute value or specified default value
+		 */
+		template <typename T>
+		T attribute_value(char const *type, T const default_value) const
+		{
+			for (unsigned i = 0; i < _entry().num_attrs; i++) {
+				Attribute const a = attribute(i);
+				if (a.has_type(type)) {
+					T result = default_value;
+					a.value(result);
+					return result;
+				}
+			}
+			return default_value;
+		}
+
+		/**
+		 * Return true if attribute of specified type exists
+		 */
+		bool has_attribute(char const *type) const
+		{
+			for (unsigned i = 0; i < _entry().num_attrs; i++)
+				if (attribute(i).has_type(type))
+					return true;
+
+			return false;
+		}
+
+		void print(Output &output) const { output.out_string(_addr(), size()); }
+};
+
+
+Genode::Xml_index::Node Genode::Xml_index::node() const { return Node(*this, 0); }
+
+#endif /* _INCLUDE__UTIL__XML_INDEX_H_ */
@@ -436,6 +436,21 @@ class Genode::Trace::Subject_registry
 			return i;
 		}
 
+		/**
+		 * Retrieve existing subject IDs along with the subject information
+		 */
+		size_t subjects(Subject_info *dst_infos, Subject_id *dst_ids, size_t dst_len)
+		{
+			Lock guard(_lock);
+
+			unsigned i = 0;
+			for (Subject *s = _entries.first(); s && i < dst_len; s = s->next(), i++) {
+				dst_ids[i]   = s->id();
+				dst_infos[i] = s->info();
+			}
+			return i;
+		}
+
 		/**
 		 * Remove subject and release resources
 		 *
@@ -36,6 +36,19 @@ size_t Session_component::subjects()
 }
 
 
+size_t Session_component::subject_infos()
+{
+	_subjects.import_new_sources(_sources);
+
+	size_t const max_subjects = max_subject_infos(_argument_buffer.size());
+
+	Subject_info * const infos = _argument_buffer.local_addr<Subject_info>();
+	Subject_id   * const ids   = (Subject_id *)(infos + max_subjects);
+
+	return _subjects.subjects(infos, ids, max_subjects);
+}
+
+
 Policy_id Session_component::alloc_policy(size_t size)
 {
 	if (size > _argument_buffer.size())
@@ -22,6 +22,7 @@ namespace Genode {
 	class Ram_allocator;
 	class Env;
 	class Local_session_id_space;
+	class Thread;
 
 	extern Region_map    *env_stack_area_region_map;
 	extern Ram_allocator *env_stack_area_ram_allocator;
@@ -45,6 +46,8 @@ namespace Genode {
 
 	void destroy_signal_thread();
 
+	void release_heap_slots(Thread &);
+
 	void cxx_demangle(char const*, char*, size_t);
 	void cxx_current_exception(char *out, size_t size);
 
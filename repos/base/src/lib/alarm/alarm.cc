@@ -26,59 +26,16 @@ void Alarm_scheduler::_unsynchronized_enqueue(Alarm *alarm)
 
 	alarm->_active++;
 
-	/* if alarmlist is empty add first element */
-	if (!_head) {
-		alarm->_next = 0;
-		_head = alarm;
-		return;
-	}
-
-	/* if deadline is smaller than any other deadline, put it on the head */
-	if (alarm->_raw.is_pending_at(_head->_raw.deadline, _head->_raw.deadline_period)) {
-		alarm->_next = _head;
-		_head = alarm;
-		return;
-	}
-
-	/* find list element with a higher deadline */
-	Alarm *curr = _head;
-	while (curr->_next &&
-	       curr->_next->_raw.is_pending_at(alarm->_raw.deadline, alarm->_raw.deadline_period))
-	{
-		curr = curr->_next;
-	}
-
-	/* if end of list is reached, append new element */
-	if (curr->_next == 0) {
-		curr->_next = alarm;
-		return;
-	}
-
-	/* insert element in middle of list */
-	alarm->_next = curr->_next;
-	curr->_next  = alarm;
+	_queue.insert(*alarm, _precedes);
 }
 
 
 void Alarm_scheduler::_unsynchronized_dequeue(Alarm *alarm)
 {
-	if (!_head) return;
-
-	if (_head == alarm) {
-		_head = alarm->_next;
-		alarm->_reset();
-		return;
-	}
-
-	/* find predecessor in alarm queue */
-	Alarm *curr;
-	for (curr = _head; curr && (curr->_next != alarm); curr = curr->_next);
-
 	/* alarm is not enqueued */
-	if (!curr) return;
+	if (!alarm->_active) return;
 
-	/* remove alarm from alarm queue */
-	curr->_next = alarm->_next;
+	_queue.remove(*alarm, _precedes);
 	alarm->_reset();
 }
 
@@ -96,12 +53,12 @@ Alarm *Alarm_scheduler::_get_pending_alarm()
 {
 	Lock::Guard lock_guard(_lock);
 
-	if (!_head || !_head->_raw.is_pending_at(_now, _now_period)) {
+	Alarm *head = _queue.first();
+	if (!head || !head->_raw.is_pending_at(_now, _now_period)) {
 		return nullptr; }
 
-	/* remove alarm from head of the list */
-	Alarm *pending_alarm = _head;
-	_head = _head->_next;
+	/* remove alarm from head of the queue */
+	Alarm *pending_alarm = _queue.remove_first(_precedes);
 
 	/*
 	 * Acquire dispatch lock to defer destruction until the call of 'on_alarm'
@@ -109,8 +66,6 @@ Alarm *Alarm_scheduler::_get_pending_alarm()
 	 */
 	pending_alarm->_dispatch_lock.lock();
 
-	/* reset alarm object */
-	pending_alarm->_next = nullptr;
 	pending_alarm->_active--;
 
 	return pending_alarm;
@@ -256,10 +211,11 @@ bool Alarm_scheduler::next_deadline(Alarm::Time *deadline)
 {
 	Lock::Guard alarm_list_lock_guard(_lock);
 
-	if (!_head) return false;
+	Alarm const *head = _queue.first();
+	if (!head) return false;
 
 	if (deadline)
-		*deadline = _head->_raw.deadline;
+		*deadline = head->_raw.deadline;
 
 	if (deadline && *deadline < _min_handle_period.deadline) {
 		*deadline = _min_handle_period.deadline;
@@ -272,15 +228,10 @@ Alarm_scheduler::~Alarm_scheduler()
 {
 	Lock::Guard lock_guard(_lock);
 
-	while (_head) {
-
-		Alarm *next = _head->_next;
+	while (Alarm *alarm = _queue.remove_first(_precedes)) {
 
 		/* reset alarm object */
-		_head->_reset();
-
-		/* remove from list */
-		_head = next;
+		alarm->_reset();
 	}
 }
 
@@ -16,6 +16,12 @@
 #include <base/log.h>
 #include <base/heap.h>
 #include <base/lock.h>
+#include <base/thread.h>
+
+/* base-internal includes */
+#include <base/internal/globals.h>
+#include <base/internal/stack_allocator.h>
+#include <base/internal/unmanaged_singleton.h>
 
 using namespace Genode;
 
@@ -36,6 +42,335 @@ namespace {
 }
 
 
+/**
+ * Front end of the heap for small allocations
+ *
+ * The blocks of each size class are carved out of dedicated dataspaces
+ * (chunks). Since each chunk holds blocks of only one size class, the
+ * chunk containing a block determines its size. This way, 'free' can
+ * identify such blocks without taking the heap lock.
+ *
+ * Each thread owns a slot with a list of free blocks per size class. Blocks
+ * are moved between the slots and the shared per-class free lists in
+ * batches, which is the only occasion where the heap lock is taken.
+ * Threads that find their slot occupied use the shared free lists directly.
+ *
+ * The slot of a thread is selected by the index of its stack within the
+ * stack area. It is released, and its blocks are returned to the shared
+ * free lists, when the thread is destructed.
+ */
+struct Genode::Heap::Size_class_cache : List<Heap::Size_class_cache>::Element
+{
+	enum {
+		NUM_CLASSES = 12,
+		MAX_SIZE    = 1024,
+		NUM_SLOTS   = 32,          /* number of threads with own cache */
+		BATCH       = 16,          /* blocks moved from/to shared lists */
+		MAX_CACHED  = 2*BATCH,     /* blocks kept by a thread per class */
+		MAX_CHUNKS  = 128,
+		MIN_CHUNK   = 16*1024,
+		MAX_CHUNK   = 1024*1024
+	};
+
+	static size_t class_size(unsigned cls)
+	{
+		static size_t const size[NUM_CLASSES] = {
+			16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, MAX_SIZE };
+
+		return size[cls];
+	}
+
+	struct Free_block { Free_block *next; };
+
+	struct Block_list
+	{
+		Free_block *head  = nullptr;
+		unsigned    count = 0;
+
+		void push(void *addr)
+		{
+			Free_block *b = (Free_block *)addr;
+			b->next = head;
+			head    = b;
+			count++;
+		}
+
+		void *pop()
+		{
+			Free_block *b = head;
+			head = b->next;
+			count--;
+			return b;
+		}
+	};
+
+	struct Slot
+	{
+		Thread     *owner  { nullptr };
+		Block_list  list[NUM_CLASSES] { };
+		size_t      cached { 0 };   /* bytes in 'list', written by owner */
+
+		void cached_bytes(size_t bytes) {
+			__atomic_store_n(&cached, bytes, __ATOMIC_RELAXED); }
+	};
+
+	struct Chunk
+	{
+		addr_t   base;
+		size_t   size;
+		unsigned cls;
+	};
+
+	/* size class for each multiple of 16 bytes up to 'MAX_SIZE' */
+	unsigned char _class_of[MAX_SIZE/16 + 1];
+
+	/* chunks are only appended, '_num_chunks' is read without lock */
+	Chunk    _chunks[MAX_CHUNKS] { };
+	unsigned _num_chunks = 0;
+
+	/* state of each size class, protected by the heap lock */
+	Block_list _free[NUM_CLASSES] { };
+	addr_t     _bump[NUM_CLASSES] { };
+	addr_t     _bump_end[NUM_CLASSES] { };
+	size_t     _chunk_size[NUM_CLASSES] { };
+
+	Slot _slots[NUM_SLOTS] { };
+
+	Heap &_heap;
+
+	/**
+	 * Caches of all heaps, needed to release the slots of a thread
+	 *
+	 * The registry lock is always taken before the lock of a heap.
+	 */
+	struct Registry
+	{
+		Lock                   lock { };
+		List<Size_class_cache> list { };
+	};
+
+	static Registry &registry() { return *unmanaged_singleton<Registry>(); }
+
+	Size_class_cache(Heap &heap) : _heap(heap)
+	{
+		unsigned cls = 0;
+		for (unsigned i = 0; i <= MAX_SIZE/16; i++) {
+			while (class_size(cls) < i*16)
+				cls++;
+			_class_of[i] = (unsigned char)cls;
+		}
+
+		for (unsigned i = 0; i < NUM_CLASSES; i++)
+			_chunk_size[i] = MIN_CHUNK;
+	}
+
+	/**
+	 * Return size class of chunk containing 'addr' or -1
+	 */
+	int _chunk_class(void *addr) const
+	{
+		unsigned const n = __atomic_load_n(&_num_chunks, __ATOMIC_ACQUIRE);
+
+		/* the most recent chunks are the largest, look at them first */
+		for (unsigned i = n; i > 0; i--) {
+			Chunk const &c = _chunks[i - 1];
+			if ((addr_t)addr - c.base < c.size)
+				return c.cls;
+		}
+		return -1;
+	}
+
+	/**
+	 * Return slot of calling thread or nullptr
+	 *
+	 * A slot is claimed by a thread on its first use and released by
+	 * 'release' once the thread is destructed.
+	 */
+	Slot *_my_slot()
+	{
+		Thread * const me = Thread::myself();
+		if (!me)
+			return nullptr;
+
+		int   local = 0;
+		Slot &slot  = _slots[Stack_allocator::base_to_idx(
+		                     Stack_allocator::addr_to_base(&local)) % NUM_SLOTS];
+
+		Thread *owner = __atomic_load_n(&slot.owner, __ATOMIC_RELAXED);
+		if (owner == me)
+			return &slot;
+
+		if (!owner && __atomic_compare_exchange_n(&slot.owner, &owner, me, false,
+		                                          __ATOMIC_ACQ_REL,
+		                                          __ATOMIC_RELAXED))
+			return &slot;
+
+		return nullptr;
+	}
+
+	/**
+	 * Return number of bytes cached in the slots, not yet handed out
+	 */
+	size_t cached() const
+	{
+		size_t sum = 0;
+		for (Slot const &slot : _slots)
+			sum += __atomic_load_n(&slot.cached, __ATOMIC_RELAXED);
+		return sum;
+	}
+
+	/**
+	 * Release slots of 'thread' and return its cached blocks
+	 */
+	void release(Thread &thread)
+	{
+		Lock::Guard lock_guard(_heap._lock);
+
+		for (Slot &slot : _slots) {
+			if (__atomic_load_n(&slot.owner, __ATOMIC_ACQUIRE) != &thread)
+				continue;
+
+			for (unsigned cls = 0; cls < NUM_CLASSES; cls++)
+				_flush(_heap, cls, slot.list[cls], slot.list[cls].count);
+
+			slot.cached_bytes(0);
+			__atomic_store_n(&slot.owner, (Thread *)nullptr, __ATOMIC_RELEASE);
+		}
+	}
+
+	/**
+	 * Add chunk for size class 'cls', called with heap lock held
+	 */
+	bool _grow(Heap &heap, unsigned cls)
+	{
+		if (_num_chunks == MAX_CHUNKS)
+			return false;
+
+		Heap::Dataspace *ds = heap._allocate_dataspace(_chunk_size[cls], true);
+		if (!ds)
+			return false;
+
+		_chunks[_num_chunks] = Chunk { (addr_t)ds->local_addr, ds->size, cls };
+		__atomic_store_n(&_num_chunks, _num_chunks + 1, __ATOMIC_RELEASE);
+
+		_bump[cls]       = (addr_t)ds->local_addr;
+		_bump_end[cls]   = (addr_t)ds->local_addr + ds->size;
+		_chunk_size[cls] = min(2*_chunk_size[cls], (size_t)MAX_CHUNK);
+		return true;
+	}
+
+	/**
+	 * Move up to 'n' blocks of class 'cls' to 'list', called with heap lock held
+	 */
+	void _refill(Heap &heap, unsigned cls, Block_list &list, unsigned n)
+	{
+		size_t const size = class_size(cls);
+
+		while (list.count < n) {
+
+			if (size + heap._quota_used > heap._quota_limit)
+				return;
+
+			if (_free[cls].count) {
+				list.push(_free[cls].pop());
+
+			} else {
+
+				if (_bump_end[cls] - _bump[cls] < size && !_grow(heap, cls))
+					return;
+
+				list.push((void *)_bump[cls]);
+				_bump[cls] += size;
+			}
+			heap._quota_used += size;
+		}
+	}
+
+	/**
+	 * Move 'n' blocks of class 'cls' from 'list', called with heap lock held
+	 */
+	void _flush(Heap &heap, unsigned cls, Block_list &list, unsigned n)
+	{
+		for (; n && list.count; n--) {
+			_free[cls].push(list.pop());
+			heap._quota_used -= class_size(cls);
+		}
+	}
+
+	/**
+	 * Allocate block
+	 *
+	 * \return false if 'size' is not covered by the size classes or
+	 *         no memory is available
+	 */
+	bool alloc(Heap &heap, size_t size, void **out_addr)
+	{
+		if (size > MAX_SIZE)
+			return false;
+
+		unsigned const cls = _class_of[(size + 15)/16];
+
+		Slot * const slot = _my_slot();
+		if (slot) {
+			Block_list &list = slot->list[cls];
+			if (!list.count) {
+				Lock::Guard lock_guard(heap._lock);
+				_refill(heap, cls, list, BATCH);
+				slot->cached_bytes(slot->cached + list.count*class_size(cls));
+			}
+			if (!list.count)
+				return false;
+
+			*out_addr = list.pop();
+			slot->cached_bytes(slot->cached - class_size(cls));
+			return true;
+		}
+
+		Lock::Guard lock_guard(heap._lock);
+
+		Block_list list { };
+		_refill(heap, cls, list, 1);
+		if (!list.count)
+			return false;
+
+		*out_addr = list.pop();
+		return true;
+	}
+
+	/**
+	 * Free block
+	 *
+	 * \return false if the block was not allocated from the size classes
+	 */
+	bool free(Heap &heap, void *addr)
+	{
+		int const cls = _chunk_class(addr);
+		if (cls < 0)
+			return false;
+
+		Slot * const slot = _my_slot();
+		if (slot) {
+			Block_list &list = slot->list[cls];
+			list.push(addr);
+			size_t cached = slot->cached + class_size(cls);
+			if (list.count > MAX_CACHED) {
+				Lock::Guard lock_guard(heap._lock);
+				_flush(heap, cls, list, BATCH);
+				cached -= BATCH*class_size(cls);
+			}
+			slot->cached_bytes(cached);
+			return true;
+		}
+
+		Lock::Guard lock_guard(heap._lock);
+
+		_free[cls].push(addr);
+		heap._quota_used -= class_size(cls);
+		return true;
+	}
+};
+
+
 void Heap::Dataspace_pool::remove_and_free(Dataspace &ds)
 {
 	/*
@@ -218,11 +553,58 @@ bool Heap::_unsynchronized_alloc(size_t size, void **out_addr)
 }
 
 
+void Genode::release_heap_slots(Thread &thread)
+{
+	Heap::Size_class_cache::Registry &registry = Heap::Size_class_cache::registry();
+
+	Lock::Guard lock_guard(registry.lock);
+
+	for (Heap::Size_class_cache *cache = registry.list.first(); cache; cache = cache->next())
+		cache->release(thread);
+}
+
+
+bool Heap::enable_size_class_caches()
+{
+	Size_class_cache::Registry &registry = Size_class_cache::registry();
+
+	Lock::Guard registry_guard(registry.lock);
+	Lock::Guard lock_guard(_lock);
+
+	if (_cache)
+		return true;
+
+	void *addr = nullptr;
+	if (!_unsynchronized_alloc(sizeof(Size_class_cache), &addr))
+		return false;
+
+	Size_class_cache &cache = *construct_at<Size_class_cache>(addr, *this);
+	registry.list.insert(&cache);
+
+	__atomic_store_n(&_cache, &cache, __ATOMIC_RELEASE);
+	return true;
+}
+
+
+size_t Heap::consumed() const
+{
+	Size_class_cache const * const cache = __atomic_load_n(&_cache, __ATOMIC_ACQUIRE);
+
+	size_t const cached = cache ? cache->cached() : 0;
+
+	return _quota_used > cached ? _quota_used - cached : 0;
+}
+
+
 bool Heap::alloc(size_t size, void **out_addr)
 {
 	if (size == 0)
 		error("attempt to allocated zero-size block from heap");
 
+	Size_class_cache * const cache = __atomic_load_n(&_cache, __ATOMIC_ACQUIRE);
+	if (cache && cache->alloc(*this, size, out_addr))
+		return true;
+
 	/* serialize access of heap functions */
 	Lock::Guard lock_guard(_lock);
 
@@ -236,6 +618,10 @@ bool Heap::alloc(size_t size, void **out_addr)
 
 void Heap::free(void *addr, size_t)
 {
+	Size_class_cache * const cache = __atomic_load_n(&_cache, __ATOMIC_ACQUIRE);
+	if (cache && cache->free(*this, addr))
+		return;
+
 	/* serialize access of heap functions */
 	Lock::Guard lock_guard(_lock);
 
@@ -291,6 +677,17 @@ Heap::Heap(Ram_allocator *ram_alloc,
 
 Heap::~Heap()
 {
+	if (_cache) {
+		{
+			Size_class_cache::Registry &registry = Size_class_cache::registry();
+
+			Lock::Guard lock_guard(registry.lock);
+			registry.list.remove(_cache);
+		}
+		_cache->~Size_class_cache();
+		_alloc->free(_cache, sizeof(Size_class_cache));
+	}
+
 	/*
 	 * Revert allocations of heap-internal 'Dataspace' objects. Otherwise, the
 	 * subsequent destruction of the 'Allocator_avl' would detect those blocks
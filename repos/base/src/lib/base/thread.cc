@@ -248,6 +248,8 @@ Thread::~Thread()
 		sleep_forever();
 	}
 
+	release_heap_slots(*this);
+
 	_deinit_platform_thread();
 	_free_stack(_stack);
 
@@ -29,12 +29,16 @@ Linker::Dependency::Dependency(Env &env, Allocator &md_alloc,
 	_md_alloc(&md_alloc)
 {
 	deps.enqueue(*this);
+	invalidate_symbol_cache();
+
 	load_needed(env, *_md_alloc, deps, keep);
 }
 
 
 Linker::Dependency::~Dependency()
 {
+	invalidate_symbol_cache();
+
 	if (!_obj.unload())
 		return;
 
@@ -20,6 +20,8 @@
 
 namespace Linker {
 	struct Hash_table;
+	struct Gnu_hash_table;
+	struct Symbol_hash;
 	struct Dynamic;
 }
 
@@ -53,6 +55,82 @@ struct Linker::Hash_table
 };
 
 
+/**
+ * GNU hash table and hash function
+ *
+ * In contrast to the ELF hash table, the GNU hash table covers only the
+ * symbols defined by the object. A bloom filter rejects most lookups of
+ * symbols that are not defined by the object without touching the hash
+ * chains. Each chain entry holds the hash value of its symbol, which makes
+ * string comparisons of mismatching symbols rare.
+ */
+struct Linker::Gnu_hash_table
+{
+	uint32_t const nbuckets;
+	uint32_t const symoffset;   /* index of first symbol covered by table */
+	uint32_t const bloom_size;  /* number of words of the bloom filter */
+	uint32_t const bloom_shift;
+
+	/* the header is followed by the bloom filter, buckets, and chains */
+
+	Elf::Addr const *bloom()   const { return (Elf::Addr const *)(this + 1); }
+	uint32_t  const *buckets() const { return (uint32_t const *)(bloom() + bloom_size); }
+	uint32_t  const *chains()  const { return buckets() + nbuckets; }
+
+	bool may_contain(uint32_t hash) const
+	{
+		enum { BITS = sizeof(Elf::Addr)*8 };
+
+		Elf::Addr const word = bloom()[(hash / BITS) % bloom_size];
+		Elf::Addr const mask = ((Elf::Addr)1 << (hash % BITS))
+		                     | ((Elf::Addr)1 << ((hash >> bloom_shift) % BITS));
+
+		return (word & mask) == mask;
+	}
+
+	/**
+	 * Return number of entries of the symbol table
+	 *
+	 * The last chain ends with the last symbol of the table.
+	 */
+	unsigned long num_symbols() const
+	{
+		uint32_t last = 0;
+		for (uint32_t i = 0; i < nbuckets; i++)
+			last = max(last, buckets()[i]);
+
+		if (last < symoffset)
+			return symoffset;
+
+		while (!(chains()[last - symoffset] & 1))
+			last++;
+
+		return last + 1;
+	}
+
+	static uint32_t hash(char const *name)
+	{
+		uint32_t h = 5381;
+		for (unsigned char const *p = (unsigned char const *)name; *p; p++)
+			h = h*33 + *p;
+		return h;
+	}
+};
+
+
+/**
+ * Hash values of a symbol name for both kinds of hash tables
+ */
+struct Linker::Symbol_hash
+{
+	unsigned long const elf;
+	uint32_t      const gnu;
+
+	Symbol_hash(char const *name)
+	: elf(Hash_table::hash(name)), gnu(Gnu_hash_table::hash(name)) { }
+};
+
+
 /**
  * .dynamic section entries
  */
@@ -94,6 +172,8 @@ class Linker::Dynamic
 		Allocator           *_md_alloc      = nullptr;
 
 		Hash_table          *_hash_table    = nullptr;
+		Gnu_hash_table      *_gnu_hash      = nullptr;
+		unsigned long        _num_symbols   = 0;
 
 		Elf::Rela           *_reloca        = nullptr;
 		unsigned long        _reloca_size   = 0;
@@ -158,6 +238,7 @@ class Linker::Dynamic
 				case DT_PLTRELSZ: _pltrel_size = d->un.val;                             break;
 				case DT_PLTGOT  : _section<typeof(_pltgot)>(&_pltgot, d);               break;
 				case DT_HASH    : _section<typeof(_hash_table)>(&_hash_table, d);       break;
+				case DT_GNU_HASH: _section<typeof(_gnu_hash)>(&_gnu_hash, d);           break;
 				case DT_RELA    : _section<typeof(_reloca)>(&_reloca, d);               break;
 				case DT_RELASZ  : _reloca_size = d->un.val;                             break;
 				case DT_SYMTAB  : _section<typeof(_symtab)>(&_symtab, d);               break;
@@ -173,6 +254,104 @@ class Linker::Dynamic
 					break;
 				}
 			}
+
+			/* ignore GNU hash table without buckets or bloom filter */
+			if (_gnu_hash && (!_gnu_hash->nbuckets || !_gnu_hash->bloom_size))
+				_gnu_hash = nullptr;
+
+			/*
+			 * The linker itself has an ELF hash table. So 'num_symbols' is
+			 * never called during its self relocation.
+			 */
+			if (_hash_table)
+				_num_symbols = _hash_table->nchains();
+			else if (_gnu_hash)
+				_num_symbols = _gnu_hash->num_symbols();
+		}
+
+		/**
+		 * Return true if 'sym' is a defined symbol with the given name
+		 */
+		bool _matches(Elf::Sym const &sym, char const *name) const
+		{
+			/* this omitts everything but 'NOTYPE', 'OBJECT', and 'FUNC' */
+			if (sym.type() > STT_FUNC)
+				return false;
+
+			if (sym.st_value == 0)
+				return false;
+
+			char const *sym_name = symbol_name(sym);
+
+			return name[0] == sym_name[0] && !strcmp(name, sym_name);
+		}
+
+		Elf::Sym const *_lookup_gnu(char const *name, uint32_t hash) const
+		{
+			Gnu_hash_table const &h = *_gnu_hash;
+
+			if (!h.may_contain(hash))
+				return nullptr;
+
+			uint32_t sym_index = h.buckets()[hash % h.nbuckets];
+			if (sym_index < h.symoffset)
+				return nullptr;
+
+			/* traverse hash chain, the lowest bit marks the end of the chain */
+			for (;; sym_index++) {
+
+				/* bad object */
+				if (sym_index >= _num_symbols)
+					return nullptr;
+
+				uint32_t const chain_hash = h.chains()[sym_index - h.symoffset];
+
+				if ((chain_hash | 1) == (hash | 1) && _matches(_symtab[sym_index], name))
+					return _symtab + sym_index;
+
+				if (chain_hash & 1)
+					return nullptr;
+			}
+		}
+
+		/**
+		 * Lookup undefined symbol, which is not part of the GNU hash table
+		 *
+		 * The GNU hash table covers only the symbols starting at
+		 * 'symoffset'. The symbols below are undefined.
+		 */
+		Elf::Sym const *_lookup_undef_gnu(char const *name) const
+		{
+			uint32_t const end = min(_gnu_hash->symoffset, (uint32_t)_num_symbols);
+
+			for (uint32_t sym_index = 1; sym_index < end; sym_index++)
+				if (_matches(_symtab[sym_index], name))
+					return _symtab + sym_index;
+
+			return nullptr;
+		}
+
+		Elf::Sym const *_lookup_elf(char const *name, unsigned long hash) const
+		{
+			Hash_table *h = _hash_table;
+
+			if (!h->buckets())
+				return nullptr;
+
+			unsigned long sym_index = h->buckets()[hash % h->nbuckets()];
+
+			/* traverse hash chain */
+			for (; sym_index != STN_UNDEF; sym_index = h->chains()[sym_index])
+			{
+				/* bad object */
+				if (sym_index > h->nchains())
+					return nullptr;
+
+				if (_matches(*symbol(sym_index), name))
+					return symbol(sym_index);
+			}
+
+			return nullptr;
 		}
 
 	public:
@@ -216,7 +395,7 @@ class Linker::Dynamic
 
 		Elf::Sym const *symbol(unsigned sym_index) const
 		{
-			if (sym_index > _hash_table->nchains())
+			if (sym_index > _num_symbols)
 				return nullptr;
 
 			return _symtab + sym_index;
@@ -237,44 +416,37 @@ class Linker::Dynamic
 		 * Use DT_HASH table address for linker, assuming that it will always be at
 		 * the beginning of the file
 		 */
-		Elf::Addr link_map_addr() const { return trunc_page((Elf::Addr)_hash_table); }
+		Elf::Addr link_map_addr() const
+		{
+			return trunc_page(_hash_table ? (Elf::Addr)_hash_table
+			                              : (Elf::Addr)_gnu_hash);
+		}
 
 		/**
 		 * Lookup symbol name in this ELF
+		 *
+		 * The GNU hash table is preferred over the ELF hash table.
+		 *
+		 * \param undef  consider undefined symbols, e.g., the PLT-canonical
+		 *               symbols of the binary, which the GNU hash table omits
 		 */
-		Elf::Sym const *lookup_symbol(char const *name, unsigned long hash) const
+		Elf::Sym const *lookup_symbol(char const *name, Symbol_hash const &hash,
+		                              bool undef = false) const
 		{
-			Hash_table *h = _hash_table;
-
-			if (!h->buckets())
-				return nullptr;
-
-			unsigned long sym_index = h->buckets()[hash % h->nbuckets()];
+			if (_gnu_hash) {
+				if (Elf::Sym const *sym = _lookup_gnu(name, hash.gnu))
+					return sym;
 
-			/* traverse hash chain */
-			for (; sym_index != STN_UNDEF; sym_index = h->chains()[sym_index])
-			{
-				/* bad object */
-				if (sym_index > h->nchains())
+				if (!undef)
 					return nullptr;
 
-				Elf::Sym const *sym      = symbol(sym_index);
-				char const     *sym_name = symbol_name(*sym);
-
-				/* this omitts everything but 'NOTYPE', 'OBJECT', and 'FUNC' */
-				if (sym->type() > STT_FUNC)
-					continue;
-
-				if (sym->st_value == 0)
-					continue;
-
-				/* check for symbol name */
-				if (name[0] != sym_name[0] || strcmp(name, sym_name))
-					continue;
-
-				return sym;
+				return _hash_table ? _lookup_elf(name, hash.elf)
+				                   : _lookup_undef_gnu(name);
 			}
 
+			if (_hash_table)
+				return _lookup_elf(name, hash.elf);
+
 			return nullptr;
 		}
 
@@ -285,7 +457,7 @@ class Linker::Dynamic
 		{
 			addr_t const reloc_base = _obj.reloc_base();
 
-			for (unsigned long i = 0; i < _hash_table->nchains(); i++)
+			for (unsigned long i = 0; i < _num_symbols; i++)
 			{
 				Elf::Sym const *sym = symbol(i);
 				if (!sym)
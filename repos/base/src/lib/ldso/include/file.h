@@ -28,9 +28,31 @@ namespace Linker {
 	struct Phdr;
 	struct File;
 	struct Elf_file;
+	struct Rw_segment_stats;
+
+	extern Rw_segment_stats rw_segment_stats;
+
+	/**
+	 * Clear the zero-filled part of read-write segments at load time
+	 *
+	 * The value corresponds to the config attribute "ld_eager_zero_fill".
+	 * It restores the former behaviour for comparing the startup costs.
+	 */
+	extern bool eager_zero_fill;
 }
 
 
+/**
+ * Accumulated sizes of all read-write segments loaded
+ */
+struct Linker::Rw_segment_stats
+{
+	size_t copied;      /* bytes copied from the ROM */
+	size_t zero_fill;   /* bytes left to the cleared RAM dataspace */
+	size_t ram;         /* bytes of RAM allocated */
+};
+
+
 /**
  * Program header
  */
@@ -265,23 +287,33 @@ struct Linker::Elf_file : File
 	}
 
 	/**
-	 * Copy read-write segment
+	 * Populate read-write segment
+	 *
+	 * Only the file-backed part of the segment is copied from the ROM. The
+	 * zero-filled remainder (e.g., '.bss') is not touched because RAM
+	 * dataspaces are handed out cleared. On kernels that back memory on
+	 * demand, those pages are thereby populated lazily on first access.
+	 * For comparison, 'eager_zero_fill' clears the remainder at load time.
 	 */
 	void load_segment_rw(Elf::Phdr const &p, int nr)
 	{
-		void  *src = env.rm().attach(rom_cap, 0, p.p_offset);
-		addr_t dst = p.p_vaddr + reloc_base;
+		addr_t const dst = p.p_vaddr + reloc_base;
 
 		ram_cap[nr] = env.ram().alloc(p.p_memsz);
 		Region_map::r()->attach_at(ram_cap[nr], dst);
 
-		memcpy((void*)dst, src, p.p_filesz);
+		if (p.p_filesz) {
+			void *src = env.rm().attach(rom_cap, 0, p.p_offset);
+			memcpy((void*)dst, src, p.p_filesz);
+			env.rm().detach(src);
+		}
 
-		/* clear if file size < memory size */
-		if (p.p_filesz < p.p_memsz)
+		if (eager_zero_fill)
 			memset((void *)(dst + p.p_filesz), 0, p.p_memsz - p.p_filesz);
 
-		env.rm().detach(src);
+		rw_segment_stats.copied    += p.p_filesz;
+		rw_segment_stats.zero_fill += p.p_memsz - p.p_filesz;
+		rw_segment_stats.ram       += round_page(p.p_memsz);
 	}
 
 	/**
@@ -82,6 +82,13 @@ namespace Linker {
 	Elf::Sym const *lookup_symbol(char const *name, Dependency const &dep, Elf::Addr *base,
 	                              bool undef = false, bool other = false);
 
+	/**
+	 * Forget cached results of symbol lookups
+	 *
+	 * Must be called whenever the set of loaded objects changes.
+	 */
+	void invalidate_symbol_cache();
+
 	/**
 	 * Load an ELF (setup segments and map program header)
 	 *
@@ -293,7 +300,11 @@ class Linker::Root_object
 			return dep;
 		}
 
-		void enqueue(Dependency &dep) { _deps.enqueue(dep); }
+		void enqueue(Dependency &dep)
+		{
+			_deps.enqueue(dep);
+			invalidate_symbol_cache();
+		}
 
 		Fifo<Dependency> &deps() { return _deps; }
 };
@@ -0,0 +1,130 @@
+/**
+ * \brief  Cache of resolved symbols
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * Many relocations of different objects refer to the same symbols, e.g.,
+ * 'memcpy' or 'operator new'. The cache remembers the result of a lookup
+ * per symbol name and dependency scope so that subsequent lookups don't
+ * need to search all objects of the scope.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__SYMBOL_CACHE_H_
+#define _INCLUDE__SYMBOL_CACHE_H_
+
+/* local includes */
+#include <dynamic.h>
+
+namespace Linker { class Symbol_cache; }
+
+
+class Linker::Symbol_cache
+{
+	public:
+
+		/**
+		 * Parameters of a lookup that determine its result
+		 */
+		struct Key
+		{
+			char       const *name;
+			Symbol_hash const &hash;
+			Dependency const *scope;  /* first dependency of the scope */
+			Dependency const *skip;   /* dependency skipped by the lookup */
+			bool              undef;
+		};
+
+		struct Stats { unsigned long lookups, hits; };
+
+	private:
+
+		enum { NUM_ENTRIES_LOG2 = 10, NUM_ENTRIES = 1 << NUM_ENTRIES_LOG2 };
+
+		/*
+		 * The name of an entry points to the string table of a loaded object.
+		 * Entries of an older generation may refer to unloaded objects and
+		 * are never accessed.
+		 */
+		struct Entry
+		{
+			unsigned          generation;
+			uint32_t          hash;
+			char       const *name;
+			Dependency const *scope;
+			Dependency const *skip;
+			bool              undef;
+			Elf::Sym   const *sym;
+			Elf::Addr         base;
+		};
+
+		Lock     _lock { };
+		unsigned _generation = 1;
+		Stats    _stats { 0, 0 };
+		Entry    _entries[NUM_ENTRIES] { };
+
+		Entry &_entry(Key const &key)
+		{
+			unsigned long const scope = (unsigned long)key.scope / sizeof(long);
+
+			return _entries[(key.hash.gnu ^ scope) % NUM_ENTRIES];
+		}
+
+	public:
+
+		/**
+		 * Lookup cached result
+		 *
+		 * \return  symbol, or nullptr if the lookup is not cached
+		 */
+		Elf::Sym const *lookup(Key const &key, Elf::Addr *base)
+		{
+			Lock::Guard guard(_lock);
+
+			_stats.lookups++;
+
+			Entry const &e = _entry(key);
+
+			if (e.generation != _generation || e.hash != key.hash.gnu
+			 || e.scope != key.scope || e.skip != key.skip || e.undef != key.undef
+			 || strcmp(e.name, key.name))
+				return nullptr;
+
+			_stats.hits++;
+
+			*base = e.base;
+			return e.sym;
+		}
+
+		/**
+		 * Remember result of lookup
+		 *
+		 * The name must point to the string table of a loaded object.
+		 */
+		void insert(Key const &key, Elf::Sym const *sym, Elf::Addr base)
+		{
+			Lock::Guard guard(_lock);
+
+			_entry(key) = Entry { _generation, key.hash.gnu, key.name, key.scope,
+			                      key.skip, key.undef, sym, base };
+		}
+
+		/**
+		 * Forget all cached lookups
+		 */
+		void invalidate()
+		{
+			Lock::Guard guard(_lock);
+			_generation++;
+		}
+
+		Stats stats() const { return _stats; }
+};
+
+#endif /* _INCLUDE__SYMBOL_CACHE_H_ */
@@ -19,6 +19,7 @@
 #include <util/string.h>
 #include <base/thread.h>
 #include <base/heap.h>
+#include <trace/timestamp.h>
 
 /* base-internal includes */
 #include <base/internal/unmanaged_singleton.h>
@@ -28,6 +29,7 @@
 #include <dynamic.h>
 #include <init.h>
 #include <region_map.h>
+#include <symbol_cache.h>
 
 using namespace Linker;
 
@@ -42,9 +44,13 @@ namespace Linker {
 };
 
 static    Binary *binary_ptr = nullptr;
+static    Symbol_cache *symbol_cache = nullptr;
 bool      Linker::verbose  = false;
+bool      Linker::eager_zero_fill = false;
 Link_map *Link_map::first;
 
+Linker::Rw_segment_stats Linker::rw_segment_stats { 0, 0, 0 };
+
 /**
  * Registers dtors
  */
@@ -173,9 +179,10 @@ class Linker::Elf_object : public Object, private Fifo<Elf_object>::Element
 			return _dyn.symbol_name(sym);
 		}
 
-		Elf::Sym const *lookup_symbol(char const *name, unsigned long hash) const
+		Elf::Sym const *lookup_symbol(char const *name, Symbol_hash const &hash,
+		                              bool undef = false) const
 		{
-			return _dyn.lookup_symbol(name, hash);
+			return _dyn.lookup_symbol(name, hash, undef);
 		}
 
 		/**
@@ -346,7 +353,11 @@ struct Linker::Binary : private Root_object, public Elf_object
 
 	bool static_construction_finished = false;
 
-	Binary(Env &env, Allocator &md_alloc, Bind bind)
+	/* durations of loading and relocation in timestamp ticks */
+	Trace::Timestamp load_duration       = 0;
+	Trace::Timestamp relocation_duration = 0;
+
+	Binary(Env &env, Allocator &md_alloc, Bind bind, Trace::Timestamp start)
 	:
 		Root_object(md_alloc),
 		Elf_object(env, md_alloc, binary_name(),
@@ -366,8 +377,13 @@ struct Linker::Binary : private Root_object, public Elf_object
 		/* load dependencies */
 		binary->load_needed(env, md_alloc, deps(), DONT_KEEP);
 
+		Trace::Timestamp const loaded = Trace::timestamp();
+		load_duration = loaded - start;
+
 		/* relocate and call constructors */
 		Init::list()->initialize(bind, STAGE_BINARY);
+
+		relocation_duration = Trace::timestamp() - loaded;
 	}
 
 	Elf::Addr lookup_symbol(char const *name)
@@ -479,8 +495,7 @@ struct Linker::Binary : private Root_object, public Elf_object
 
 Elf::Addr Linker::Object::_symbol_address(char const *name)
 {
-	unsigned long   hash = Hash_table::hash(name);
-	Elf::Sym const *sym  = dynamic().lookup_symbol(name, hash);
+	Elf::Sym const *sym = dynamic().lookup_symbol(name, Symbol_hash(name));
 
 	if (sym)
 		return reloc_base() + sym->st_value;
@@ -529,31 +544,14 @@ Object *Linker::obj_list_head()
 }
 
 
-Elf::Sym const *Linker::lookup_symbol(unsigned sym_index, Dependency const &dep,
-                                      Elf::Addr *base, bool undef, bool other)
-{
-	Elf_object const &elf    = static_cast<Elf_object const &>(dep.obj());
-	Elf::Sym   const *symbol = elf.symbol(sym_index);
-
-	if (!symbol) {
-		warning("LD: unknown symbol index ", Hex(sym_index));
-		return 0;
-	}
-
-	if (symbol->bind() == STB_LOCAL) {
-		*base = dep.obj().reloc_base();
-		return symbol;
-	}
-
-	return lookup_symbol(elf.symbol_name(*symbol), dep, base, undef, other);
-}
-
-
-Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const &dep,
-                                      Elf::Addr *base, bool undef, bool other)
+/**
+ * Find symbol by name and hash in the scope of 'dep'
+ */
+static Elf::Sym const *lookup_symbol(char const *name, Symbol_hash const &hash,
+                                     Dependency const &dep, Elf::Addr *base,
+                                     bool undef, bool other)
 {
 	Dependency const *curr        = &dep.first();
-	unsigned long     hash        = Hash_table::hash(name);
 	Elf::Sym   const *weak_symbol = 0;
 	Elf::Addr        weak_base    = 0;
 	Elf::Sym   const *symbol      = 0;
@@ -566,7 +564,7 @@ Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const &dep,
 
 		Elf_object const &elf = static_cast<Elf_object const &>(curr->obj());
 
-		if ((symbol = elf.lookup_symbol(name, hash)) && (symbol->st_value || undef)) {
+		if ((symbol = elf.lookup_symbol(name, hash, undef)) && (symbol->st_value || undef)) {
 
 			if (dep.root() && verbose_lookup)
 				log("LD: lookup ", name, " obj_src ", elf.name(),
@@ -591,7 +589,7 @@ Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const &dep,
 	/* try searching binary's dependencies */
 	if (!weak_symbol && dep.root()) {
 		if (binary_ptr && &dep != binary_ptr->first_dep()) {
-			return lookup_symbol(name, *binary_ptr->first_dep(), base, undef, other);
+			return lookup_symbol(name, hash, *binary_ptr->first_dep(), base, undef, other);
 		} else {
 			throw Not_found(name);
 		}
@@ -608,6 +606,55 @@ Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const &dep,
 }
 
 
+Elf::Sym const *Linker::lookup_symbol(unsigned sym_index, Dependency const &dep,
+                                      Elf::Addr *base, bool undef, bool other)
+{
+	Elf_object const &elf    = static_cast<Elf_object const &>(dep.obj());
+	Elf::Sym   const *symbol = elf.symbol(sym_index);
+
+	if (!symbol) {
+		warning("LD: unknown symbol index ", Hex(sym_index));
+		return 0;
+	}
+
+	if (symbol->bind() == STB_LOCAL) {
+		*base = dep.obj().reloc_base();
+		return symbol;
+	}
+
+	char        const *name = elf.symbol_name(*symbol);
+	Symbol_hash const  hash(name);
+
+	/* the cache is not available during the self relocation of the linker */
+	if (!symbol_cache)
+		return ::lookup_symbol(name, hash, dep, base, undef, other);
+
+	Symbol_cache::Key const key { name, hash, &dep.first(),
+	                              other ? &dep : nullptr, undef };
+
+	if (Elf::Sym const *cached = symbol_cache->lookup(key, base))
+		return cached;
+
+	symbol = ::lookup_symbol(name, hash, dep, base, undef, other);
+	symbol_cache->insert(key, symbol, *base);
+	return symbol;
+}
+
+
+Elf::Sym const *Linker::lookup_symbol(char const *name, Dependency const &dep,
+                                      Elf::Addr *base, bool undef, bool other)
+{
+	return ::lookup_symbol(name, Symbol_hash(name), dep, base, undef, other);
+}
+
+
+void Linker::invalidate_symbol_cache()
+{
+	if (symbol_cache)
+		symbol_cache->invalidate();
+}
+
+
 /********************
  ** Initialization **
  ********************/
@@ -638,8 +685,9 @@ class Linker::Config
 {
 	private:
 
-		Bind _bind    = BIND_LAZY;
-		bool _verbose = false;
+		Bind _bind            = BIND_LAZY;
+		bool _verbose         = false;
+		bool _eager_zero_fill = false;
 
 	public:
 
@@ -652,11 +700,16 @@ class Linker::Config
 					_bind = BIND_NOW;
 
 				_verbose = config.xml().attribute_value("ld_verbose", false);
+
+				_eager_zero_fill =
+					config.xml().attribute_value("ld_eager_zero_fill", false);
 			} catch (Rom_connection::Rom_connection_failed) { }
 		}
 
 		Bind bind()    const { return _bind; }
 		bool verbose() const { return _verbose; }
+
+		bool eager_zero_fill() const { return _eager_zero_fill; }
 };
 
 
@@ -685,11 +738,15 @@ void Component::construct(Genode::Env &env)
 {
 	/* read configuration */
 	static Config config(env);
-	verbose = config.verbose();
+	verbose         = config.verbose();
+	eager_zero_fill = config.eager_zero_fill();
+
+	symbol_cache = unmanaged_singleton<Symbol_cache>();
 
 	/* load binary and all dependencies */
 	try {
-		binary_ptr = unmanaged_singleton<Binary>(env, *heap(), config.bind());
+		binary_ptr = unmanaged_singleton<Binary>(env, *heap(), config.bind(),
+		                                         Trace::timestamp());
 	} catch(Linker::Not_found &symbol) {
 		error("LD: symbol not found: '", symbol, "'");
 		throw;
@@ -708,6 +765,20 @@ void Component::construct(Genode::Env &env)
 			    ": stack area");
 			Elf_object::obj_list()->for_each([] (Object const &obj) {
 				dump_link_map(obj); });
+
+			Symbol_cache::Stats const stats = symbol_cache->stats();
+			/*
+			 * The linker has no timer session. The durations are given in
+			 * ticks of 'Trace::timestamp', i.e., CPU cycles on x86 and ARM.
+			 */
+			log("LD: loading took ", binary_ptr->load_duration, " timestamp ticks "
+			    "(CPU cycles), relocation took ", binary_ptr->relocation_duration,
+			    " timestamp ticks (CPU cycles)");
+			log("LD: ", stats.hits, " of ", stats.lookups, " symbol lookups "
+			    "answered by cache");
+			log("LD: RW segments: ", rw_segment_stats.copied, " bytes copied, ",
+			    rw_segment_stats.zero_fill, " bytes zero-filled, ",
+			    rw_segment_stats.ram / 1024, " KiB RAM");
 		}
 	} catch (...) {  }
 
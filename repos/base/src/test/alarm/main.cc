@@ -0,0 +1,170 @@
+/*
+ * \brief  Stress test for the alarm scheduler
+ * \author Genode Labs
+ * \date   2026-10-15
+ *
+ * The test schedules a large number of alarms with random deadlines,
+ * discards and re-schedules a part of them, and advances a fake time
+ * source. It checks that the alarms trigger in deadline order and that
+ * no alarm gets lost or triggers twice.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <base/alarm.h>
+#include <timer_session/connection.h>
+
+using namespace Genode;
+
+
+struct Stats
+{
+	Alarm::Time   now            = 0;
+	Alarm::Time   last_deadline  = 0;
+	unsigned long triggered      = 0;
+	unsigned long errors         = 0;
+};
+
+
+struct Test_alarm : Alarm
+{
+	Stats       &stats;
+	Alarm::Time  deadline  = 0;
+	bool         scheduled = false;
+	bool         triggered = false;
+
+	Test_alarm(Stats &stats) : stats(stats) { }
+
+	bool on_alarm(uint64_t) override
+	{
+		if (triggered || !scheduled || deadline > stats.now
+		 || deadline < stats.last_deadline)
+			stats.errors++;
+
+		stats.last_deadline = deadline;
+		stats.triggered++;
+		triggered = true;
+		return false;
+	}
+};
+
+
+struct Main
+{
+	enum {
+		NUM_ALARMS   = 100*1000,
+		MAX_DEADLINE = 1000*1000,
+		TIME_STEP    = 1000,
+	};
+
+	Env               &_env;
+	Heap               _heap      { _env.ram(), _env.rm() };
+	Timer::Connection  _timer     { _env };
+	Stats              _stats     { };
+	Alarm_scheduler    _scheduler { };
+
+	Test_alarm **_alarms = nullptr;
+
+	uint32_t _seed = 0x2545f491;
+
+	uint32_t _random()
+	{
+		_seed ^= _seed << 13;
+		_seed ^= _seed >> 17;
+		_seed ^= _seed << 5;
+		return _seed;
+	}
+
+	Alarm::Time _random_deadline() { return 1 + _random() % (MAX_DEADLINE - 1); }
+
+	void _schedule(Test_alarm &alarm)
+	{
+		alarm.deadline  = _random_deadline();
+		alarm.scheduled = true;
+		_scheduler.schedule_absolute(&alarm, alarm.deadline);
+	}
+
+	/*
+	 * Noncopyable
+	 */
+	Main(Main const &);
+	Main &operator = (Main const &);
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- alarm scheduler test (", (unsigned)NUM_ALARMS, " alarms) ---");
+
+		_heap.alloc(sizeof(Test_alarm *)*NUM_ALARMS, (void **)&_alarms);
+		for (unsigned i = 0; i < NUM_ALARMS; i++)
+			_alarms[i] = new (_heap) Test_alarm(_stats);
+
+		uint64_t const start_ms = _timer.elapsed_ms();
+
+		for (unsigned i = 0; i < NUM_ALARMS; i++)
+			_schedule(*_alarms[i]);
+
+		uint64_t const scheduled_ms = _timer.elapsed_ms();
+
+		/* discard every 7th alarm, move every 5th alarm to a new deadline */
+		unsigned long expected = 0;
+		for (unsigned i = 0; i < NUM_ALARMS; i++) {
+			Test_alarm &alarm = *_alarms[i];
+			if (i % 7 == 0) {
+				_scheduler.discard(&alarm);
+				alarm.scheduled = false;
+				continue;
+			}
+			if (i % 5 == 0)
+				_schedule(alarm);
+			expected++;
+		}
+
+		uint64_t const modified_ms = _timer.elapsed_ms();
+
+		for (Alarm::Time now = 0; now <= MAX_DEADLINE; now += TIME_STEP) {
+			_stats.now = now;
+			_scheduler.handle(now);
+		}
+
+		uint64_t const handled_ms = _timer.elapsed_ms();
+
+		for (unsigned i = 0; i < NUM_ALARMS; i++)
+			if (_alarms[i]->scheduled != _alarms[i]->triggered)
+				_stats.errors++;
+
+		if (_scheduler.next_deadline(nullptr))
+			_stats.errors++;
+
+		log("schedule: ", scheduled_ms - start_ms, " ms, "
+		    "discard/reschedule: ", modified_ms - scheduled_ms, " ms, "
+		    "handle: ", handled_ms - modified_ms, " ms");
+
+		log("triggered ", _stats.triggered, " of ", expected, " alarms, ",
+		    _stats.errors, " errors");
+
+		for (unsigned i = 0; i < NUM_ALARMS; i++)
+			destroy(_heap, _alarms[i]);
+		_heap.free(_alarms, sizeof(Test_alarm *)*NUM_ALARMS);
+
+		if (_stats.errors || _stats.triggered != expected) {
+			error("test failed");
+			_env.parent().exit(-1);
+			return;
+		}
+
+		log("Test done.");
+		_env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
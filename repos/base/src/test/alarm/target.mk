@@ -0,0 +1,3 @@
+TARGET = test-alarm
+SRC_CC = main.cc
+LIBS  += base alarm
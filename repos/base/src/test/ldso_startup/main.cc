@@ -0,0 +1,57 @@
+/*
+ * \brief  Measure the loading of large read-write segments
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * The binary features a large initialized data segment and an even larger
+ * zero-filled one. Each instance checks the content of both and reports its
+ * RAM consumption. The loading time is reported by the dynamic linker when
+ * started with 'ld_verbose="yes"'.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/log.h>
+
+using namespace Genode;
+
+enum { DATA_SIZE = 1024*1024, BSS_SIZE = 16*1024*1024, PAGE_SIZE = 4096 };
+
+/* initialized data, placed in the file-backed part of the segment */
+static unsigned char data[DATA_SIZE] = { 1 };
+static unsigned char bss[BSS_SIZE];
+
+
+void Component::construct(Env &env)
+{
+	size_t const used_kib = env.pd().used_ram().value / 1024;
+
+	unsigned errors = 0;
+
+	for (size_t i = 0; i < DATA_SIZE; i++)
+		if (data[i] != (i ? 0 : 1))
+			errors++;
+
+	for (size_t i = 0; i < BSS_SIZE; i += PAGE_SIZE)
+		if (bss[i] || bss[i + PAGE_SIZE - 1])
+			errors++;
+
+	log("used RAM at startup: ", used_kib, " KiB of ",
+	    env.pd().ram_quota().value / 1024, " KiB");
+
+	if (errors) {
+		error("test failed with ", errors, " errors");
+		env.parent().exit(-1);
+		return;
+	}
+
+	log("Test done.");
+	env.parent().exit(0);
+}
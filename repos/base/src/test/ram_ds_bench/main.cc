@@ -0,0 +1,108 @@
+/*
+ * \brief  Measure the attach and touch throughput of large RAM dataspaces
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * For each dataspace size, the test allocates a RAM dataspace, attaches
+ * it, writes one word per page, and reads the pages again. The first pass
+ * includes the cost of populating the pages, the second pass reflects the
+ * cost of TLB misses.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/log.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Main;
+}
+
+
+struct Test::Main
+{
+	enum { PAGE_SIZE = 4096, MAX_SIZE_MB = 256 };
+
+	Env               &_env;
+	Timer::Connection  _timer { _env };
+
+	uint64_t _now_us() const { return _timer.elapsed_us(); }
+
+	/**
+	 * Return throughput in MiB/s for 'size' bytes processed in 'us'
+	 */
+	static uint64_t _mib_per_s(size_t size, uint64_t us)
+	{
+		return ((uint64_t)size*1000*1000 / max(us, (uint64_t)1)) / (1024*1024);
+	}
+
+	/**
+	 * Measure dataspace of 'size' bytes, return false if the content is wrong
+	 */
+	bool _measure(size_t size)
+	{
+		Ram_dataspace_capability ds = _env.ram().alloc(size);
+
+		uint64_t const t0 = _now_us();
+
+		char * const ptr = _env.rm().attach(ds);
+
+		uint64_t const t1 = _now_us();
+
+		for (size_t offset = 0; offset < size; offset += PAGE_SIZE)
+			*(volatile unsigned long *)(ptr + offset) = offset;
+
+		uint64_t const t2 = _now_us();
+
+		unsigned long sum = 0;
+		for (size_t offset = 0; offset < size; offset += PAGE_SIZE)
+			sum += *(volatile unsigned long *)(ptr + offset);
+
+		uint64_t const t3 = _now_us();
+
+		_env.rm().detach(ptr);
+		_env.ram().free(ds);
+
+		log(size / (1024*1024), " MiB: attach ", t1 - t0, " us, "
+		    "first touch ", _mib_per_s(size, t2 - t1), " MiB/s, "
+		    "second touch ", _mib_per_s(size, t3 - t2), " MiB/s");
+
+		size_t const pages = size / PAGE_SIZE;
+		return sum == PAGE_SIZE*(pages*(pages - 1) / 2);
+	}
+
+	/*
+	 * Noncopyable
+	 */
+	Main(Main const &);
+	Main &operator = (Main const &);
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- RAM dataspace benchmark ---");
+
+		for (size_t size_mb = 4; size_mb <= MAX_SIZE_MB; size_mb *= 4) {
+			if (!_measure(size_mb*1024*1024)) {
+				error("unexpected dataspace content");
+				_env.parent().exit(-1);
+				return;
+			}
+		}
+
+		log("Test done.");
+		_env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,150 @@
+/*
+ * \brief  Measure the round-trip time of RPCs
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * The test performs RPCs to a local entrypoint without arguments, with a
+ * payload, and with a capability argument. On base-linux, each kind of RPC
+ * takes a different path through the socket-based IPC implementation.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/log.h>
+#include <base/rpc_args.h>
+#include <base/rpc_client.h>
+#include <base/rpc_server.h>
+#include <timer_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Bench;
+	struct Bench_client;
+	struct Bench_component;
+	struct Main;
+}
+
+
+struct Test::Bench : Interface
+{
+	typedef Rpc_in_buffer<1024> Payload;
+
+	virtual void nop() = 0;
+
+	virtual size_t payload(Payload const &) = 0;
+
+	virtual bool cap(Capability<Bench>) = 0;
+
+	GENODE_RPC(Rpc_nop, void, nop);
+	GENODE_RPC(Rpc_payload, size_t, payload, Payload const &);
+	GENODE_RPC(Rpc_cap, bool, cap, Capability<Bench>);
+	GENODE_RPC_INTERFACE(Rpc_nop, Rpc_payload, Rpc_cap);
+};
+
+
+struct Test::Bench_client : Rpc_client<Bench>
+{
+	explicit Bench_client(Capability<Bench> cap) : Rpc_client<Bench>(cap) { }
+
+	void nop() override { call<Rpc_nop>(); }
+
+	size_t payload(Payload const &payload) override {
+		return call<Rpc_payload>(payload); }
+
+	bool cap(Capability<Bench> cap) override { return call<Rpc_cap>(cap); }
+};
+
+
+struct Test::Bench_component : Rpc_object<Bench, Bench_component>
+{
+	void nop() override { }
+
+	size_t payload(Payload const &payload) override { return payload.size(); }
+
+	bool cap(Capability<Bench> cap) override { return cap.valid(); }
+};
+
+
+struct Test::Main
+{
+	enum {
+		ROUNDS     = 100*1000,
+		STACK_SIZE = 4*1024*sizeof(long),
+	};
+
+	Env               &_env;
+	Timer::Connection  _timer     { _env };
+	Entrypoint         _server_ep { _env, STACK_SIZE, "server", Affinity::Location() };
+	Bench_component    _component { };
+	Capability<Bench>  _cap       { _server_ep.manage(_component) };
+	Bench_client       _client    { _cap };
+	unsigned           _errors    { 0 };
+
+	/**
+	 * Measure and log the average round-trip time of the RPC issued by 'fn'
+	 */
+	template <typename FN>
+	void _measure(char const *name, FN const &fn)
+	{
+		/* warm up */
+		for (unsigned i = 0; i < ROUNDS / 100; i++)
+			fn();
+
+		uint64_t const start_us = _timer.elapsed_us();
+
+		for (unsigned i = 0; i < ROUNDS; i++)
+			fn();
+
+		uint64_t const ns = (_timer.elapsed_us() - start_us)*1000 / ROUNDS;
+
+		log(name, ": ", ns, " ns per RPC");
+	}
+
+	/*
+	 * Noncopyable
+	 */
+	Main(Main const &);
+	Main &operator = (Main const &);
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- RPC round-trip benchmark (", (unsigned)ROUNDS, " rounds) ---");
+
+		_measure("nop    ", [&] () { _client.nop(); });
+
+		static char buf[Bench::Payload::MAX_SIZE];
+		memset(buf, 'x', sizeof(buf));
+		Bench::Payload const payload(buf, sizeof(buf));
+
+		_measure("payload", [&] () {
+			if (_client.payload(payload) != sizeof(buf))
+				_errors++; });
+
+		_measure("cap    ", [&] () {
+			if (!_client.cap(_cap))
+				_errors++; });
+
+		_server_ep.dissolve(_component);
+
+		if (_errors) {
+			error("test failed with ", _errors, " errors");
+			_env.parent().exit(-1);
+			return;
+		}
+
+		log("Test done.");
+		_env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
@@ -0,0 +1,193 @@
+/*
+ * \brief  Microbenchmark of 'Xml_index' compared to 'Xml_node'
+ * \author Genode Labs
+ * \date   2026-10-15
+ *
+ * The test generates an init-like configuration with many '<start>' nodes
+ * and performs typical queries via 'Xml_node' and 'Xml_index'. Both must
+ * yield the same results.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <util/xml_generator.h>
+#include <util/xml_index.h>
+#include <timer_session/connection.h>
+
+using namespace Genode;
+
+
+struct Main
+{
+	enum { NUM_START_NODES = 2000, BUF_SIZE = 1024*1024, NUM_LOOKUPS = 200 };
+
+	Env               &_env;
+	Heap               _heap  { _env.ram(), _env.rm() };
+	Timer::Connection  _timer { _env };
+
+	char *_buf = nullptr;
+
+	size_t _generate()
+	{
+		Xml_generator xml(_buf, BUF_SIZE, "config", [&] () {
+			xml.node("parent-provides", [&] () {
+				static char const *services[] = { "ROM", "PD", "CPU", "LOG" };
+				for (char const *service : services)
+					xml.node("service", [&] () {
+						xml.attribute("name", service); }); });
+
+			for (unsigned i = 0; i < NUM_START_NODES; i++) {
+				xml.node("start", [&] () {
+					xml.attribute("name", String<16>("child-", i));
+					xml.attribute("caps", 100 + i % 300);
+					xml.node("resource", [&] () {
+						xml.attribute("name", "RAM");
+						xml.attribute("quantum", 1024*1024*(1 + i % 64));
+					});
+					xml.node("route", [&] () {
+						xml.node("service", [&] () {
+							xml.attribute("name", "ROM");
+							xml.attribute("label", "config");
+							xml.node("parent", [&] () {
+								xml.attribute("label", String<24>("child-", i, ".config"));
+							});
+						});
+						xml.node("any-service", [&] () {
+							xml.node("parent", [&] () { }); });
+					});
+				});
+			}
+		});
+		return xml.used();
+	}
+
+	uint64_t _now_us() const { return _timer.elapsed_us(); }
+
+	/**
+	 * Measure and log the execution time of 'fn', return its result
+	 */
+	template <typename FN>
+	uint64_t _measure(char const *name, FN const &fn)
+	{
+		uint64_t const start_us = _now_us();
+		uint64_t const result   = fn();
+		log(name, ": ", _now_us() - start_us, " us");
+		return result;
+	}
+
+	/*
+	 * Query patterns applied to 'Xml_node' and 'Xml_index::Node'
+	 */
+
+	template <typename NODE>
+	static uint64_t _sum_by_index(NODE const &config)
+	{
+		uint64_t sum = 0;
+		for (unsigned i = 0; i < config.num_sub_nodes(); i++)
+			sum += config.sub_node(i).attribute_value("caps", 0UL);
+		return sum;
+	}
+
+	template <typename NODE>
+	static uint64_t _sum_for_each(NODE const &config)
+	{
+		uint64_t sum = 0;
+		config.for_each_sub_node("start", [&] (NODE const &start) {
+			sum += start.attribute_value("caps", 0UL);
+			start.with_sub_node("resource", [&] (NODE const &resource) {
+				sum += resource.attribute_value("quantum", 0UL); });
+			start.with_sub_node("route", [&] (NODE const &route) {
+				route.for_each_sub_node([&] (NODE const &service) {
+					sum += service.num_sub_nodes(); }); });
+		});
+		return sum;
+	}
+
+	template <typename NODE>
+	static uint64_t _sum_lookup_by_name(NODE const &config)
+	{
+		uint64_t sum = 0;
+		for (unsigned i = 0; i < NUM_LOOKUPS; i++) {
+			typedef String<16> Name;
+			Name const name("child-", (i*7919) % NUM_START_NODES);
+			config.for_each_sub_node("start", [&] (NODE const &start) {
+				if (start.attribute_value("name", Name()) == name)
+					sum += start.attribute_value("caps", 0UL); });
+		}
+		return sum;
+	}
+
+	/*
+	 * Noncopyable
+	 */
+	Main(Main const &);
+	Main &operator = (Main const &);
+
+	Main(Env &env) : _env(env)
+	{
+		_heap.alloc(BUF_SIZE, (void **)&_buf);
+
+		size_t const size = _generate();
+		log("--- Xml_index benchmark (", size/1024, " KiB, ",
+		    (unsigned)NUM_START_NODES, " start nodes) ---");
+
+		unsigned errors = 0;
+
+		Xml_node const config(_buf, size);
+
+		uint64_t const start_us = _now_us();
+		Xml_index const index(_heap, config);
+		log("Xml_index construction: ", _now_us() - start_us, " us");
+
+		Xml_index::Node const indexed = index.node();
+
+		/* apply query to 'Xml_node' and 'Xml_index', compare the results */
+		auto compare = [&] (char const *name, auto const &query_fn) {
+
+			uint64_t const a = _measure(String<64>("Xml_node  ", name).string(),
+			                            [&] () { return query_fn(config); });
+			uint64_t const b = _measure(String<64>("Xml_index ", name).string(),
+			                            [&] () { return query_fn(indexed); });
+			if (a == b)
+				return;
+
+			error(name, ": Xml_node result ", a, " differs from Xml_index result ", b);
+			errors++;
+		};
+
+
+		compare("sub_node by index", [&] (auto const &node) {
+			return _sum_by_index(node); });
+
+		compare("for_each_sub_node", [&] (auto const &node) {
+			return _sum_for_each(node); });
+
+		compare("lookup by name", [&] (auto const &node) {
+			return _sum_lookup_by_name(node); });
+
+		log("indexed ", index.num_nodes(), " nodes, ", errors, " errors");
+
+		_heap.free(_buf, BUF_SIZE);
+
+		if (errors) {
+			error("test failed");
+			_env.parent().exit(-1);
+			return;
+		}
+
+		log("Test done.");
+		_env.parent().exit(0);
+	}
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
@@ -349,10 +349,10 @@ struct Vfs_trace::Local_factory : File_system_factory
 {
 	Vfs::Env          &_env;
 
+	/* holds the information of up to 2016 subjects */
+	enum { ARG_BUFFER_SIZE = 512*1024 };
+
 	Trace::Connection  _trace;
-	enum { MAX_SUBJECTS = 128 };
-	Trace::Subject_id  _subjects[MAX_SUBJECTS];
-	unsigned           _subject_count { 0 };
 	Trace::Policy_id   _policy_id { 0 };
 
 	Directory_tree     _tree { _env.alloc() };
@@ -393,12 +393,15 @@ struct Vfs_trace::Local_factory : File_system_factory
 	}
 
 	Local_factory(Vfs::Env &env, Xml_node config)
-	: _env(env), _trace(env.env(), _config_session_ram(config), 512*1024, 0)
+	: _env(env), _trace(env.env(), _config_session_ram(config), ARG_BUFFER_SIZE, 0)
 	{
+		auto insert = [&] (Trace::Subject_id id, Trace::Subject_info const &info) {
+			_tree.insert(info, id); };
+
 		bool success = false;
 		while (!success) {
 			try {
-				_subject_count = _trace.subjects(_subjects, MAX_SUBJECTS);
+				_trace.for_each_subject_info(insert);
 				success = true;
 			} catch(Genode::Out_of_ram) {
 				_trace.upgrade_ram(4096);
@@ -406,10 +409,6 @@ struct Vfs_trace::Local_factory : File_system_factory
 			}
 		}
 
-		for (unsigned i = 0; i < _subject_count; i++) {
-			_tree.insert(_trace.subject_info(_subjects[i]), _subjects[i]);
-		}
-
 		_install_null_policy();
 	}
 
@@ -14,6 +14,8 @@
 /* Genode includes */
 #include <base/env.h>
 #include "cpu_session_component.h"
+#include <pd_session/client.h>
+#include <region_map/client.h>
 #include <util/arg_string.h>
 #include <util/list.h>
 
@@ -89,6 +91,27 @@ Cpu_sampler::Cpu_session_component::trace_control()
 }
 
 
+addr_t Cpu_sampler::Cpu_session_component::stack_area(Pd_session_capability pd)
+{
+	if (!(pd == _stack_area_pd)) {
+
+		_stack_area_pd = pd;
+		_stack_area.destruct();
+
+		try {
+			Region_map_client stack_area_rm(Pd_session_client(pd).stack_area());
+			_stack_area.construct(_env.rm(), stack_area_rm.dataspace());
+		} catch (...) {
+			warning("cannot attach stack area of '", _session_label, "', "
+			        "sampling instruction pointers only");
+		}
+	}
+
+	return _stack_area.constructed()
+	     ? (addr_t)_stack_area->local_addr<void>() : 0;
+}
+
+
 Cpu_sampler::
 Cpu_session_component::
 Cpu_session_component(Rpc_entrypoint             &thread_ep,
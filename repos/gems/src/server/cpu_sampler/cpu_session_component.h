@@ -16,6 +16,7 @@
 
 /* Genode includes */
 #include <base/allocator.h>
+#include <base/attached_dataspace.h>
 #include <base/rpc_server.h>
 #include <cpu_session/client.h>
 #include <os/session_policy.h>
@@ -69,12 +70,23 @@ class Cpu_sampler::Cpu_session_component : public Rpc_object<Cpu_session>
 		Capability<Cpu_session::Native_cpu>      _setup_native_cpu();
 		void _cleanup_native_cpu();
 
+		/* stack area of the threads' PD, attached for unwinding stacks */
+		Pd_session_capability                    _stack_area_pd { };
+		Constructible<Attached_dataspace>        _stack_area    { };
+
 	public:
 
 		Session_label &session_label() { return _session_label; }
 		Cpu_session_client &parent_cpu_session() { return _parent_cpu_session; }
 		Rpc_entrypoint &thread_ep() { return _thread_ep; }
 
+		/**
+		 * Return local address of the stack area of the given PD
+		 *
+		 * \return  local address, or 0 if the stack area cannot be attached
+		 */
+		addr_t stack_area(Pd_session_capability pd);
+
 		/**
 		 * Constructor
 		 */
@@ -21,6 +21,30 @@ static constexpr bool verbose_take_sample = false;
 
 using namespace Genode;
 
+
+/**
+ * Frame pointer of the sampled thread
+ *
+ * Unwinding relies on the frame layout of code compiled with
+ * '-fno-omit-frame-pointer', where the frame pointer refers to the saved
+ * frame pointer of the caller, followed by the return address.
+ */
+static addr_t frame_pointer(Thread_state const &state)
+{
+#if defined(__x86_64__)
+	return state.rbp;
+#elif defined(__i386__)
+	return state.ebp;
+#elif defined(__aarch64__)
+	return state.r[29];
+#else
+	/* the frame layout of 32-bit ARM differs, sample the IP only */
+	(void)state;
+	return 0;
+#endif
+}
+
+
 Cpu_sampler::Cpu_thread_component::Cpu_thread_component(
                                 Cpu_session_component   &cpu_session_component,
                                 Env                     &env,
@@ -34,6 +58,7 @@ Cpu_sampler::Cpu_thread_component::Cpu_thread_component(
                                 unsigned int             thread_id)
 : _cpu_session_component(cpu_session_component), _env(env),
   _md_alloc(md_alloc),
+  _pd(pd),
   _parent_cpu_thread(
       _cpu_session_component.parent_cpu_session().create_thread(pd,
                                                                 name,
@@ -66,7 +91,105 @@ Cpu_sampler::Cpu_thread_component::~Cpu_thread_component()
 }
 
 
-void Cpu_sampler::Cpu_thread_component::take_sample()
+unsigned Cpu_sampler::Cpu_thread_component::_unwind(Thread_state const &state,
+                                                   addr_t frames[],
+                                                   unsigned max_depth)
+{
+	unsigned depth = 0;
+	frames[depth++] = state.ip;
+
+	/*
+	 * The stack area is located at the same virtual address in all
+	 * components. Only the part of the thread's stack slot above the stack
+	 * pointer is guaranteed to be backed by memory.
+	 */
+	addr_t const area_base = Thread::stack_area_virtual_base();
+	addr_t const area_size = Thread::stack_area_virtual_size();
+	addr_t const slot_size = Thread::stack_virtual_size();
+	addr_t const sp        = state.sp;
+
+	if (sp < area_base || sp >= area_base + area_size)
+		return depth;
+
+	addr_t const slot_end = sp - (sp - area_base) % slot_size + slot_size;
+
+	addr_t const local_area = _cpu_session_component.stack_area(_pd);
+	if (!local_area)
+		return depth;
+
+	for (addr_t fp = frame_pointer(state); depth < max_depth; ) {
+
+		if (fp < sp || fp + 2*sizeof(addr_t) > slot_end || fp % sizeof(addr_t))
+			break;
+
+		addr_t const * const frame = (addr_t const *)(local_area + fp - area_base);
+
+		addr_t const caller_fp   = frame[0];
+		addr_t const return_addr = frame[1];
+
+		if (!return_addr)
+			break;
+
+		frames[depth++] = return_addr;
+
+		/* frames of callers reside at higher addresses */
+		if (caller_fp <= fp)
+			break;
+
+		fp = caller_fp;
+	}
+	return depth;
+}
+
+
+void Cpu_sampler::Cpu_thread_component::_add_stack(addr_t const frames[],
+                                                   unsigned depth)
+{
+	/* count identical stacks only once */
+	for (unsigned i = 0; i < _sample_buf_index; i += 2 + _sample_buf[i + 1]) {
+
+		if (_sample_buf[i + 1] != depth)
+			continue;
+
+		if (memcmp(&_sample_buf[i + 2], frames, depth*sizeof(addr_t)) == 0) {
+			_sample_buf[i]++;
+			return;
+		}
+	}
+
+	if (_sample_buf_index + 2 + depth > SAMPLE_BUF_SIZE)
+		flush();
+
+	_sample_buf[_sample_buf_index++] = 1;
+	_sample_buf[_sample_buf_index++] = depth;
+
+	for (unsigned i = 0; i < depth; i++)
+		_sample_buf[_sample_buf_index++] = frames[i];
+}
+
+
+void Cpu_sampler::Cpu_thread_component::_write(char const *string)
+{
+	/* split long lines into chunks that fit into a LOG message */
+	enum { CHUNK_SIZE = Log_session::MAX_STRING_LEN - 1 };
+
+	char chunk[CHUNK_SIZE + 1];
+
+	for (size_t len = strlen(string); len; ) {
+
+		size_t const n = min(len, (size_t)CHUNK_SIZE);
+
+		memcpy(chunk, string, n);
+		chunk[n] = 0;
+		_log->write(chunk);
+
+		string += n;
+		len    -= n;
+	}
+}
+
+
+void Cpu_sampler::Cpu_thread_component::take_sample(unsigned stack_depth)
 {
 	if (verbose_take_sample)
 		Genode::log("taking sample of thread ", _label.string());
@@ -77,14 +200,33 @@ void Cpu_sampler::Cpu_thread_component::take_sample()
 		return;
 	}
 
+	/* do not mix instruction pointers and stacks within one output */
+	bool const sample_stacks = stack_depth > 0;
+	if (sample_stacks != _stacks_sampled) {
+		flush();
+		_stacks_sampled = sample_stacks;
+	}
+
 	try {
 
 		_parent_cpu_thread.pause();
 
 		Thread_state thread_state = _parent_cpu_thread.state();
 
+		/* unwind the stack while the thread is paused */
+		addr_t   frames[MAX_STACK_DEPTH];
+		unsigned depth = 0;
+		if (sample_stacks)
+			depth = _unwind(thread_state, frames,
+			                min(stack_depth, (unsigned)MAX_STACK_DEPTH));
+
 		_parent_cpu_thread.resume();
 
+		if (sample_stacks) {
+			_add_stack(frames, depth);
+			return;
+		}
+
 		_sample_buf[_sample_buf_index++] = thread_state.ip;
 
 		if (_sample_buf_index == SAMPLE_BUF_SIZE)
@@ -112,6 +254,35 @@ void Cpu_sampler::Cpu_thread_component::flush()
 	if (!_log.constructed())
 		_log.construct(_env, _log_session_label);
 
+	if (_stacks_sampled) {
+
+		/*
+		 * Write folded stacks, one line per stack with the frames separated
+		 * by ';' starting at the outermost frame, followed by the count
+		 */
+		enum { FRAME_STRING_SIZE = 2 * sizeof(addr_t) + 1 + 1 };
+
+		char line[MAX_STACK_DEPTH * FRAME_STRING_SIZE + 16];
+
+		for (unsigned i = 0; i < _sample_buf_index; i += 2 + _sample_buf[i + 1]) {
+
+			addr_t   const  count  = _sample_buf[i];
+			unsigned const  depth  = _sample_buf[i + 1];
+			addr_t   const *frames = &_sample_buf[i + 2];
+
+			size_t len = 0;
+			for (unsigned j = depth; j > 0; j--)
+				len += snprintf(line + len, sizeof(line) - len,
+				                j > 1 ? "%lx;" : "%lx", frames[j - 1]);
+
+			snprintf(line + len, sizeof(line) - len, " %lu\n", count);
+			_write(line);
+		}
+
+		_sample_buf_index = 0;
+		return;
+	}
+
 	/* number of hex characters + newline + '\0' */
 	enum { SAMPLE_STRING_SIZE = 2 * sizeof(addr_t) + 1 + 1 };
 
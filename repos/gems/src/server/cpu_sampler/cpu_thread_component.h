@@ -39,6 +39,8 @@ class Cpu_sampler::Cpu_thread_component : public Rpc_object<Cpu_thread>
 
 		Allocator             &_md_alloc;
 
+		Pd_session_capability  _pd;
+
 		Cpu_thread_client      _parent_cpu_thread;
 
 		bool                   _started = false;
@@ -46,13 +48,27 @@ class Cpu_sampler::Cpu_thread_component : public Rpc_object<Cpu_thread>
 		Session_label          _label;
 		Session_label          _log_session_label;
 
+		/*
+		 * The sample buffer holds either instruction pointers or, if stacks
+		 * are sampled, records of a sample count, the stack depth, and the
+		 * frames starting with the innermost one.
+		 */
 		Genode::addr_t         _sample_buf[SAMPLE_BUF_SIZE];
 		unsigned int           _sample_buf_index = 0;
+		bool                   _stacks_sampled = false;
 
 		Constructible<Log_connection> _log;
 
+		unsigned _unwind(Thread_state const &, addr_t frames[], unsigned max_depth);
+
+		void _add_stack(addr_t const frames[], unsigned depth);
+
+		void _write(char const *string);
+
 	public:
 
+		enum { MAX_STACK_DEPTH = 32 };
+
 		Cpu_thread_component(Cpu_session_component   &cpu_session_component,
 		                     Env                     &env,
 		                     Allocator               &md_alloc,
@@ -71,7 +87,11 @@ class Cpu_sampler::Cpu_thread_component : public Rpc_object<Cpu_thread>
 		Thread_capability parent_thread() { return _parent_cpu_thread.rpc_cap(); }
 		Session_label &label() { return _label; }
 
-		void take_sample();
+		/**
+		 * Sample the instruction pointer or, if 'stack_depth' is not 0, the
+		 * call stack of the thread
+		 */
+		void take_sample(unsigned stack_depth);
 		void reset();
 		void flush();
 
@@ -51,6 +51,7 @@ struct Cpu_sampler::Main : Thread_list_change_handler
 	unsigned int            sample_index;
 	unsigned int            max_sample_index;
 	Genode::uint64_t        timeout_us;
+	unsigned int            stack_depth = 0;
 
 
 	void handle_timeout()
@@ -59,7 +60,7 @@ struct Cpu_sampler::Main : Thread_list_change_handler
 
 			Cpu_thread_component *cpu_thread = cpu_thread_element->object();
 
-			cpu_thread->take_sample();
+			cpu_thread->take_sample(stack_depth);
 
 			if (sample_index == max_sample_index)
 				cpu_thread->flush();
@@ -97,6 +98,9 @@ struct Cpu_sampler::Main : Thread_list_change_handler
 
 		timeout_us = sample_interval_ms * 1000;
 
+		stack_depth = Genode::min(config.xml().attribute_value("stack_depth", 0U),
+		                          (unsigned)Cpu_thread_component::MAX_STACK_DEPTH);
+
 		thread_list_changed();
 
 		if (verbose_sample_duration)
@@ -54,6 +54,7 @@ extern "C" {
 
 /* checksum calculation for outgoing packets can be disabled if the hardware supports it */
 #define LWIP_CHECKSUM_ON_COPY       1  /* calculate checksum during memcpy */
+#define LWIP_CHECKSUM_CTRL_PER_NETIF 1 /* netif may offload checksums */
 
 /*********************
  ** Memory settings **
@@ -40,6 +40,12 @@ extern "C" {
 #include <lwip/ethip6.h>
 #endif
 #include <lwip/init.h>
+#include <lwip/inet_chksum.h>
+#include <lwip/prot/ethernet.h>
+#include <lwip/prot/ip.h>
+#include <lwip/prot/ip4.h>
+#include <lwip/prot/ip6.h>
+#include <lwip/prot/tcp.h>
 #include <lwip/dhcp.h>
 #include <lwip/dns.h>
 }
@@ -79,6 +85,9 @@ class Lwip::Nic_netif
 		enum {
 			PACKET_SIZE = Nic::Packet_allocator::DEFAULT_PACKET_SIZE,
 			BUF_SIZE    = 128 * PACKET_SIZE,
+
+			/* room for TCP super frames received with offloading */
+			OFFLOAD_RX_BUF_SIZE = 1024*1024,
 		};
 
 		Genode::Tslab<struct Nic_netif_pbuf, 128> _pbuf_alloc;
@@ -86,6 +95,181 @@ class Lwip::Nic_netif
 		Nic::Packet_allocator _nic_tx_alloc;
 		Nic::Connection _nic;
 
+		/*
+		 * With offloading enabled, lwIP receives TCP super frames and
+		 * frames with partial checksums. It sends MTU-sized frames, whose
+		 * TCP checksum is left partial if checksum offloading is enabled.
+		 */
+		Nic::Offload const _offload { _nic.offload() };
+
+		static Nic::Offload _requested_offload(Genode::Xml_node const &config)
+		{
+			Nic::Offload offload;
+			offload.checksum = offload.tso = config.attribute_value("offload", false);
+			return offload;
+		}
+
+		/**
+		 * Strip offload header and complete a partial checksum
+		 *
+		 * \return  false if the frame is malformed or carries a wrong
+		 *          TCP checksum
+		 */
+		bool _strip_offload_header(char *&content, Genode::size_t &size)
+		{
+			Nic::Offload_header header;
+			if (size < sizeof(header))
+				return false;
+
+			Genode::memcpy(&header, content, sizeof(header));
+			content += sizeof(header);
+			size    -= sizeof(header);
+
+			/* the size of a pbuf is limited to 16 bit */
+			if (size > 0xffff)
+				return false;
+
+			if (!header.needs_checksum())
+				return !_offload.checksum
+				    || (header.flags & Nic::Offload_header::DATA_VALID)
+				    || _tcp_checksum_valid(content, size);
+
+			/* the checksum field holds the sum of the pseudo header */
+			Genode::size_t const start = header.csum_start;
+			Genode::size_t const field = start + header.csum_offset;
+			if (start >= size || field + sizeof(u16_t) > size)
+				return false;
+
+			u16_t const sum = inet_chksum(content + start, (u16_t)(size - start));
+			Genode::memcpy(content + field, &sum, sizeof(sum));
+			return true;
+		}
+
+		/**
+		 * TCP segment within an Ethernet frame
+		 */
+		struct Tcp_segment
+		{
+			Genode::size_t offset;      /* start of the TCP header */
+			Genode::size_t size;        /* size of header and payload */
+			u16_t          pseudo_sum;  /* sum of the pseudo header */
+		};
+
+		/**
+		 * Locate the TCP segment of an unfragmented IPv4 or IPv6 frame
+		 *
+		 * \return  false if the frame carries no such segment
+		 */
+		static bool _tcp_segment(char const *frame, Genode::size_t size,
+		                         Tcp_segment &segment)
+		{
+			if (size < SIZEOF_ETH_HDR)
+				return false;
+
+			eth_hdr const &eth     = *(eth_hdr const *)frame;
+			char    const *ip      = frame + SIZEOF_ETH_HDR;
+			Genode::size_t ip_size = size - SIZEOF_ETH_HDR;
+
+			/* large enough for the IPv6 pseudo header */
+			u8_t  pseudo[40] { };
+			u16_t pseudo_size = 0;
+
+			if (eth.type == PP_HTONS(ETHTYPE_IP) && ip_size >= IP_HLEN) {
+
+				ip_hdr const &ip4      = *(ip_hdr const *)ip;
+				u16_t  const  hdr_size = IPH_HL_BYTES(&ip4);
+				u16_t  const  ip_len   = lwip_ntohs(IPH_LEN(&ip4));
+
+				if (IPH_PROTO(&ip4) != IP_PROTO_TCP
+				 || (IPH_OFFSET(&ip4) & PP_HTONS(IP_OFFMASK | IP_MF))
+				 || hdr_size < IP_HLEN || ip_len < hdr_size || ip_len > ip_size)
+					return false;
+
+				segment.offset = SIZEOF_ETH_HDR + hdr_size;
+				segment.size   = ip_len - hdr_size;
+
+				/* source and destination address, protocol, length */
+				Genode::memcpy(pseudo, &ip4.src, 2*sizeof(ip4.src));
+				pseudo[9]   = IP_PROTO_TCP;
+				pseudo[10]  = (u8_t)(segment.size >> 8);
+				pseudo[11]  = (u8_t)(segment.size);
+				pseudo_size = 12;
+
+			} else if (eth.type == PP_HTONS(ETHTYPE_IPV6) && ip_size >= IP6_HLEN) {
+
+				ip6_hdr const &ip6     = *(ip6_hdr const *)ip;
+				u16_t   const  payload = lwip_ntohs(IP6H_PLEN(&ip6));
+
+				/* segments behind extension headers are not located */
+				if (IP6H_NEXTH(&ip6) != IP6_NEXTH_TCP
+				 || payload > ip_size - IP6_HLEN)
+					return false;
+
+				segment.offset = SIZEOF_ETH_HDR + IP6_HLEN;
+				segment.size   = payload;
+
+				/* source and destination address, length, next header */
+				Genode::memcpy(pseudo, &ip6.src, 2*sizeof(ip6.src));
+				pseudo[34]  = (u8_t)(segment.size >> 8);
+				pseudo[35]  = (u8_t)(segment.size);
+				pseudo[39]  = IP6_NEXTH_TCP;
+				pseudo_size = 40;
+
+			} else {
+				return false;
+			}
+
+			if (segment.size < TCP_HLEN)
+				return false;
+
+			segment.pseudo_sum = (u16_t)~inet_chksum(pseudo, pseudo_size);
+			return true;
+		}
+
+		enum { TCP_CHKSUM_OFFSET = 16 };
+
+		/**
+		 * Return true unless the frame carries a TCP segment with a wrong
+		 * checksum
+		 *
+		 * With checksum offloading enabled, lwIP does not check TCP
+		 * checksums itself because it would reject segments looped back
+		 * to its own address, which carry no checksum.
+		 */
+		static bool _tcp_checksum_valid(char const *frame, Genode::size_t size)
+		{
+			Tcp_segment segment { };
+			if (!_tcp_segment(frame, size, segment))
+				return true;
+
+			u32_t sum = segment.pseudo_sum;
+			sum += (u16_t)~inet_chksum(frame + segment.offset, (u16_t)segment.size);
+			sum  = (sum & 0xffff) + (sum >> 16);
+
+			return sum == 0xffff;
+		}
+
+		/**
+		 * Leave the checksum of an outgoing TCP segment to the receiver
+		 *
+		 * The checksum field receives the sum of the pseudo header, which
+		 * the receiver completes over the segment.
+		 */
+		static void _offload_tcp_checksum(char *frame, Genode::size_t size,
+		                                  Nic::Offload_header &header)
+		{
+			Tcp_segment segment { };
+			if (!_tcp_segment(frame, size, segment))
+				return;
+
+			Genode::memcpy(frame + segment.offset + TCP_CHKSUM_OFFSET,
+			               &segment.pseudo_sum, sizeof(segment.pseudo_sum));
+
+			header.flags       = Nic::Offload_header::NEEDS_CSUM;
+			header.csum_start  = (Genode::uint16_t)segment.offset;
+			header.csum_offset = TCP_CHKSUM_OFFSET;
+		}
+
 		struct netif _netif { };
 
 		ip_addr_t ip { };
@@ -146,16 +330,26 @@ class Lwip::Nic_netif
 
 				Nic::Packet_descriptor packet = rx.get_packet();
 
+				char           *content = rx.packet_content(packet);
+				Genode::size_t  size    = packet.size();
+
+				if (_offload.any() && !_strip_offload_header(content, size)) {
+					Genode::error("malformed Nic packet with offload header");
+					LINK_STATS_INC(link.drop);
+					rx.acknowledge_packet(packet);
+					continue;
+				}
+
 				Nic_netif_pbuf *nic_pbuf = new (_pbuf_alloc)
 					Nic_netif_pbuf(*this, packet);
 
 				pbuf* p = pbuf_alloced_custom(
 					PBUF_RAW,
-					packet.size(),
+					(u16_t)size,
 					PBUF_REF,
 					&nic_pbuf->p,
-					rx.packet_content(packet),
-					packet.size());
+					content,
+					(u16_t)size);
 				LINK_STATS_INC(link.recv);
 
 				if (_netif.input(p, &_netif) != ERR_OK) {
@@ -226,9 +420,10 @@ class Lwip::Nic_netif
 		          Genode::Xml_node config)
 		:
 			_pbuf_alloc(alloc), _nic_tx_alloc(&alloc),
-			_nic(env, &_nic_tx_alloc,
-			     BUF_SIZE, BUF_SIZE,
-			     config.attribute_value("label", Genode::String<160>("lwip")).string()),
+			_nic(env, &_nic_tx_alloc, BUF_SIZE,
+			     _requested_offload(config).any() ? OFFLOAD_RX_BUF_SIZE : BUF_SIZE,
+			     config.attribute_value("label", Genode::String<160>("lwip")).string(),
+			     _requested_offload(config)),
 			_link_state_handler(env.ep(), *this, &Nic_netif::handle_link_state),
 			_rx_packet_handler( env.ep(), *this, &Nic_netif::handle_rx_packets)
 		{
@@ -288,6 +483,16 @@ class Lwip::Nic_netif
 
 			_netif.linkoutput      = nic_netif_linkoutput;
 
+			/*
+			 * The receiver completes the TCP checksums of outgoing
+			 * segments, see 'linkoutput'. TCP checksums of incoming
+			 * segments are checked while stripping the offload header.
+			 */
+			if (_offload.checksum)
+				NETIF_SET_CHECKSUM_CTRL(&_netif, (u16_t)(NETIF_CHECKSUM_ENABLE_ALL
+				                                         & ~NETIF_CHECKSUM_GEN_TCP
+				                                         & ~NETIF_CHECKSUM_CHECK_TCP));
+
 			/* Set physical MAC address */
 			Nic::Mac_address const mac = _nic.mac_address();
 			for(int i=0; i<6; ++i)
@@ -325,24 +530,37 @@ class Lwip::Nic_netif
 				return ERR_WOULDBLOCK;
 			}
 
+			Genode::size_t const header_size =
+				_offload.any() ? sizeof(Nic::Offload_header) : 0;
+
 			Nic::Packet_descriptor packet;
-			try { packet = tx.alloc_packet(p->tot_len); }
+			try { packet = tx.alloc_packet(header_size + p->tot_len); }
 			catch (...) {
 				Genode::error("lwIP: Nic packet allocation failed, cannot send packet");
 				return ERR_WOULDBLOCK;
 			}
 
+			char * const frame = tx.packet_content(packet) + header_size;
+			char        *dst   = frame;
+
 			/*
 			 * We iterate over the pbuf chain until we have read the entire
 			 * pbuf into the packet.
 			 */
-			char *dst = tx.packet_content(packet);
 			for(struct pbuf *q = p; q != 0; q = q->next) {
 				char const *src = (char*)q->payload;
 				Genode::memcpy(dst, src, q->len);
 				dst += q->len;
 			}
 
+			if (_offload.any()) {
+				Nic::Offload_header header;
+				if (_offload.checksum)
+					_offload_tcp_checksum(frame, p->tot_len, header);
+
+				Genode::memcpy(tx.packet_content(packet), &header, sizeof(header));
+			}
+
 			tx.submit_packet(packet);
 			LINK_STATS_INC(link.xmit);
 			return ERR_OK;
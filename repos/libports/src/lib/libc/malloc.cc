@@ -16,7 +16,9 @@
 #include <base/env.h>
 #include <base/log.h>
 #include <base/slab.h>
+#include <base/thread.h>
 #include <util/construct_at.h>
+#include <util/reconstructible.h>
 #include <util/string.h>
 #include <util/misc_math.h>
 
@@ -66,6 +68,14 @@ namespace Genode {
 
 /**
  * Allocator that uses slabs for small objects sizes
+ *
+ * Small objects are allocated from one of several arenas, each holding a
+ * set of slabs. Threads are distributed over the arenas so that threads
+ * rarely contend for the same arena lock. A block freed by a thread of
+ * another arena is handed back to its arena via a lock-free list, which is
+ * drained by the next allocation from the arena. If the list grows long,
+ * e.g., because the threads of the arena exited, the freeing thread drains
+ * it.
  */
 class Malloc
 {
@@ -77,23 +87,41 @@ class Malloc
 		enum {
 			SLAB_START = 5,  /* 32 bytes (log2) */
 			SLAB_STOP  = 11, /* 2048 bytes (log2) */
-			NUM_SLABS  = (SLAB_STOP - SLAB_START) + 1
+			NUM_SLABS  = (SLAB_STOP - SLAB_START) + 1,
+			NUM_ARENAS = 8,
+
+			/* number of remotely freed blocks that triggers draining */
+			REMOTE_FREE_LIMIT = 64,
+
+			/*
+			 * The backing store provides blocks of at least this size
+			 * (log2), i.e., 64 KiB, as dedicated dataspaces. We request
+			 * whole pages for such blocks to enable the in-place growth on
+			 * 'realloc'.
+			 */
+			LARGE_LOG2 = 16,
 		};
 
 		struct Metadata
 		{
-			unsigned long long value; /* bits 63..5 size and 4..0 offset */
+			unsigned long long value; /* bits 63..13 size, 12..5 arena,
+			                             and 4..0 offset */
 
 			/**
 			 * Allocation metadata
 			 *
 			 * \param size    allocation size
+			 * \param arena   arena of slab allocation
 			 * \param offset  offset of pointer from allocation
 			 */
-			Metadata(size_t size, unsigned offset)
-			: value(((unsigned long long)size << 5) | (offset & 0x1f)) { }
+			Metadata(size_t size, unsigned arena, unsigned offset)
+			:
+				value(((unsigned long long)size << 13) | ((arena & 0xff) << 5)
+				      | (offset & 0x1f))
+			{ }
 
-			size_t   size()   const { return value >> 5; }
+			size_t   size()   const { return value >> 13; }
+			unsigned arena()  const { return (value >> 5) & 0xff; }
 			unsigned offset() const { return value & 0x1f; }
 		};
 
@@ -112,16 +140,40 @@ class Malloc
 		 */
 		static constexpr size_t _room() { return sizeof(Metadata) + 15; }
 
-		Genode::Allocator  &_backing_store;        /* back-end allocator */
-		Genode::Slab_alloc *_allocator[NUM_SLABS]; /* slab allocators */
-		Genode::Lock        _lock;
+		/**
+		 * Slab block freed by a thread of another arena
+		 *
+		 * The list element is stored in the freed block itself.
+		 */
+		struct Remote_free
+		{
+			Remote_free    *next;
+			unsigned const  msb;
+
+			Remote_free(unsigned msb) : next(nullptr), msb(msb) { }
+		};
+
+		struct Arena
+		{
+			Genode::Lock lock { };
+
+			/* slabs are constructed on first use */
+			Genode::Constructible<Genode::Slab_alloc> slab[NUM_SLABS] { };
+
+			/* blocks freed by other threads, accessed atomically */
+			Remote_free *remote_free = nullptr;
+			unsigned     remote_count = 0;
+		};
+
+		Genode::Allocator &_backing_store; /* back-end allocator */
+		Arena              _arenas[NUM_ARENAS];
 
 		unsigned _slab_log2(size_t size) const
 		{
 			unsigned msb = Genode::log2(size);
 
 			/* size is greater than msb */
-			if (size > (1U << msb))
+			if (size > (1UL << msb))
 				msb++;
 
 			/* use smallest slab */
@@ -131,16 +183,83 @@ class Malloc
 			return msb;
 		}
 
-	public:
+		/**
+		 * Return arena of the calling thread
+		 *
+		 * Threads are distributed over the arenas by the slot of their stack
+		 * within the stack area, which does not require thread-local storage.
+		 */
+		static unsigned _arena_index()
+		{
+			addr_t const sp = (addr_t)__builtin_frame_address(0);
+
+			return ((sp - Genode::Thread::stack_area_virtual_base())
+			        / Genode::Thread::stack_virtual_size()) % NUM_ARENAS;
+		}
+
+		/**
+		 * Return the blocks freed by other threads to the slabs
+		 *
+		 * Must be called with the arena lock held.
+		 */
+		static void _drain_remote_free(Arena &arena)
+		{
+			Remote_free *rf = __atomic_exchange_n(&arena.remote_free,
+			                                      (Remote_free *)nullptr,
+			                                      __ATOMIC_ACQUIRE);
+			unsigned count = 0;
+			while (rf) {
+				Remote_free * const next = rf->next;
+				arena.slab[rf->msb - SLAB_START]->free(rf);
+				rf = next;
+				count++;
+			}
+			__atomic_sub_fetch(&arena.remote_count, count, __ATOMIC_RELAXED);
+		}
+
+		void *_slab_alloc(Arena &arena, unsigned msb)
+		{
+			Genode::Lock::Guard lock_guard(arena.lock);
+
+			if (__atomic_load_n(&arena.remote_free, __ATOMIC_RELAXED))
+				_drain_remote_free(arena);
+
+			Genode::Constructible<Genode::Slab_alloc> &slab =
+				arena.slab[msb - SLAB_START];
+
+			if (!slab.constructed()) {
+				try { slab.construct(1UL << msb, &_backing_store); }
+				catch (Genode::Allocator::Out_of_memory) { return nullptr; }
+			}
+
+			return slab->alloc();
+		}
 
-		Malloc(Genode::Allocator &backing_store) : _backing_store(backing_store)
+		static void _slab_free_remote(Arena &arena, void *alloc_addr, unsigned msb)
 		{
-			for (unsigned i = SLAB_START; i <= SLAB_STOP; i++) {
-				_allocator[i - SLAB_START] =
-					new (backing_store) Genode::Slab_alloc(1U << i, &backing_store);
+			Remote_free * const rf = Genode::construct_at<Remote_free>(alloc_addr, msb);
+
+			rf->next = __atomic_load_n(&arena.remote_free, __ATOMIC_RELAXED);
+			while (!__atomic_compare_exchange_n(&arena.remote_free, &rf->next, rf,
+			                                    true, __ATOMIC_RELEASE,
+			                                    __ATOMIC_RELAXED));
+
+			/*
+			 * The arena may not allocate anymore, e.g., if its threads
+			 * exited. Bound the number of blocks stranded in the list by
+			 * draining it on behalf of the arena.
+			 */
+			if (__atomic_add_fetch(&arena.remote_count, 1, __ATOMIC_RELAXED)
+			    >= REMOTE_FREE_LIMIT) {
+				Genode::Lock::Guard lock_guard(arena.lock);
+				_drain_remote_free(arena);
 			}
 		}
 
+	public:
+
+		Malloc(Genode::Allocator &backing_store) : _backing_store(backing_store) { }
+
 		~Malloc() { Genode::warning(__func__, " unexpectedly called"); }
 
 		/**
@@ -149,18 +268,24 @@ class Malloc
 
 		void * alloc(size_t size)
 		{
-			Genode::Lock::Guard lock_guard(_lock);
-
-			size_t   const real_size = size + _room();
+			size_t         real_size = size + _room();
 			unsigned const msb       = _slab_log2(real_size);
+			unsigned const arena     = _arena_index();
 
 			void *alloc_addr = nullptr;
 
-			/* use backing store if requested memory is larger than largest slab */
-			if (msb > SLAB_STOP)
+			/*
+			 * Use backing store if requested memory is larger than largest
+			 * slab. The backing store is thread safe, so these allocations
+			 * bypass the arenas.
+			 */
+			if (msb > SLAB_STOP) {
+				if (real_size >= (1UL << LARGE_LOG2))
+					real_size = Genode::align_addr(real_size, 12);
 				_backing_store.alloc(real_size, &alloc_addr);
-			else
-				alloc_addr = _allocator[msb - SLAB_START]->alloc();
+			} else {
+				alloc_addr = _slab_alloc(_arenas[arena], msb);
+			}
 
 			if (!alloc_addr) return nullptr;
 
@@ -170,20 +295,33 @@ class Malloc
 
 			unsigned const offset = (addr_t)aligned_addr - (addr_t)alloc_addr;
 
-			*(aligned_addr - 1) = Metadata(real_size, offset);
+			*(aligned_addr - 1) = Metadata(real_size, arena, offset);
 
 			return aligned_addr;
 		}
 
 		void *realloc(void *ptr, size_t size)
 		{
-			size_t const real_size     = size + _room();
-			size_t const old_real_size = ((Metadata *)ptr - 1)->size();
+			Metadata * const md = (Metadata *)ptr - 1;
+
+			size_t   const real_size     = size + _room();
+			size_t   const old_real_size = md->size();
+			unsigned const old_msb       = _slab_log2(old_real_size);
 
 			/* do not reallocate if new size is less than the current size */
 			if (real_size <= old_real_size)
 				return ptr;
 
+			/*
+			 * Grow in place if the new size stays within the size class of the
+			 * slab entry, which is determined by the size stored in the
+			 * metadata.
+			 */
+			if (old_msb <= SLAB_STOP && _slab_log2(real_size) == old_msb) {
+				*md = Metadata(real_size, md->arena(), md->offset());
+				return ptr;
+			}
+
 			/* allocate new block */
 			void *new_addr = alloc(size);
 
@@ -200,20 +338,26 @@ class Malloc
 
 		void free(void *ptr)
 		{
-			Genode::Lock::Guard lock_guard(_lock);
-
 			Metadata *md = (Metadata *)ptr - 1;
 
-			size_t   const  real_size  = md->size();
-			unsigned const  msb        = _slab_log2(real_size);
+			size_t   const real_size = md->size();
+			unsigned const msb       = _slab_log2(real_size);
+			unsigned const arena     = md->arena();
 
 			void *alloc_addr = (void *)((addr_t)ptr - md->offset());
 
 			if (msb > SLAB_STOP) {
 				_backing_store.free(alloc_addr, real_size);
-			} else {
-				_allocator[msb - SLAB_START]->free(alloc_addr);
+				return;
 			}
+
+			if (arena != _arena_index()) {
+				_slab_free_remote(_arenas[arena], alloc_addr, msb);
+				return;
+			}
+
+			Genode::Lock::Guard lock_guard(_arenas[arena].lock);
+			_arenas[arena].slab[msb - SLAB_START]->free(alloc_addr);
 		}
 };
 
@@ -0,0 +1,211 @@
+/*
+ * \brief  Benchmark of the libc malloc with an increasing number of threads
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * Each worker thread repeatedly allocates a batch of blocks of varying
+ * sizes, grows some of them via 'realloc', and frees the batch. Half of
+ * the batch is freed by the neighbouring worker to exercise the return of
+ * blocks to the arena of another thread. The workers are distributed over
+ * the available CPUs.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/heap.h>
+#include <base/log.h>
+#include <base/semaphore.h>
+#include <base/thread.h>
+#include <libc/component.h>
+#include <timer_session/connection.h>
+
+/* libc includes */
+#include <stdlib.h>
+#include <string.h>
+
+using namespace Genode;
+
+
+struct Worker : Thread
+{
+	enum { STACK_SIZE = 16*1024, BATCH = 64, ROUNDS = 20000 };
+
+	unsigned  const _seed;
+	unsigned        _errors = 0;
+	Worker         *_neighbour = nullptr;
+
+	/* blocks handed over by the neighbour, freed by this worker */
+	void * volatile _handover[BATCH / 2] { };
+
+	Semaphore _handover_empty { 1 };
+	Semaphore _handover_full  { 0 };
+
+	/**
+	 * Pseudo-random block size, mostly small with occasional large blocks
+	 */
+	static size_t _size(unsigned &state)
+	{
+		state = state*1103515245 + 12345;
+		unsigned const r = state >> 8;
+		return (r % 1024 == 0) ? 64*1024 + r % (128*1024) : 8 + r % 1024;
+	}
+
+	void _check(void *ptr, unsigned char pattern, size_t size)
+	{
+		unsigned char const *bytes = (unsigned char const *)ptr;
+		if (bytes[0] != pattern || bytes[size - 1] != pattern)
+			_errors++;
+	}
+
+	void _hand_over(void *blocks[])
+	{
+		_neighbour->_handover_empty.down();
+		for (unsigned i = 0; i < BATCH / 2; i++)
+			_neighbour->_handover[i] = blocks[i];
+		_neighbour->_handover_full.up();
+	}
+
+	void _free_handed_over()
+	{
+		_handover_full.down();
+		for (unsigned i = 0; i < BATCH / 2; i++)
+			free(_handover[i]);
+		_handover_empty.up();
+	}
+
+	void entry() override
+	{
+		void     *blocks[BATCH];
+		unsigned  state = _seed;
+
+		for (unsigned round = 0; round < ROUNDS; round++) {
+
+			for (unsigned i = 0; i < BATCH; i++) {
+				size_t const size = _size(state);
+				blocks[i] = malloc(size);
+				if (!blocks[i]) { _errors++; return; }
+				::memset(blocks[i], i, size);
+
+				/* grow every fourth block */
+				if (i % 4)
+					continue;
+
+				void * const grown = realloc(blocks[i], size + 64);
+				if (!grown) { _errors++; return; }
+				_check(grown, i, size);
+				blocks[i] = grown;
+			}
+
+			if (_neighbour != this) {
+				_hand_over(blocks);
+				_free_handed_over();
+			} else {
+				for (unsigned i = 0; i < BATCH / 2; i++)
+					free(blocks[i]);
+			}
+
+			for (unsigned i = BATCH / 2; i < BATCH; i++)
+				free(blocks[i]);
+		}
+	}
+
+	Worker(Env &env, Location location, unsigned seed)
+	:
+		Thread(env, Name("worker"), STACK_SIZE, location, Weight(), env.cpu()),
+		_seed(seed)
+	{ }
+
+	unsigned errors() const { return _errors; }
+
+	void neighbour(Worker &neighbour) { _neighbour = &neighbour; }
+
+	/*
+	 * Noncopyable
+	 */
+	Worker(Worker const &);
+	Worker &operator = (Worker const &);
+};
+
+
+struct Main
+{
+	enum { DEFAULT_MAX_THREADS = 4, MAX_THREADS = 32 };
+
+	Libc::Env         &_env;
+	Heap               _heap  { _env.ram(), _env.rm() };
+	Timer::Connection  _timer { _env };
+
+	Affinity::Space _cpus = _env.cpu().affinity_space();
+
+	unsigned _max_threads = DEFAULT_MAX_THREADS;
+
+	/**
+	 * Run benchmark with 'n' workers, return number of errors
+	 */
+	unsigned _run(unsigned n)
+	{
+		Worker *workers[MAX_THREADS];
+
+		for (unsigned i = 0; i < n; i++)
+			workers[i] = new (_heap)
+				Worker(_env, _cpus.location_of_index(i % _cpus.total()), i + 1);
+
+		for (unsigned i = 0; i < n; i++)
+			workers[i]->neighbour(*workers[(i + 1) % n]);
+
+		uint64_t const start_us = _timer.elapsed_us();
+
+		for (unsigned i = 0; i < n; i++) workers[i]->start();
+		for (unsigned i = 0; i < n; i++) workers[i]->join();
+
+		uint64_t const duration_us = _timer.elapsed_us() - start_us;
+		uint64_t const ops = (uint64_t)n*Worker::ROUNDS*Worker::BATCH;
+
+		log(n, " thread", n > 1 ? "s" : " ", ": ", duration_us/1000, " ms, ",
+		    ops*1000 / max(duration_us, (uint64_t)1), " allocations/ms");
+
+		unsigned errors = 0;
+		for (unsigned i = 0; i < n; i++) {
+			errors += workers[i]->errors();
+			destroy(_heap, workers[i]);
+		}
+		return errors;
+	}
+
+	/*
+	 * Noncopyable
+	 */
+	Main(Main const &);
+	Main &operator = (Main const &);
+
+	Main(Libc::Env &env) : _env(env)
+	{
+		_env.config([&] (Xml_node config) {
+			_max_threads = min(config.attribute_value("max_threads", _max_threads),
+			                   (unsigned)MAX_THREADS); });
+
+		log("--- malloc benchmark (", _cpus.total(), " CPUs) ---");
+
+		unsigned errors = 0;
+		for (unsigned n = 1; n <= _max_threads; n++)
+			errors += _run(n);
+
+		if (errors) {
+			error("test failed with ", errors, " errors");
+			_env.parent().exit(-1);
+			return;
+		}
+
+		log("Test done.");
+		_env.parent().exit(0);
+	}
+};
+
+
+void Libc::Component::construct(Libc::Env &env) { static Main main(env); }
@@ -247,14 +247,16 @@ class Block::Request_stream : Genode::Noncopyable
 
 				friend class Request_stream;
 
-				Tx_sink &_tx_sink;
+				typedef Block::Packet_descriptor Packet_descriptor;
+
+				Packet_descriptor &_packet;
 
 				bool _submitted = false;
 
 				Genode::size_t const _block_size;
 
-				Ack(Tx_sink &tx_sink, Genode::size_t block_size)
-				: _tx_sink(tx_sink), _block_size(block_size) { }
+				Ack(Packet_descriptor &packet, Genode::size_t block_size)
+				: _packet(packet), _block_size(block_size) { }
 
 			public:
 
@@ -265,16 +267,14 @@ class Block::Request_stream : Genode::Noncopyable
 						return;
 					}
 
-					typedef Block::Packet_descriptor Packet_descriptor;
 					Packet_descriptor::Payload
 						payload { .offset = request.offset,
 						          .bytes  = request.operation.count * _block_size };
 
-					Packet_descriptor packet(request.operation, payload, request.tag);
+					_packet = Packet_descriptor(request.operation, payload, request.tag);
 
-					packet.succeeded(request.success);
+					_packet.succeeded(request.success);
 
-					_tx_sink.try_ack_packet(packet);
 					_submitted = true;
 				}
 		};
@@ -286,20 +286,40 @@ class Block::Request_stream : Genode::Noncopyable
 		 * which provides an interface to 'submit' one acknowledgement. The
 		 * iteration stops when the acknowledgement queue is fully populated or if
 		 * the functor does not call 'Ack::submit'.
+		 *
+		 * The acknowledgements are collected locally and handed over to the
+		 * packet stream in batches. The client is not signalled before
+		 * 'wakeup_client_if_needed' is called.
 		 */
 		template <typename FN>
 		void try_acknowledge(FN const &fn)
 		{
 			Tx_sink &tx_sink = *_tx.sink();
 
-			while (tx_sink.ack_slots_free()) {
+			enum { MAX_BATCH = 32 };
 
-				Ack ack(tx_sink, _payload._info.block_size);
+			Block::Packet_descriptor batch[MAX_BATCH];
 
-				fn(ack);
+			for (;;) {
 
-				if (!ack._submitted)
-					break;
+				unsigned const max = Genode::min((unsigned)MAX_BATCH,
+				                                 tx_sink.ack_slots_free());
+				unsigned n = 0;
+
+				for (; n < max; n++) {
+
+					Ack ack(batch[n], _payload._info.block_size);
+
+					fn(ack);
+
+					if (!ack._submitted)
+						break;
+				}
+
+				tx_sink.try_ack_packets(batch, n);
+
+				if (n < max || n == 0)
+					return;
 			}
 		}
 
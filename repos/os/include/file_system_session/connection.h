@@ -63,25 +63,36 @@ struct File_system::Connection : Genode::Connection<Session>, Session_client
 	 * \param root             root directory of session
 	 * \param writeable        session is writable
 	 * \param tx_buf_size      size of transmission buffer in bytes
+	 * \param queue_depth      number of packets per node the server may
+	 *                         process in a pipelined fashion, up to
+	 *                         'tx_queue_size'
+	 * \param tx_queue_size    number of packets the client keeps in flight
+	 *                         at most, up to 'TX_QUEUE_SIZE'
 	 */
 	Connection(Genode::Env             &env,
 	           Genode::Range_allocator &tx_block_alloc,
 	           char const              *label       = "",
 	           char const              *root        = "/",
 	           bool                     writeable   = true,
-	           size_t                   tx_buf_size = DEFAULT_TX_BUF_SIZE)
+	           size_t                   tx_buf_size = DEFAULT_TX_BUF_SIZE,
+	           unsigned                 queue_depth = 1,
+	           unsigned                 tx_queue_size = TX_QUEUE_SIZE)
 	:
 		Genode::Connection<Session>(env,
 			session(env.parent(),
 			        "ram_quota=%ld, "
 			        "cap_quota=%ld, "
 			        "tx_buf_size=%ld, "
+			        "queue_depth=%u, "
+			        "tx_queue_size=%u, "
 			        "label=\"%s\", "
 			        "root=\"%s\", "
 			        "writeable=%d",
 			        8*1024*sizeof(long) + tx_buf_size,
 			        CAP_QUOTA,
 			        tx_buf_size,
+			        queue_depth,
+			        tx_queue_size,
 			        label, root, writeable)),
 		Session_client(cap(), tx_block_alloc, env.rm())
 	{ }
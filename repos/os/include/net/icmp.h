@@ -20,7 +20,11 @@
 
 namespace Genode { class Output; }
 
-namespace Net { class Icmp_packet; }
+namespace Net {
+
+	class Icmp_packet;
+	class Internet_checksum_diff;
+}
 
 
 class Net::Icmp_packet
@@ -57,6 +61,8 @@ class Net::Icmp_packet
 
 		void update_checksum(Genode::size_t data_sz);
 
+		void update_checksum(Internet_checksum_diff const &icd);
+
 		bool checksum_error(Genode::size_t data_sz) const;
 
 
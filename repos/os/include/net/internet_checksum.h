@@ -20,6 +20,8 @@
 
 namespace Net {
 
+	class Internet_checksum_diff;
+
 	Genode::uint16_t internet_checksum(Genode::uint16_t const *addr,
 	                                   Genode::size_t          size,
 	                                   Genode::addr_t          init_sum = 0);
@@ -32,4 +34,37 @@ namespace Net {
 	                                             Ipv4_address           &ip_dst);
 }
 
+
+/**
+ * Accumulated change of checksummed data (RFC 1624)
+ *
+ * Instead of recomputing a checksum over all data when only a few header
+ * fields change, the changes get accumulated and applied to the checksum
+ * that was valid for the original data.
+ */
+class Net::Internet_checksum_diff
+{
+	private:
+
+		Genode::uint64_t _value { 0 };
+
+	public:
+
+		/**
+		 * Add up the change from 'old_data' to 'new_data'
+		 *
+		 * \param size  size of both data blocks in bytes, must be even
+		 */
+		void add_up_diff(Genode::uint16_t const *new_data,
+		                 Genode::uint16_t const *old_data,
+		                 Genode::size_t          size);
+
+		/**
+		 * Return checksum adapted to the accumulated change
+		 *
+		 * \param checksum  checksum as stored in the packet
+		 */
+		Genode::uint16_t apply_to(Genode::uint16_t checksum) const;
+};
+
 #endif /* _NET__INTERNET_CHECKSUM_H_ */
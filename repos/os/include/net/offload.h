@@ -0,0 +1,87 @@
+/*
+ * \brief  Software fallback for NIC offload features
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * Components that forward frames between NIC sessions with different
+ * offload features resolve the features not supported by the receiving
+ * side with these utilities.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _NET__OFFLOAD_H_
+#define _NET__OFFLOAD_H_
+
+/* Genode includes */
+#include <base/exception.h>
+#include <nic_session/nic_session.h>
+
+namespace Net {
+
+	class Tcp_super_frame;
+
+	/**
+	 * Complete the partial checksum of a frame
+	 *
+	 * \return  false if the checksum location lies outside of the frame
+	 */
+	bool complete_checksum(void *frame, Genode::size_t size,
+	                       Nic::Offload_header const &header);
+}
+
+
+/**
+ * TCP/IPv4 super frame to be split into segments of the MTU size
+ *
+ * Each segment gets a copy of the Ethernet, IPv4, and TCP headers of the
+ * super frame with adapted length, identification, sequence number, flags,
+ * and complete checksums.
+ */
+class Net::Tcp_super_frame
+{
+	public:
+
+		struct Invalid : Genode::Exception { };
+
+	private:
+
+		Genode::uint8_t const * const _frame;
+
+		Genode::size_t _tcp_offset   { 0 };  /* offset of TCP header */
+		Genode::size_t _header_size  { 0 };  /* size of all headers */
+		Genode::size_t _payload_size { 0 };
+		Genode::size_t _mss;
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \throw Invalid  frame is no TCP/IPv4 super frame
+		 */
+		Tcp_super_frame(void const *frame, Genode::size_t size,
+		                Nic::Offload_header const &header);
+
+		unsigned num_segments() const
+		{
+			return (unsigned)((_payload_size + _mss - 1) / _mss);
+		}
+
+		/**
+		 * Return size of segment 'i' including all headers
+		 */
+		Genode::size_t segment_size(unsigned i) const;
+
+		/**
+		 * Write segment 'i' to 'dst', which must hold 'segment_size(i)' bytes
+		 */
+		void write_segment(unsigned i, void *dst) const;
+};
+
+#endif /* _NET__OFFLOAD_H_ */
@@ -27,6 +27,7 @@ namespace Net
 {
 	class Tcp_state;
 	class Tcp_packet;
+	class Internet_checksum_diff;
 }
 
 /**
@@ -68,12 +69,22 @@ class Net::Tcp_packet
 			struct Ns  : Bitfield<8, 1> { };
 		};
 
+		template <typename FLAG>
+		void _set_flag(bool v)
+		{
+			Flags::access_t f = flags();
+			FLAG::set(f, v);
+			flags(f);
+		}
+
 	public:
 
 		void update_checksum(Ipv4_address ip_src,
 		                     Ipv4_address ip_dst,
 		                     size_t       tcp_size);
 
+		void update_checksum(Internet_checksum_diff const &icd);
+
 
 		/***************
 		 ** Accessors **
@@ -100,6 +111,17 @@ class Net::Tcp_packet
 
 		void src_port(Port p) { _src_port = host_to_big_endian(p.value); }
 		void dst_port(Port p) { _dst_port = host_to_big_endian(p.value); }
+		void seq_nr(uint32_t v) { _seq_nr = host_to_big_endian(v); }
+
+		void flags(uint16_t v)
+		{
+			_flags_lsb = (uint8_t)v;
+			_flags_msb = (v >> 8) & 1;
+		}
+
+		void fin(bool v) { _set_flag<Flags::Fin>(v); }
+		void psh(bool v) { _set_flag<Flags::Psh>(v); }
+		void crw(bool v) { _set_flag<Flags::Crw>(v); }
 
 
 		/*********
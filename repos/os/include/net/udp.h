@@ -22,7 +22,11 @@
 #include <net/ethernet.h>
 #include <net/ipv4.h>
 
-namespace Net { class Udp_packet; }
+namespace Net {
+
+	class Udp_packet;
+	class Internet_checksum_diff;
+}
 
 
 /**
@@ -75,6 +79,13 @@ class Net::Udp_packet
 		void update_checksum(Ipv4_address ip_src,
 		                     Ipv4_address ip_dst);
 
+		/**
+		 * Adapt checksum to changed header fields
+		 *
+		 * A packet without checksum keeps going without checksum.
+		 */
+		void update_checksum(Internet_checksum_diff const &icd);
+
 		bool checksum_error(Ipv4_address ip_src,
 		                    Ipv4_address ip_dst) const;
 
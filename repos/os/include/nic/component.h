@@ -54,6 +54,7 @@ class Nic::Session_component : Communication_buffers, public Session_rpc_object
 
 		Genode::Entrypoint               &_ep;
 		Genode::Signal_context_capability _link_state_sigh { };
+		Offload                           _offload         { };
 
 
 		/**
@@ -68,10 +69,31 @@ class Nic::Session_component : Communication_buffers, public Session_rpc_object
 		/**
 		 * Sub-classes must implement this function, it is called upon all
 		 * packet-stream signals.
+		 *
+		 * Packets submitted or acknowledged via the non-blocking 'try_'
+		 * or batch variants of the packet-stream interface are signalled
+		 * to the client once after this function returns.
 		 */
 		virtual void _handle_packet_stream() = 0;
 
-		void _dispatch() { _handle_packet_stream(); }
+		/**
+		 * Enable offload features requested by the client
+		 *
+		 * Sub-classes that support offload features override this
+		 * function. It is called once after the construction of the
+		 * session.
+		 *
+		 * \return  subset of 'requested' features that got enabled
+		 */
+		virtual Offload _enable_offload(Offload const &) { return Offload(); }
+
+		void _dispatch()
+		{
+			_handle_packet_stream();
+
+			_tx.sink()->wakeup();
+			_rx.source()->wakeup();
+		}
 
 		Genode::Signal_handler<Session_component> _packet_stream_dispatcher {
 			_ep, *this, &Session_component::_dispatch };
@@ -152,6 +174,16 @@ class Nic::Session_component : Communication_buffers, public Session_rpc_object
 			_link_state_sigh = sigh;
 		}
 
+		/**
+		 * Negotiate offload features at session-creation time
+		 */
+		void negotiate_offload(Offload const &requested)
+		{
+			_offload = _enable_offload(requested) & requested;
+		}
+
+		Offload offload() override { return _offload; }
+
 		/**
 		 * Return the current link state
 		 */
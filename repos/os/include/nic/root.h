@@ -59,9 +59,15 @@ class Nic::Root : public Genode::Root_component<SESSION_COMPONENT,
 				throw Genode::Insufficient_ram_quota();
 			}
 
-			return new (Root::md_alloc())
-			            SESSION_COMPONENT(tx_buf_size, rx_buf_size,
-			                             _md_alloc, _env);
+			Offload offload;
+			offload.checksum = Arg_string::find_arg(args, "offload_checksum").bool_value(false);
+			offload.tso      = Arg_string::find_arg(args, "offload_tso").bool_value(false);
+
+			SESSION_COMPONENT *session = new (Root::md_alloc())
+				SESSION_COMPONENT(tx_buf_size, rx_buf_size, _md_alloc, _env);
+
+			session->negotiate_offload(offload);
+			return session;
 		}
 
 	public:
@@ -23,6 +23,18 @@ namespace Nic { struct Connection; }
 
 struct Nic::Connection : Genode::Connection<Session>, Session_client
 {
+	typedef Genode::String<48> Offload_args;
+
+	/*
+	 * Keep the session arguments short for clients that request no
+	 * offload features
+	 */
+	static Offload_args _offload_args(Offload const &offload)
+	{
+		return Offload_args(offload.checksum ? ", offload_checksum=yes" : "",
+		                    offload.tso      ? ", offload_tso=yes"      : "");
+	}
+
 	/**
 	 * Constructor
 	 *
@@ -30,19 +42,24 @@ struct Nic::Connection : Genode::Connection<Session>, Session_client
 	 *                         transmission buffer
 	 * \param tx_buf_size      size of transmission buffer in bytes
 	 * \param rx_buf_size      size of reception buffer in bytes
+	 * \param offload          offload features requested from the server,
+	 *                         the enabled features are returned by
+	 *                         'offload()'
 	 */
 	Connection(Genode::Env             &env,
 	           Genode::Range_allocator *tx_block_alloc,
 	           Genode::size_t           tx_buf_size,
 	           Genode::size_t           rx_buf_size,
-	           char const              *label = "")
+	           char const              *label   = "",
+	           Offload const           &offload = Offload())
 	:
 		Genode::Connection<Session>(env,
 			session(env.parent(),
 			        "ram_quota=%ld, cap_quota=%ld, "
-			        "tx_buf_size=%ld, rx_buf_size=%ld, label=\"%s\"",
+			        "tx_buf_size=%ld, rx_buf_size=%ld, label=\"%s\"%s",
 			        32*1024*sizeof(long) + tx_buf_size + rx_buf_size,
-			        CAP_QUOTA, tx_buf_size, rx_buf_size, label)),
+			        CAP_QUOTA, tx_buf_size, rx_buf_size, label,
+			        _offload_args(offload).string())),
 		Session_client(cap(), *tx_block_alloc, env.rm())
 	{ }
 };
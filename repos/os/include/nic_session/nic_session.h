@@ -27,6 +27,8 @@ namespace Nic {
 	using Mac_address = Net::Mac_address;
 
 	struct Session;
+	struct Offload;
+	struct Offload_header;
 
 	using Genode::Packet_stream_sink;
 	using Genode::Packet_stream_source;
@@ -35,6 +37,80 @@ namespace Nic {
 }
 
 
+/**
+ * Offload features of a NIC session
+ *
+ * The client requests features at session-creation time, and the server
+ * enables the subset it supports. An enabled feature applies to both
+ * directions. If any feature is enabled, each packet starts with an
+ * 'Offload_header' followed by the Ethernet frame.
+ */
+struct Nic::Offload
+{
+	bool checksum { false };  /* TCP/UDP checksum may be left partial */
+	bool tso      { false };  /* TCP/IPv4 frames may exceed the MTU */
+
+	bool any() const { return checksum || tso; }
+
+	Offload operator & (Offload const &other) const
+	{
+		Offload result;
+		result.checksum = checksum && other.checksum;
+		result.tso      = tso      && other.tso;
+		return result;
+	}
+
+	void print(Genode::Output &out) const
+	{
+		Genode::print(out, "checksum=", checksum, " tso=", tso);
+	}
+};
+
+
+/**
+ * Per-packet offload information
+ *
+ * The layout corresponds to the virtio-net header, which lets drivers pass
+ * the header unmodified to and from devices that use this format, e.g., a
+ * Linux TAP device opened with 'IFF_VNET_HDR'. All values are stored in
+ * host byte order.
+ *
+ * A frame with a partial checksum carries the checksum of the pseudo
+ * header in its checksum field. The receiver completes the checksum over
+ * the data from 'csum_start' to the end of the frame and stores it at
+ * 'csum_start + csum_offset'.
+ *
+ * A TCP super frame carries a payload of more than 'gso_size' bytes. The
+ * receiver splits the payload into segments of at most 'gso_size' bytes,
+ * each preceded by a copy of the adapted headers.
+ */
+struct Nic::Offload_header
+{
+	enum Flags    : Genode::uint8_t { NEEDS_CSUM = 1, DATA_VALID = 2 };
+	enum Gso_type : Genode::uint8_t { GSO_NONE = 0, GSO_TCPV4 = 1 };
+
+	Genode::uint8_t  flags       { 0 };
+	Genode::uint8_t  gso_type    { GSO_NONE };
+	Genode::uint16_t hdr_len     { 0 };  /* size of all headers of a super frame */
+	Genode::uint16_t gso_size    { 0 };  /* maximum payload size of a segment */
+	Genode::uint16_t csum_start  { 0 };  /* start of checksummed data */
+	Genode::uint16_t csum_offset { 0 };  /* checksum field relative to 'csum_start' */
+
+	bool needs_checksum() const { return flags & NEEDS_CSUM; }
+	bool super_frame()    const { return gso_type != GSO_NONE; }
+
+	/**
+	 * Return true if the frame can be passed to a peer with 'offload'
+	 */
+	bool supported_by(Offload const &offload) const
+	{
+		return (!needs_checksum() || offload.checksum)
+		    && (!super_frame()    || offload.tso);
+	}
+
+} __attribute__((packed));
+
+
 /*
  * NIC session interface
  *
@@ -116,6 +192,11 @@ struct Nic::Session : Genode::Session
 	 */
 	virtual void link_state_sigh(Genode::Signal_context_capability sigh) = 0;
 
+	/**
+	 * Request offload features enabled for the session
+	 */
+	virtual Offload offload() { return Offload(); }
+
 	/*******************
 	 ** RPC interface **
 	 *******************/
@@ -126,9 +207,11 @@ struct Nic::Session : Genode::Session
 	GENODE_RPC(Rpc_link_state, bool, link_state);
 	GENODE_RPC(Rpc_link_state_sigh, void, link_state_sigh,
 	           Genode::Signal_context_capability);
+	GENODE_RPC(Rpc_offload, Offload, offload);
 
 	GENODE_RPC_INTERFACE(Rpc_mac_address, Rpc_link_state,
-	                     Rpc_link_state_sigh, Rpc_tx_cap, Rpc_rx_cap);
+	                     Rpc_link_state_sigh, Rpc_tx_cap, Rpc_rx_cap,
+	                     Rpc_offload);
 };
 
 #endif /* _INCLUDE__NIC_SESSION__NIC_SESSION_H_ */
@@ -75,9 +75,8 @@ struct Texture_painter
 		PT const mix_pixel(mix_color.r, mix_color.g, mix_color.b);
 
 		int i, j;
-		PT            const *s;
-		PT                  *d;
-		unsigned char const *a;
+		PT const *s;
+		PT       *d;
 
 		switch (mode) {
 
@@ -98,18 +97,13 @@ struct Texture_painter
 			 * Copy texture with alpha blending
 			 */
 			for (j = clipped.h(); j--; src += src_w, alpha += src_w, dst += dst_w)
-				for (i = clipped.w(), s = src, a = alpha, d = dst; i--; s++, d++, a++) {
-					unsigned char const alpha_value = *a;
-					if (__builtin_expect(alpha_value != 0, true))
-						*d = PT::mix(*d, *s, alpha_value + 1);
-				}
+				PT::mix_row(dst, src, alpha, clipped.w());
 			break;
 
 		case MIXED:
 
 			for (j = clipped.h(); j--; src += src_w, dst += dst_w)
-				for (i = clipped.w(), s = src, d = dst; i--; s++, d++)
-					*d = PT::avr(mix_pixel, *s);
+				PT::avr_row(dst, src, mix_pixel, clipped.w());
 			break;
 
 		case MASKED:
@@ -79,6 +79,7 @@
 #include <base/env.h>
 #include <base/signal.h>
 #include <base/allocator.h>
+#include <base/lock_guard.h>
 #include <dataspace/client.h>
 #include <util/string.h>
 #include <util/construct_at.h>
@@ -88,6 +89,7 @@ namespace Genode {
 	class Packet_descriptor;
 
 	template <typename, int> class Packet_descriptor_queue;
+	template <typename, int> class Packet_descriptor_spsc_queue;
 	template <typename>      class Packet_descriptor_transmitter;
 	template <typename>      class Packet_descriptor_receiver;
 
@@ -96,6 +98,9 @@ namespace Genode {
 	template <typename, unsigned, unsigned, typename>
 	struct Packet_stream_policy;
 
+	template <typename, unsigned, unsigned, typename>
+	struct Packet_stream_spsc_policy;
+
 	/**
 	 * Default configuration for packet-descriptor queues
 	 */
@@ -177,6 +182,12 @@ class Genode::Packet_descriptor_queue
 
 		typedef PACKET_DESCRIPTOR Packet_descriptor;
 
+		/**
+		 * Lock used by the transmitter and receiver to serialize local
+		 * accesses to the queue
+		 */
+		typedef Genode::Lock Lock;
+
 		enum Role { PRODUCER, CONSUMER };
 
 		/**
@@ -258,6 +269,155 @@ class Genode::Packet_descriptor_queue
 		unsigned slots_free() {
 			return ((_tail > _head) ? _tail - _head
 			                        : QUEUE_SIZE - _head + _tail) - 1; }
+
+		/**
+		 * Return number of packet descriptors stored in the queue
+		 */
+		unsigned slots_used() { return (_head + QUEUE_SIZE - _tail)%QUEUE_SIZE; }
+};
+
+
+/**
+ * Lock-free single-producer/single-consumer variant of the descriptor ring
+ *
+ * This class is private to the packet-stream interface.
+ *
+ * In contrast to 'Packet_descriptor_queue', the queue size must be a power
+ * of two, which allows the use of free-running head and tail counters that
+ * are merely masked when indexing the ring. Head and tail reside on distinct
+ * cache lines so that producer and consumer do not contend for the same line.
+ * The producer publishes a descriptor via a release store of the head and
+ * the consumer frees a slot via a release store of the tail.
+ *
+ * Because each side of the queue is driven by exactly one thread, no lock is
+ * taken by the transmitter and receiver. Hence, a packet stream using this
+ * queue must not be accessed by multiple threads of the same component
+ * concurrently.
+ */
+template <typename PACKET_DESCRIPTOR, int QUEUE_SIZE>
+class alignas(64) Genode::Packet_descriptor_spsc_queue
+{
+	private:
+
+		static_assert(QUEUE_SIZE > 1 && (QUEUE_SIZE & (QUEUE_SIZE - 1)) == 0,
+		              "SPSC queue size must be a power of two");
+
+		enum { CACHE_LINE = 64, MASK = QUEUE_SIZE - 1 };
+
+		/*
+		 * The anonymous struct is needed to skip the initialization of the
+		 * members, which are shared by both sides of the packet stream.
+		 */
+		struct
+		{
+			unsigned          _head;
+			char              _head_pad[CACHE_LINE - sizeof(unsigned)];
+			unsigned          _tail;
+			char              _tail_pad[CACHE_LINE - sizeof(unsigned)];
+			PACKET_DESCRIPTOR _queue[QUEUE_SIZE];
+		};
+
+		static unsigned _acquire(unsigned const &v) {
+			return __atomic_load_n(&v, __ATOMIC_ACQUIRE); }
+
+		static void _release(unsigned &v, unsigned value) {
+			__atomic_store_n(&v, value, __ATOMIC_RELEASE); }
+
+	public:
+
+		typedef PACKET_DESCRIPTOR Packet_descriptor;
+
+		/**
+		 * Each side of the queue is accessed by a single thread only
+		 */
+		struct Lock { void lock() { } void unlock() { } };
+
+		enum Role { PRODUCER, CONSUMER };
+
+		/**
+		 * Constructor
+		 *
+		 * \param role  role of the instance, only the members driven by
+		 *              the respective role are initialized
+		 */
+		Packet_descriptor_spsc_queue(Role role)
+		{
+			if (role == PRODUCER) {
+				Genode::memset(_queue, 0, sizeof(_queue));
+				_release(_head, 0);
+			} else
+				_release(_tail, 0);
+		}
+
+		/**
+		 * Place packet descriptor into queue
+		 *
+		 * \return true on success, or
+		 *         false if queue is full
+		 */
+		bool add(PACKET_DESCRIPTOR packet)
+		{
+			unsigned const head = _head;
+
+			if (head - _acquire(_tail) == QUEUE_SIZE)
+				return false;
+
+			_queue[head & MASK] = packet;
+			_release(_head, head + 1);
+			return true;
+		}
+
+		/**
+		 * Take packet descriptor from queue
+		 *
+		 * \return  packet descriptor
+		 */
+		PACKET_DESCRIPTOR get()
+		{
+			unsigned const tail = _tail;
+
+			PACKET_DESCRIPTOR packet = _queue[tail & MASK];
+			_release(_tail, tail + 1);
+			return packet;
+		}
+
+		/**
+		 * Return current packet descriptor
+		 */
+		PACKET_DESCRIPTOR peek() const
+		{
+			return _queue[_acquire(_tail) & MASK];
+		}
+
+		/**
+		 * Return true if packet-descriptor queue is empty
+		 */
+		bool empty() { return slots_used() == 0; }
+
+		/**
+		 * Return true if packet-descriptor queue is full
+		 */
+		bool full() { return slots_used() == QUEUE_SIZE; }
+
+		/**
+		 * Return true if a single element is stored in the queue
+		 */
+		bool single_element() { return slots_used() == 1; }
+
+		/**
+		 * Return true if a single slot is left to be put into the queue
+		 */
+		bool single_slot_free() { return slots_free() == 1; }
+
+		/**
+		 * Return number of slots left to be put into the queue
+		 */
+		unsigned slots_free() { return QUEUE_SIZE - slots_used(); }
+
+		/**
+		 * Return number of packet descriptors stored in the queue
+		 */
+		unsigned slots_used() const { return _acquire(_head) - _acquire(_tail); }
 };
 
 
@@ -279,9 +439,12 @@ class Genode::Packet_descriptor_transmitter
 		/* facility to send ready-to-receive signals */
 		Genode::Signal_transmitter         _rx_ready { };
 
-		Genode::Lock _tx_queue_lock { };
-		TX_QUEUE    *_tx_queue;
-		bool         _tx_wakeup_needed = false;
+		typedef typename TX_QUEUE::Lock      Queue_lock;
+		typedef Genode::Lock_guard<Queue_lock> Queue_lock_guard;
+
+		Queue_lock  _tx_queue_lock { };
+		TX_QUEUE   *_tx_queue;
+		bool        _tx_wakeup_needed = false;
 
 		/*
 		 * Noncopyable
@@ -289,6 +452,19 @@ class Genode::Packet_descriptor_transmitter
 		Packet_descriptor_transmitter(Packet_descriptor_transmitter const &);
 		Packet_descriptor_transmitter &operator = (Packet_descriptor_transmitter const &);
 
+		/**
+		 * Add packets to the tx queue until it is full
+		 *
+		 * \return number of added packets
+		 */
+		unsigned _add(typename TX_QUEUE::Packet_descriptor const *packets,
+		              unsigned count)
+		{
+			unsigned n = 0;
+			for (; n < count && _tx_queue->add(packets[n]); n++);
+			return n;
+		}
+
 	public:
 
 		/**
@@ -325,13 +501,13 @@ class Genode::Packet_descriptor_transmitter
 
 		bool ready_for_tx()
 		{
-			Genode::Lock::Guard lock_guard(_tx_queue_lock);
+			Queue_lock_guard lock_guard(_tx_queue_lock);
 			return !_tx_queue->full();
 		}
 
 		void tx(typename TX_QUEUE::Packet_descriptor packet)
 		{
-			Genode::Lock::Guard lock_guard(_tx_queue_lock);
+			Queue_lock_guard lock_guard(_tx_queue_lock);
 
 			do {
 				/* block for signal if tx queue is full */
@@ -352,7 +528,7 @@ class Genode::Packet_descriptor_transmitter
 
 		bool try_tx(typename TX_QUEUE::Packet_descriptor packet)
 		{
-			Genode::Lock::Guard lock_guard(_tx_queue_lock);
+			Queue_lock_guard lock_guard(_tx_queue_lock);
 
 			if (_tx_queue->full())
 				return false;
@@ -365,9 +541,61 @@ class Genode::Packet_descriptor_transmitter
 			return true;
 		}
 
+		/**
+		 * Put batch of packets into the tx queue, block if the queue is full
+		 *
+		 * The receiver is signalled at most once per chunk of packets that
+		 * fits into the queue, and only if the receiver may have observed
+		 * an empty queue meanwhile.
+		 */
+		void tx(typename TX_QUEUE::Packet_descriptor const *packets,
+		        unsigned count)
+		{
+			Queue_lock_guard lock_guard(_tx_queue_lock);
+
+			while (count) {
+
+				/* block for signal if tx queue is full */
+				if (_tx_queue->full())
+					_tx_ready.wait_for_signal();
+
+				unsigned const n = _add(packets, count);
+
+				if (n && _tx_queue->slots_used() <= n)
+					_rx_ready.submit();
+
+				packets += n;
+				count   -= n;
+			}
+		}
+
+		/**
+		 * Put as many packets of the batch as possible into the tx queue
+		 *
+		 * \return number of packets put into the queue
+		 *
+		 * The receiver is not signalled before the next call of 'tx_wakeup'.
+		 */
+		unsigned try_tx(typename TX_QUEUE::Packet_descriptor const *packets,
+		                unsigned count)
+		{
+			Queue_lock_guard lock_guard(_tx_queue_lock);
+
+			unsigned const n = _add(packets, count);
+
+			/*
+			 * If no more than the added packets are in the queue, the
+			 * receiver may have found the queue empty and must be woken up.
+			 */
+			if (n && _tx_queue->slots_used() <= n)
+				_tx_wakeup_needed = true;
+
+			return n;
+		}
+
 		bool tx_wakeup()
 		{
-			Genode::Lock::Guard lock_guard(_tx_queue_lock);
+			Queue_lock_guard lock_guard(_tx_queue_lock);
 
 			bool signal_submitted = false;
 
@@ -405,9 +633,12 @@ class Genode::Packet_descriptor_receiver
 		/* facility to send ready-to-transmit signals */
 		Genode::Signal_transmitter        _tx_ready { };
 
-		Genode::Lock mutable  _rx_queue_lock { };
-		RX_QUEUE             *_rx_queue;
-		bool                  _rx_wakeup_needed = false;
+		typedef typename RX_QUEUE::Lock      Queue_lock;
+		typedef Genode::Lock_guard<Queue_lock> Queue_lock_guard;
+
+		Queue_lock mutable  _rx_queue_lock { };
+		RX_QUEUE           *_rx_queue;
+		bool                _rx_wakeup_needed = false;
 
 		/*
 		 * Noncopyable
@@ -451,13 +682,13 @@ class Genode::Packet_descriptor_receiver
 
 		bool ready_for_rx()
 		{
-			Genode::Lock::Guard lock_guard(_rx_queue_lock);
+			Queue_lock_guard lock_guard(_rx_queue_lock);
 			return !_rx_queue->empty();
 		}
 
 		void rx(typename RX_QUEUE::Packet_descriptor *out_packet)
 		{
-			Genode::Lock::Guard lock_guard(_rx_queue_lock);
+			Queue_lock_guard lock_guard(_rx_queue_lock);
 
 			while (_rx_queue->empty())
 				_rx_ready.wait_for_signal();
@@ -470,7 +701,7 @@ class Genode::Packet_descriptor_receiver
 
 		typename RX_QUEUE::Packet_descriptor try_rx()
 		{
-			Genode::Lock::Guard lock_guard(_rx_queue_lock);
+			Queue_lock_guard lock_guard(_rx_queue_lock);
 
 			typename RX_QUEUE::Packet_descriptor packet { };
 
@@ -485,7 +716,7 @@ class Genode::Packet_descriptor_receiver
 
 		bool rx_wakeup()
 		{
-			Genode::Lock::Guard lock_guard(_rx_queue_lock);
+			Queue_lock_guard lock_guard(_rx_queue_lock);
 
 			bool signal_submitted = false;
 
@@ -501,7 +732,7 @@ class Genode::Packet_descriptor_receiver
 
 		typename RX_QUEUE::Packet_descriptor rx_peek() const
 		{
-			Genode::Lock::Guard lock_guard(_rx_queue_lock);
+			Queue_lock_guard lock_guard(_rx_queue_lock);
 			return _rx_queue->peek();
 		}
 };
@@ -646,6 +877,31 @@ struct Genode::Packet_stream_policy
 };
 
 
+/**
+ * Policy using lock-free single-producer/single-consumer queues
+ *
+ * The policy is interchangeable with 'Packet_stream_policy' as long as each
+ * side of the packet stream is driven by a single thread. Both queue sizes
+ * must be powers of two.
+ */
+template <typename PACKET_DESCRIPTOR,
+          unsigned SUBMIT_QUEUE_SIZE,
+          unsigned ACK_QUEUE_SIZE,
+          typename CONTENT_TYPE>
+struct Genode::Packet_stream_spsc_policy
+{
+	typedef CONTENT_TYPE Content_type;
+
+	typedef PACKET_DESCRIPTOR Packet_descriptor;
+
+	typedef Packet_descriptor_spsc_queue<PACKET_DESCRIPTOR, SUBMIT_QUEUE_SIZE>
+	        Submit_queue;
+
+	typedef Packet_descriptor_spsc_queue<PACKET_DESCRIPTOR, ACK_QUEUE_SIZE>
+	        Ack_queue;
+};
+
+
 /**
  * Originator of a packet stream
  */
@@ -811,6 +1067,33 @@ class Genode::Packet_stream_source : private Packet_stream_base
 			return _submit_transmitter.try_tx(packet);
 		}
 
+		/**
+		 * Tell sink about a batch of packets to process
+		 *
+		 * This method blocks while the submit queue is full. In contrast to
+		 * calling 'submit_packet' for each packet, the sink is signalled at
+		 * most once per batch.
+		 */
+		void submit_packets(Packet_descriptor const *packets, unsigned count)
+		{
+			_submit_transmitter.tx(packets, count);
+		}
+
+		/**
+		 * Submit as many packets of the batch as possible
+		 *
+		 * \return number of submitted packets, which are the first
+		 *         packets of the batch
+		 *
+		 * This method never blocks. The sink gets signalled by a subsequent
+		 * call of 'wakeup'.
+		 */
+		unsigned try_submit_packets(Packet_descriptor const *packets,
+		                            unsigned count)
+		{
+			return _submit_transmitter.try_tx(packets, count);
+		}
+
 		/**
 		 * Wake up the packet sink if needed
 		 *
@@ -1035,6 +1318,32 @@ class Genode::Packet_stream_sink : private Packet_stream_base
 			return _ack_transmitter.try_tx(packet);
 		}
 
+		/**
+		 * Tell the source that the processing of a batch of packets is
+		 * completed
+		 *
+		 * This method blocks while the acknowledgement queue is full. The
+		 * source is signalled at most once per batch.
+		 */
+		void acknowledge_packets(Packet_descriptor const *packets, unsigned count)
+		{
+			_ack_transmitter.tx(packets, count);
+		}
+
+		/**
+		 * Acknowledge as many packets of the batch as possible
+		 *
+		 * \return number of acknowledged packets, which are the first
+		 *         packets of the batch
+		 *
+		 * This method never blocks. The source gets signalled by a
+		 * subsequent call of 'wakeup'.
+		 */
+		unsigned try_ack_packets(Packet_descriptor const *packets, unsigned count)
+		{
+			return _ack_transmitter.try_tx(packets, count);
+		}
+
 		void debug_print_buffers() {
 			Packet_stream_base::_debug_print_buffers(); }
 
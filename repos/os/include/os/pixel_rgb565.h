@@ -56,6 +56,71 @@ namespace Genode {
 		res.pixel = blend(p1, 264 - alpha).pixel + blend(p2, alpha).pixel;
 		return res;
 	}
+
+
+	template <>
+	inline void Pixel_rgb565::mix_row(Pixel_rgb565 *dst, Pixel_rgb565 const *src,
+	                                  unsigned char const *alpha, unsigned num)
+	{
+		using namespace Pixel_row;
+
+		enum { LANES = VECTOR_BYTES / sizeof(uint32_t) };
+
+		for (; num >= LANES; num -= LANES, dst += LANES, src += LANES, alpha += LANES) {
+
+			/* skip fully transparent parts of the texture */
+			unsigned any_alpha = 0;
+			for (unsigned i = 0; i < LANES; i++)
+				any_alpha |= alpha[i];
+			if (!any_alpha)
+				continue;
+
+			Vector_u32 a, d, s;
+			for (unsigned i = 0; i < LANES; i++) {
+				a[i] = alpha[i];
+				d[i] = dst[i].pixel;
+				s[i] = src[i].pixel;
+			}
+
+			/* same arithmetics as 'mix' with 'blend' applied per lane */
+			Vector_u32 const a_s = a + 1;
+			Vector_u32 const a_d = 264 - a_s;
+
+			Vector_u32 const blend_d = ((((a_d >> 3) * (d & 0xf81f)) >> 5) & 0xf81f)
+			                         | ((( a_d       * (d & 0x07c0)) >> 8) & 0x07c0);
+			Vector_u32 const blend_s = ((((a_s >> 3) * (s & 0xf81f)) >> 5) & 0xf81f)
+			                         | ((( a_s       * (s & 0x07c0)) >> 8) & 0x07c0);
+
+			Vector_u32 const keep = (Vector_u32)(a == 0);
+			Vector_u32 const res  = (d & keep) | (((blend_d + blend_s) & 0xffff) & ~keep);
+
+			for (unsigned i = 0; i < LANES; i++)
+				dst[i].pixel = (unsigned short)res[i];
+		}
+
+		for (; num--; dst++, src++, alpha++)
+			if (*alpha) *dst = mix(*dst, *src, *alpha + 1);
+	}
+
+
+	template <>
+	inline void Pixel_rgb565::avr_row(Pixel_rgb565 *dst, Pixel_rgb565 const *src,
+	                                  Pixel_rgb565 mix_pixel, unsigned num)
+	{
+		using namespace Pixel_row;
+
+		enum { LANES = VECTOR_BYTES / sizeof(uint16_t) };
+
+		uint16_t const m = (mix_pixel.pixel & 0xf7df) >> 1;
+
+		for (; num >= LANES; num -= LANES, dst += LANES, src += LANES) {
+			Vector_u16 const s = *(Unaligned_vector_u16 const *)src;
+			*(Unaligned_vector_u16 *)dst = ((s & 0xf7df) >> 1) + m;
+		}
+
+		for (; num--; dst++, src++)
+			*dst = avr(mix_pixel, *src);
+	}
 }
 
 #endif /* _INCLUDE__OS__PIXEL_RGB565_H_ */
@@ -22,6 +22,15 @@ namespace Genode {
 	                  0xff0000, 16, 0xff00, 8, 0xff, 0, 0, 0>
 	        Pixel_rgb888;
 
+	template <>
+	inline Pixel_rgb888 Pixel_rgb888::avr(Pixel_rgb888 p1, Pixel_rgb888 p2)
+	{
+		Pixel_rgb888 res;
+		res.pixel = ((p1.pixel&0xfefefe)>>1) + ((p2.pixel&0xfefefe)>>1);
+		return res;
+	}
+
+
 	template <>
 	inline Pixel_rgb888 Pixel_rgb888::blend(Pixel_rgb888 src, int alpha)
 	{
@@ -40,6 +49,69 @@ namespace Genode {
 		res.pixel = blend(p1, 255 - alpha).pixel + blend(p2, alpha).pixel;
 		return res;
 	}
+
+
+	template <>
+	inline void Pixel_rgb888::mix_row(Pixel_rgb888 *dst, Pixel_rgb888 const *src,
+	                                  unsigned char const *alpha, unsigned num)
+	{
+		using namespace Pixel_row;
+
+		enum { LANES = VECTOR_BYTES / sizeof(uint32_t) };
+
+		for (; num >= LANES; num -= LANES, dst += LANES, src += LANES, alpha += LANES) {
+
+			/* skip fully transparent parts of the texture */
+			unsigned any_alpha = 0;
+			for (unsigned i = 0; i < LANES; i++)
+				any_alpha |= alpha[i];
+			if (!any_alpha)
+				continue;
+
+			Vector_u32 a;
+			for (unsigned i = 0; i < LANES; i++)
+				a[i] = alpha[i];
+
+			Vector_u32 const d = *(Unaligned_vector_u32 const *)dst;
+			Vector_u32 const s = *(Unaligned_vector_u32 const *)src;
+
+			/* same arithmetics as 'mix' with 'blend' applied per lane */
+			Vector_u32 const a_s = a + 1;
+			Vector_u32 const a_d = 255 - a_s;
+
+			Vector_u32 const blend_d = ((a_d * ((d & 0xff00) >> 8)) & 0xff00)
+			                         | (((a_d * (d & 0xff00ff)) >> 8) & 0xff00ff);
+			Vector_u32 const blend_s = ((a_s * ((s & 0xff00) >> 8)) & 0xff00)
+			                         | (((a_s * (s & 0xff00ff)) >> 8) & 0xff00ff);
+
+			Vector_u32 const keep = (Vector_u32)(a == 0);
+
+			*(Unaligned_vector_u32 *)dst = (d & keep) | ((blend_d + blend_s) & ~keep);
+		}
+
+		for (; num--; dst++, src++, alpha++)
+			if (*alpha) *dst = mix(*dst, *src, *alpha + 1);
+	}
+
+
+	template <>
+	inline void Pixel_rgb888::avr_row(Pixel_rgb888 *dst, Pixel_rgb888 const *src,
+	                                  Pixel_rgb888 mix_pixel, unsigned num)
+	{
+		using namespace Pixel_row;
+
+		enum { LANES = VECTOR_BYTES / sizeof(uint32_t) };
+
+		uint32_t const m = (mix_pixel.pixel & 0xfefefe) >> 1;
+
+		for (; num >= LANES; num -= LANES, dst += LANES, src += LANES) {
+			Vector_u32 const s = *(Unaligned_vector_u32 const *)src;
+			*(Unaligned_vector_u32 *)dst = ((s & 0xfefefe) >> 1) + m;
+		}
+
+		for (; num--; dst++, src++)
+			*dst = avr(mix_pixel, *src);
+	}
 }
 
 #endif /* _INCLUDE__OS__PIXEL_RGB888_H_ */
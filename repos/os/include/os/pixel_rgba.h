@@ -23,6 +23,29 @@ namespace Genode {
 	          int B_MASK, int B_SHIFT,
 	          int A_MASK, int A_SHIFT>
 	class Pixel_rgba;
+
+	namespace Pixel_row {
+
+		/*
+		 * Number of bytes processed at once by the row operations of the
+		 * pixel types. The compiler translates the generic vector types to
+		 * the vector unit of the target, i.e., SSE2 or AVX2 on x86 and NEON
+		 * on ARM, or to scalar code if the target has no vector unit.
+		 */
+#if defined(__AVX2__)
+		enum { VECTOR_BYTES = 32 };
+#else
+		enum { VECTOR_BYTES = 16 };
+#endif
+
+		typedef uint32_t Vector_u32 __attribute__((vector_size(VECTOR_BYTES)));
+		typedef uint16_t Vector_u16 __attribute__((vector_size(VECTOR_BYTES)));
+
+		typedef uint32_t Unaligned_vector_u32
+			__attribute__((vector_size(VECTOR_BYTES), aligned(1)));
+		typedef uint16_t Unaligned_vector_u16
+			__attribute__((vector_size(VECTOR_BYTES), aligned(1)));
+	}
 }
 
 
@@ -116,6 +139,29 @@ class Genode::Pixel_rgba
 		                             Pixel_rgba p3, Pixel_rgba p4) {
 			return avr(avr(p1, p2), avr(p3, p4)); }
 
+		/**
+		 * Mix row of pixels with texture pixels according to alpha values
+		 *
+		 * A pixel with an alpha value of zero stays untouched. Any other
+		 * alpha value 'a' is applied as 'mix(dst, src, a + 1)'.
+		 */
+		static inline void mix_row(Pixel_rgba *dst, Pixel_rgba const *src,
+		                           unsigned char const *alpha, unsigned num)
+		{
+			for (; num--; dst++, src++, alpha++)
+				if (*alpha) *dst = mix(*dst, *src, *alpha + 1);
+		}
+
+		/**
+		 * Replace row of pixels by average of texture pixels and 'mix_pixel'
+		 */
+		static inline void avr_row(Pixel_rgba *dst, Pixel_rgba const *src,
+		                           Pixel_rgba mix_pixel, unsigned num)
+		{
+			for (; num--; dst++, src++)
+				*dst = avr(mix_pixel, *src);
+		}
+
 		/**
 		 * Copy pixel with alpha
 		 *
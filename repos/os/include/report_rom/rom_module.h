@@ -18,6 +18,8 @@
 #include <util/reconstructible.h>
 #include <os/session_policy.h>
 #include <base/attached_ram_dataspace.h>
+#include <region_map/client.h>
+#include <rm_session/rm_session.h>
 
 namespace Rom {
 	using Genode::size_t;
@@ -57,6 +59,79 @@ struct Rom::Reader : private Reader_list::Element, Interface
 };
 
 
+/**
+ * Buffer holding one version of the content of a ROM module
+ *
+ * In shared-buffer mode, the buffer is handed out to all ROM clients that
+ * read the version. The buffer is not modified while it is acquired by any
+ * reader. Because core hands out RAM dataspaces writeable only, the clients
+ * obtain a managed dataspace that contains the RAM dataspace read-only.
+ */
+class Rom::Buffer : Genode::Noncopyable
+{
+	private:
+
+		friend class Module;
+
+		Attached_ram_dataspace _ds;
+
+		Genode::Rm_session &_rm_session;
+
+		/* read-only view on '_ds' handed out to the readers */
+		Genode::Region_map_client _ro_view {
+			_rm_session.create(Genode::align_addr(_ds.size(), 12)) };
+
+		Genode::Dataspace_capability const _ro_ds { _ro_view.dataspace() };
+
+		/* content size, all bytes after the content are zero */
+		size_t _size = 0;
+
+		unsigned long _version = 0;
+
+		/* number of readers that acquired the buffer */
+		unsigned _users = 0;
+
+		size_t _capacity() const { return _ds.size(); }
+
+		void _write(char const * const src, size_t const src_len,
+		            unsigned long const version)
+		{
+			char * const dst = _ds.local_addr<char>();
+
+			Genode::memcpy(dst, src, src_len);
+
+			/* clear remainder of the previous content */
+			if (_size > src_len)
+				Genode::memset(dst + src_len, 0, _size - src_len);
+
+			/* zero termination, see 'Module::write_content' */
+			dst[src_len] = 0;
+
+			_size    = src_len;
+			_version = version;
+		}
+
+	public:
+
+		Buffer(Genode::Ram_allocator &ram, Genode::Region_map &rm,
+		       Genode::Rm_session &rm_session, size_t capacity)
+		:
+			_ds(ram, rm, capacity), _rm_session(rm_session)
+		{
+			_ro_view.attach(_ds.cap(), 0, 0, true, (Genode::addr_t)0,
+			                false /* executable */, false /* writeable */);
+		}
+
+		~Buffer() { _rm_session.destroy(_ro_view.rpc_cap()); }
+
+		Genode::Dataspace_capability cap() const { return _ro_ds; }
+
+		size_t size() const { return _size; }
+
+		unsigned long version() const { return _version; }
+};
+
+
 struct Rom::Readable_module : Interface
 {
 	/**
@@ -75,6 +150,18 @@ struct Rom::Readable_module : Interface
 	                            size_t dst_len) const = 0;
 
 	virtual size_t size() const = 0;
+
+	/**
+	 * Acquire buffer of the current content, shared among readers
+	 *
+	 * \return  nullptr if the module does not use shared buffers or the
+	 *          reader is not permitted to read the content
+	 *
+	 * Each acquired buffer must be released via 'release_buffer'.
+	 */
+	virtual Buffer const *acquire_buffer(Reader const &reader) const = 0;
+
+	virtual void release_buffer(Buffer const &buffer) const = 0;
 };
 
 
@@ -139,6 +226,9 @@ struct Rom::Module : private Module_list::Element, Readable_module
 		Genode::Ram_allocator &_ram;
 		Genode::Region_map    &_rm;
 
+		/* used for the read-only views of shared buffers */
+		Genode::Rm_session *_rm_session;
+
 		Read_policy  const &_read_policy;
 		Write_policy const &_write_policy;
 
@@ -164,6 +254,126 @@ struct Rom::Module : private Module_list::Element, Readable_module
 		 */
 		size_t _size = 0;
 
+		unsigned long _version = 0;
+
+		/*
+		 * Buffers of the shared-buffer mode
+		 *
+		 * Each update is written to a buffer that is neither current nor
+		 * acquired by any reader, which makes the update visible to the
+		 * readers without copying the content for each reader. Up to
+		 * '_num_buffers' buffers are kept. Additional buffers are allocated
+		 * while readers hold on to outdated versions.
+		 */
+		enum { MAX_BUFFERS = 8 };
+
+		Constructible<Buffer> mutable _buffers[MAX_BUFFERS] { };
+
+		unsigned const _num_buffers;
+
+		/* set if the platform cannot provide read-only views of buffers */
+		bool _shared_unsupported = false;
+
+		/* buffer of the current content, or nullptr if '_ds' is used */
+		Buffer *_current = nullptr;
+
+		char const *_content() const
+		{
+			return _current ? _current->_ds.local_addr<char const>()
+			                : _ds->local_addr<char const>();
+		}
+
+		/**
+		 * Return buffer that can be written, or nullptr if all are acquired
+		 */
+		Buffer *_spare_buffer(size_t const capacity)
+		{
+			Constructible<Buffer> *unused = nullptr;
+
+			for (Constructible<Buffer> &buffer : _buffers) {
+
+				if (!buffer.constructed()) {
+					unused = unused ? unused : &buffer;
+					continue;
+				}
+
+				if (&*buffer == _current || buffer->_users)
+					continue;
+
+				if (buffer->_capacity() < capacity)
+					return _construct_buffer(buffer, capacity);
+
+				return &*buffer;
+			}
+
+			if (!unused)
+				return nullptr;
+
+			return _construct_buffer(*unused, capacity);
+		}
+
+		/**
+		 * Construct buffer, disable shared buffers if they are unsupported
+		 *
+		 * Some platforms, e.g., base-linux, do not support managed
+		 * dataspaces. There, the read-only view of a buffer has no valid
+		 * dataspace and the module falls back to copying the content for
+		 * each reader.
+		 */
+		Buffer *_construct_buffer(Constructible<Buffer> &buffer, size_t const capacity)
+		{
+			buffer.construct(_ram, _rm, *_rm_session, capacity);
+
+			if (buffer->cap().valid())
+				return &*buffer;
+
+			Genode::error("read-only views of shared buffers are unsupported, "
+			              "falling back to per-client copies of '", _name, "'");
+			buffer.destruct();
+			_shared_unsupported = true;
+			return nullptr;
+		}
+
+		/**
+		 * Release buffers that exceed '_num_buffers' and are no longer used
+		 */
+		void _release_surplus_buffers() const
+		{
+			unsigned count = 0;
+			for (Constructible<Buffer> const &buffer : _buffers)
+				count += buffer.constructed();
+
+			for (Constructible<Buffer> &buffer : _buffers) {
+
+				if (count <= _num_buffers)
+					return;
+
+				if (!buffer.constructed() || &*buffer == _current || buffer->_users)
+					continue;
+
+				buffer.destruct();
+				count--;
+			}
+		}
+
+		/**
+		 * Write content to a spare buffer and make it the current one
+		 *
+		 * \return  false if no spare buffer is available
+		 */
+		bool _write_shared(char const * const src, size_t const src_len)
+		{
+			Buffer * const buffer = _spare_buffer(src_len + 1);
+			if (!buffer)
+				return false;
+
+			buffer->_write(src, src_len, _version);
+
+			_current = buffer;
+			_release_surplus_buffers();
+			return true;
+		}
+
 
 		/********************************
 		 ** Interface used by registry **
@@ -182,15 +392,22 @@ struct Rom::Module : private Module_list::Element, Readable_module
 		 *                      time when the module content is obtained
 		 * \param write_policy  policy hook function that is evaluated each
 		 *                      time when the module content is changed
+		 * \param rm_session    RM session for creating the read-only views
+		 *                      of shared buffers, nullptr to disable them
+		 * \param num_buffers   number of buffers shared among the readers,
+		 *                      0 to copy the content for each reader
 		 */
 		Module(Genode::Ram_allocator &ram,
 		       Genode::Region_map    &rm,
 		       Name            const &name,
 		       Read_policy     const &read_policy,
-		       Write_policy    const &write_policy)
+		       Write_policy    const &write_policy,
+		       Genode::Rm_session    *rm_session  = nullptr,
+		       unsigned               num_buffers = 0)
 		:
-			_name(name), _ram(ram), _rm(rm),
-			_read_policy(read_policy), _write_policy(write_policy)
+			_name(name), _ram(ram), _rm(rm), _rm_session(rm_session),
+			_read_policy(read_policy), _write_policy(write_policy),
+			_num_buffers(rm_session ? Genode::min(num_buffers, (unsigned)MAX_BUFFERS) : 0)
 		{ }
 
 
@@ -222,7 +439,17 @@ struct Rom::Module : private Module_list::Element, Readable_module
 
 			/* clear content if its origin disappears */
 			if (_last_writer == &writer) {
-				Genode::memset(_ds->local_addr<char>(), 0, _size);
+
+				if (_ds.constructed())
+					Genode::memset(_ds->local_addr<char>(), 0, _size);
+
+				/* provide the empty content as new version to shared-buffer readers */
+				if (_current) {
+					_version++;
+					if (!_write_shared("", 0))
+						_current = nullptr;
+				}
+
 				_size = 0;
 				_last_writer = nullptr;
 			}
@@ -244,6 +471,20 @@ struct Rom::Module : private Module_list::Element, Readable_module
 			return cnt;
 		}
 
+		/**
+		 * Notify ROM clients that access the module
+		 */
+		void _notify_readers()
+		{
+			for (Reader *r = _readers.first(); r; r = r->next()) {
+
+				if (_read_policy.read_permitted(*this, *_last_writer, *r))
+					r->notify_module_changed();
+				else
+					r->notify_module_invalidated();
+			}
+		}
+
 	public:
 
 		/**
@@ -260,6 +501,21 @@ struct Rom::Module : private Module_list::Element, Readable_module
 
 			_last_writer = &writer;
 
+			_version++;
+
+			/*
+			 * Write content to a spare shared buffer if possible. If all
+			 * buffers are acquired by readers, fall back to the backing
+			 * store that is copied to each reader.
+			 */
+			if (_num_buffers && !_shared_unsupported && _write_shared(src, src_len)) {
+				_size = src_len;
+				_notify_readers();
+				return;
+			}
+
+			_current = nullptr;
+
 			/*
 			 * Realloc backing store if needed
 			 *
@@ -277,14 +533,7 @@ struct Rom::Module : private Module_list::Element, Readable_module
 			/* append zero termination */
 			_ds->local_addr<char>()[src_len] = 0;
 
-			/* notify ROM clients that access the module */
-			for (Reader *r = _readers.first(); r; r = r->next()) {
-
-				if (_read_policy.read_permitted(*this, *_last_writer, *r))
-					r->notify_module_changed();
-				else
-					r->notify_module_invalidated();
-			}
+			_notify_readers();
 		}
 
 		/**
@@ -292,7 +541,7 @@ struct Rom::Module : private Module_list::Element, Readable_module
 		 */
 		size_t read_content(Reader const &reader, char *dst, size_t dst_len) const override
 		{
-			if (!_ds.constructed() || !_last_writer)
+			if ((!_ds.constructed() && !_current) || !_last_writer)
 				return 0;
 
 			if (!_read_policy.read_permitted(*this, *_last_writer, reader))
@@ -301,12 +550,40 @@ struct Rom::Module : private Module_list::Element, Readable_module
 			if (dst_len < _size)
 				throw Buffer_too_small();
 
-			Genode::memcpy(dst, _ds->local_addr<char>(), _size);
+			Genode::memcpy(dst, _content(), _size);
 			return _size;
 		}
 
 		virtual size_t size() const override { return _size; }
 
+		/**
+		 * Readable_module interface
+		 */
+		Buffer const *acquire_buffer(Reader const &reader) const override
+		{
+			if (!_current)
+				return nullptr;
+
+			/* an empty buffer without writer reveals no content */
+			if (_last_writer && !_read_policy.read_permitted(*this, *_last_writer, reader))
+				return nullptr;
+
+			_current->_users++;
+			return _current;
+		}
+
+		/**
+		 * Readable_module interface
+		 */
+		void release_buffer(Buffer const &buffer) const override
+		{
+			for (Constructible<Buffer> &b : _buffers)
+				if (b.constructed() && &*b == &buffer && b->_users)
+					b->_users--;
+
+			_release_surplus_buffers();
+		}
+
 		Name name() const { return _name; }
 };
 
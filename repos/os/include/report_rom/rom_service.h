@@ -53,6 +53,17 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 
 		Constructible<Genode::Attached_ram_dataspace> _ds { };
 
+		/* buffer shared with other readers, used instead of '_ds' */
+		Buffer const *_buffer = nullptr;
+
+		void _release_buffer()
+		{
+			if (_buffer)
+				_module.release_buffer(*_buffer);
+
+			_buffer = nullptr;
+		}
+
 		size_t _content_size = 0;
 
 		/**
@@ -69,6 +80,12 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 				Genode::Signal_transmitter(_sigh).submit();
 		}
 
+		/*
+		 * Noncopyable
+		 */
+		Session_component(Session_component const &);
+		Session_component &operator = (Session_component const &);
+
 	public:
 
 		Session_component(Genode::Ram_allocator &ram, Genode::Region_map &rm,
@@ -81,6 +98,7 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 
 		~Session_component()
 		{
+			_release_buffer();
 			_registry.release(*this, _module);
 		}
 
@@ -90,6 +108,17 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 		{
 			using namespace Genode;
 
+				_release_buffer();
+
+				/* hand out the module's shared buffer if possible */
+				_buffer = _module.acquire_buffer(*this);
+				if (_buffer) {
+					_ds.destruct();
+					_content_size = _buffer->size();
+					_valid        = _content_size > 0;
+					return static_cap_cast<Rom_dataspace>(_buffer->cap());
+				}
+
 				/* replace dataspace by new one */
 				/* XXX we could keep the old dataspace if the size fits */
 				_ds.construct(_ram, _rm, _module.size());
@@ -107,6 +136,21 @@ class Rom::Session_component : public Genode::Rpc_object<Genode::Rom_session>,
 
 		bool update() override
 		{
+			/*
+			 * Shared buffers are never modified while acquired. The client
+			 * must request the dataspace of a new buffer unless the current
+			 * buffer still has the latest version.
+			 */
+			if (Buffer const * const buffer = _module.acquire_buffer(*this)) {
+				bool const unchanged = _buffer && (buffer->version() == _buffer->version());
+				_module.release_buffer(*buffer);
+				return unchanged;
+			}
+
+			/* module fell back to copying the content */
+			if (_buffer)
+				return false;
+
 			if (!_ds.constructed() || _module.size() > _ds->size())
 				return false;
 
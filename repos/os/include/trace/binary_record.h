@@ -0,0 +1,124 @@
+/*
+ * \brief  Binary record of a trace event
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * Binary records are written by the 'binary' trace policy and decoded by
+ * the trace consumer, e.g., the trace logger. In contrast to policies that
+ * format events as text, the traced thread merely stores a timestamp, the
+ * event type, and the name of the RPC function.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _INCLUDE__TRACE__BINARY_RECORD_H_
+#define _INCLUDE__TRACE__BINARY_RECORD_H_
+
+#include <util/string.h>
+#include <trace/timestamp.h>
+
+namespace Genode { namespace Trace { struct Binary_record; } }
+
+
+struct Genode::Trace::Binary_record
+{
+	enum Type : uint16_t {
+		INVALID,
+		RPC_CALL, RPC_RETURNED, RPC_DISPATCH, RPC_REPLY,
+		SIGNAL_SUBMIT, SIGNAL_RECEIVED,
+		MAX_TYPE = SIGNAL_RECEIVED
+	};
+
+	enum {
+		MAGIC        = 0xb1e7,
+		MAX_NAME_LEN = 40,
+
+		/* keep records within the trace buffer naturally aligned */
+		ALIGN = 8,
+	};
+
+	uint64_t timestamp;  /* value of 'Trace::timestamp' */
+	uint16_t magic;
+	uint16_t type;
+	uint32_t value;      /* number of signals, 0 for RPC events */
+
+	/*
+	 * The header is followed by the name of the RPC function, which is
+	 * truncated to 'MAX_NAME_LEN' and zero-padded to the record alignment.
+	 */
+
+	static constexpr size_t max_size()
+	{
+		return sizeof(Binary_record) + MAX_NAME_LEN;
+	}
+
+	/**
+	 * Write record to 'dst'
+	 *
+	 * \param dst  destination with a capacity of at least 'max_size()'
+	 * \param name name of the RPC function, or nullptr
+	 *
+	 * \return  size of the record in bytes
+	 */
+	static size_t write(char *dst, Type type, uint32_t value, char const *name)
+	{
+		Binary_record record;
+		record.timestamp = Trace::timestamp();
+		record.magic     = MAGIC;
+		record.type      = type;
+		record.value     = value;
+
+		/* the trace buffer does not guarantee the alignment of 'dst' */
+		memcpy(dst, &record, sizeof(record));
+
+		char * const dst_name = dst + sizeof(Binary_record);
+
+		size_t len = 0;
+		for (; name && len < MAX_NAME_LEN && name[len]; len++)
+			dst_name[len] = name[len];
+
+		size_t const size = (sizeof(Binary_record) + len + ALIGN - 1) & ~(ALIGN - 1);
+
+		for (; sizeof(Binary_record) + len < size; len++)
+			dst_name[len] = 0;
+
+		return size;
+	}
+
+	/**
+	 * Call 'fn' with the record contained in a trace-buffer entry
+	 *
+	 * The functor is called with the record, the name, and the length of
+	 * the name. Entries that do not contain a valid record are skipped.
+	 *
+	 * \return  true if the entry contained a valid record
+	 */
+	template <typename FN>
+	static bool with_record(char const *data, size_t len, FN const &fn)
+	{
+		if (len < sizeof(Binary_record))
+			return false;
+
+		/* copy header as the entry data is not guaranteed to be aligned */
+		Binary_record record;
+		memcpy(&record, data, sizeof(record));
+
+		if (record.magic != MAGIC || record.type == INVALID || record.type > MAX_TYPE)
+			return false;
+
+		char const * const name = data + sizeof(record);
+
+		size_t name_len = 0;
+		for (; name_len < len - sizeof(record) && name[name_len]; name_len++);
+
+		fn(record, name, name_len);
+		return true;
+	}
+};
+
+#endif /* _INCLUDE__TRACE__BINARY_RECORD_H_ */
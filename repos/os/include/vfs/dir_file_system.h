@@ -17,6 +17,7 @@
 #define _INCLUDE__VFS__DIR_FILE_SYSTEM_H_
 
 #include <base/registry.h>
+#include <util/avl_string.h>
 #include <vfs/file_system_factory.h>
 #include <vfs/vfs_handle.h>
 
@@ -57,6 +58,10 @@ class Vfs::Dir_file_system : public File_system
 			{
 				bool synced { false };
 
+				/* number of entries, cached while listing the directory */
+				file_size num_dirent       { 0 };
+				bool      num_dirent_valid { false };
+
 				Vfs_handle &vfs_handle;
 				Subdir_handle_element(Subdir_handle_registry &registry,
 				                      Vfs_handle &vfs_handle)
@@ -135,12 +140,116 @@ class Vfs::Dir_file_system : public File_system
 		};
 
 
+		/**
+		 * Ordered selection of child file systems
+		 */
+		class Fs_list
+		{
+			private:
+
+				/*
+				 * Noncopyable
+				 */
+				Fs_list(Fs_list const &);
+				Fs_list &operator = (Fs_list const &);
+
+				Genode::Allocator  &_alloc;
+				unsigned const      _capacity;
+				File_system **const _fs;
+				unsigned            _count = 0;
+
+			public:
+
+				Fs_list(Genode::Allocator &alloc, unsigned capacity)
+				:
+					_alloc(alloc), _capacity(Genode::max(capacity, 1U)),
+					_fs((File_system **)alloc.alloc(_capacity*sizeof(File_system *)))
+				{ }
+
+				~Fs_list() { _alloc.free(_fs, _capacity*sizeof(File_system *)); }
+
+				void append(File_system &fs)
+				{
+					if (_count < _capacity)
+						_fs[_count++] = &fs;
+				}
+
+				void append(Fs_list const &other)
+				{
+					for (unsigned i = 0; i < other._count; i++)
+						append(*other._fs[i]);
+				}
+
+				/**
+				 * Return file system at position 'i' or nullptr
+				 */
+				File_system *at(unsigned i) const {
+					return i < _count ? _fs[i] : nullptr; }
+		};
+
+		/**
+		 * Child file systems that may take paths starting with 'name'
+		 *
+		 * A '<dir>' child takes only paths whose first element equals its
+		 * name whereas any other child file system may take any path.
+		 * Hence, the entry lists the '<dir>' children of the given name
+		 * and all other children in their configured order.
+		 */
+		struct Dir_entry : Genode::Avl_string<MAX_NAME_LEN>,
+		                   Genode::List<Dir_entry>::Element
+		{
+			Fs_list fs;
+
+			Dir_entry(Genode::Allocator &alloc, char const *name, unsigned capacity)
+			: Genode::Avl_string<MAX_NAME_LEN>(name), fs(alloc, capacity) { }
+		};
+
 		/* pointer to first child file system */
 		File_system *_first_file_system = nullptr;
 
-		/* add new file system to the list of children */
-		void _append_file_system(File_system *fs)
+		/*
+		 * Index of the child file systems used to dispatch a path to the
+		 * children that may take it, instead of trying all of them
+		 */
+		Fs_list                                   _all_fs;
+		Fs_list                                   _other_fs;    /* all but '<dir>' */
+		Genode::Avl_tree<Genode::Avl_string_base> _dir_index  { };
+		Genode::List<Dir_entry>                   _dir_entries { };
+
+		/**
+		 * Add new file system to the list of children
+		 *
+		 * \param dir_name  name of '<dir>' child or nullptr for other
+		 *                  file systems
+		 */
+		void _append_file_system(File_system *fs, char const *dir_name,
+		                         unsigned capacity)
 		{
+			_all_fs.append(*fs);
+
+			/* a name spanning multiple path elements cannot be indexed */
+			for (char const *c = dir_name; c && *c; c++)
+				if (*c == '/')
+					dir_name = nullptr;
+
+			if (dir_name) {
+				Genode::Avl_string_base *node = _dir_index.first()
+				                              ? _dir_index.first()->find_by_name(dir_name)
+				                              : nullptr;
+				Dir_entry *entry = static_cast<Dir_entry *>(node);
+				if (!entry) {
+					entry = new (_env.alloc()) Dir_entry(_env.alloc(), dir_name, capacity);
+					entry->fs.append(_other_fs);
+					_dir_index.insert(entry);
+					_dir_entries.insert(entry);
+				}
+				entry->fs.append(*fs);
+			} else {
+				_other_fs.append(*fs);
+				for (Dir_entry *e = _dir_entries.first(); e; e = e->next())
+					e->fs.append(*fs);
+			}
+
 			if (!_first_file_system) {
 				_first_file_system = fs;
 				return;
@@ -153,6 +262,35 @@ class Vfs::Dir_file_system : public File_system
 			curr->next = fs;
 		}
 
+		/**
+		 * Return child file systems that may take the given sub path
+		 */
+		Fs_list const &_fs_for_path(char const *path)
+		{
+			if (path[0] == '/')
+				path++;
+
+			Genode::size_t len = 0;
+			while (path[len] && path[len] != '/')
+				len++;
+
+			/* the top directory is served by all children */
+			if (len == 0)
+				return _all_fs;
+
+			/* no '<dir>' child can have a name of this length */
+			if (len >= MAX_NAME_LEN)
+				return _other_fs;
+
+			String<MAX_NAME_LEN> const name(Genode::Cstring(path, len));
+
+			Genode::Avl_string_base *node = _dir_index.first()
+			                              ? _dir_index.first()->find_by_name(name.string())
+			                              : nullptr;
+
+			return node ? static_cast<Dir_entry *>(node)->fs : _other_fs;
+		}
+
 		/**
 		 * Directory name
 		 */
@@ -209,7 +347,8 @@ class Vfs::Dir_file_system : public File_system
 			 * Propagate the request into all of our file systems. If at least
 			 * one operation succeeds, we return success.
 			 */
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+			Fs_list const &fs_list = _fs_for_path(path);
+			for (unsigned i = 0; File_system *fs = fs_list.at(i); i++) {
 
 				RES const err = fn(*fs, path);
 
@@ -268,7 +407,8 @@ class Vfs::Dir_file_system : public File_system
 		file_size _sum_dirents_of_file_systems(char const *path)
 		{
 			file_size cnt = 0;
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+			Fs_list const &fs_list = _fs_for_path(path);
+			for (unsigned i = 0; File_system *fs = fs_list.at(i); i++) {
 				cnt += fs->num_dirent(path);
 			}
 			return cnt;
@@ -290,8 +430,15 @@ class Vfs::Dir_file_system : public File_system
 			/* base of composite directory index */
 			int base = 0;
 
+			/*
+			 * Querying the number of entries of each file system for each
+			 * read would make the listing of a directory quadratic. Hence,
+			 * the numbers are cached at the handle and refreshed whenever
+			 * the listing (re-)starts at the first entry.
+			 */
+			bool const refresh = (index == 0);
+
 			auto f = [&] (Dir_vfs_handle::Subdir_handle_element &handle_element) {
-				if (dir_vfs_handle->queued_read_handle) return; /* skip through */
 
 				Vfs_handle &vfs_handle = handle_element.vfs_handle;
 
@@ -299,7 +446,14 @@ class Vfs::Dir_file_system : public File_system
 				 * Determine number of matching directory entries within
 				 * the current file system.
 				 */
-				int const fs_num_dirent = vfs_handle.ds().num_dirent(sub_path);
+				if (refresh || !handle_element.num_dirent_valid) {
+					handle_element.num_dirent = vfs_handle.ds().num_dirent(sub_path);
+					handle_element.num_dirent_valid = true;
+				}
+
+				if (dir_vfs_handle->queued_read_handle) return; /* skip through */
+
+				int const fs_num_dirent = (int)handle_element.num_dirent;
 
 				/*
 				 * Query directory entry if index lies with the file
@@ -371,18 +525,23 @@ class Vfs::Dir_file_system : public File_system
 		:
 			_env(env),
 			_vfs_root(!node.has_type("dir")),
+			_all_fs(env.alloc(), node.num_sub_nodes()),
+			_other_fs(env.alloc(), node.num_sub_nodes()),
 			_name(_vfs_root ? Name() : node.attribute_value("name", Name()))
 		{
 			using namespace Genode;
 
-			for (unsigned i = 0; i < node.num_sub_nodes(); i++) {
+			unsigned const num_sub_nodes = node.num_sub_nodes();
+
+			for (unsigned i = 0; i < num_sub_nodes; i++) {
 
 				Xml_node sub_node = node.sub_node(i);
 
 				/* traverse into <dir> nodes */
 				if (sub_node.has_type("dir")) {
-					_append_file_system(new (_env.alloc())
-						Dir_file_system(_env, sub_node, fs_factory));
+					Dir_file_system * const dir = new (_env.alloc())
+						Dir_file_system(_env, sub_node, fs_factory);
+					_append_file_system(dir, dir->_name.string(), num_sub_nodes);
 					continue;
 				}
 
@@ -390,7 +549,7 @@ class Vfs::Dir_file_system : public File_system
 					fs_factory.create(_env, sub_node);
 
 				if (fs) {
-					_append_file_system(fs);
+					_append_file_system(fs, nullptr, num_sub_nodes);
 					continue;
 				}
 
@@ -409,6 +568,14 @@ class Vfs::Dir_file_system : public File_system
 			}
 		}
 
+		~Dir_file_system()
+		{
+			while (Dir_entry *e = _dir_entries.first()) {
+				_dir_entries.remove(e);
+				destroy(_env.alloc(), e);
+			}
+		}
+
 		/*********************************
 		 ** Directory-service interface **
 		 *********************************/
@@ -423,8 +590,8 @@ class Vfs::Dir_file_system : public File_system
 			 * Query sub file systems for dataspace using the path local to
 			 * the respective file system
 			 */
-			File_system *fs = _first_file_system;
-			for (; fs; fs = fs->next) {
+			Fs_list const &fs_list = _fs_for_path(path);
+			for (unsigned i = 0; File_system *fs = fs_list.at(i); i++) {
 				Dataspace_capability ds = fs->dataspace(path);
 				if (ds.valid())
 					return ds;
@@ -439,7 +606,8 @@ class Vfs::Dir_file_system : public File_system
 			if (!path)
 				return;
 
-			for (File_system *fs = _first_file_system; fs; fs = fs->next)
+			Fs_list const &fs_list = _fs_for_path(path);
+			for (unsigned i = 0; File_system *fs = fs_list.at(i); i++)
 				fs->release(path, ds_cap);
 		}
 
@@ -469,7 +637,8 @@ class Vfs::Dir_file_system : public File_system
 			 * The given path refers to one of our sub directories.
 			 * Propagate the request into our file systems.
 			 */
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+			Fs_list const &fs_list = _fs_for_path(path);
+			for (unsigned i = 0; File_system *fs = fs_list.at(i); i++) {
 
 				Stat_result const err = fs->stat(path, out);
 
@@ -526,7 +695,8 @@ class Vfs::Dir_file_system : public File_system
 			if (strlen(path) == 0)
 				return true;
 
-			for (File_system *fs = _first_file_system; fs; fs = fs->next)
+			Fs_list const &fs_list = _fs_for_path(path);
+			for (unsigned i = 0; File_system *fs = fs_list.at(i); i++)
 				if (fs->directory(path))
 					return true;
 
@@ -542,7 +712,8 @@ class Vfs::Dir_file_system : public File_system
 			if (strlen(path) == 0)
 				return path;
 
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+			Fs_list const &fs_list = _fs_for_path(path);
+			for (unsigned i = 0; File_system *fs = fs_list.at(i); i++) {
 				char const *leaf_path = fs->leaf_path(path);
 				if (leaf_path)
 					return leaf_path;
@@ -593,7 +764,8 @@ class Vfs::Dir_file_system : public File_system
 			}
 
 			/* path refers to any of our sub file systems */
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+			Fs_list const &fs_list = _fs_for_path(path);
+			for (unsigned i = 0; File_system *fs = fs_list.at(i); i++) {
 
 				Open_result const err = fs->open(path, mode, out_handle, alloc);
 				switch (err) {
@@ -617,7 +789,8 @@ class Vfs::Dir_file_system : public File_system
 		{
 			Opendir_result res = OPENDIR_ERR_LOOKUP_FAILED;
 			try {
-				for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+				Fs_list const &fs_list = _fs_for_path(sub_path);
+				for (unsigned i = 0; File_system *fs = fs_list.at(i); i++) {
 					Vfs_handle *sub_dir_handle = nullptr;
 
 					Opendir_result r = fs->opendir(
@@ -764,7 +937,8 @@ class Vfs::Dir_file_system : public File_system
 			char const *sub_path = _sub_path(path);
 			if (!sub_path) return res;
 
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+			Fs_list const &fs_list = _fs_for_path(sub_path);
+			for (unsigned i = 0; File_system *fs = fs_list.at(i); i++) {
 				Vfs_watch_handle *sub_handle;
 
 				if (fs->watch(sub_path, &sub_handle, alloc) == WATCH_OK) {
@@ -825,7 +999,8 @@ class Vfs::Dir_file_system : public File_system
 				return RENAME_ERR_CROSS_FS;
 
 			Rename_result final = RENAME_ERR_NO_ENTRY;
-			for (File_system *fs = _first_file_system; fs; fs = fs->next) {
+			Fs_list const &fs_list = _fs_for_path(from_path);
+			for (unsigned i = 0; File_system *fs = fs_list.at(i); i++) {
 				switch (fs->rename(from_path, to_path)) {
 				case RENAME_OK:           return RENAME_OK;
 				case RENAME_ERR_NO_ENTRY: continue;
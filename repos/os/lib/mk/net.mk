@@ -1,4 +1,4 @@
 SRC_CC += ethernet.cc ipv4.cc dhcp.cc arp.cc udp.cc tcp.cc
-SRC_CC += icmp.cc internet_checksum.cc
+SRC_CC += icmp.cc internet_checksum.cc offload.cc
 
 vpath %.cc $(REP_DIR)/src/lib/net
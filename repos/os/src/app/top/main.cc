@@ -68,9 +68,6 @@ struct Trace_subject_registry
 			return nullptr;
 		}
 
-		enum { MAX_SUBJECTS = 1024 };
-		Genode::Trace::Subject_id _subjects[MAX_SUBJECTS];
-
 		enum { MAX_CPUS_X = 16, MAX_CPUS_Y = 1, MAX_ELEMENTS_PER_CPU = 6};
 
 		/* accumulated execution time on all CPUs */
@@ -82,14 +79,16 @@ struct Trace_subject_registry
 
 		bool _reconstruct_trace_connection = false;
 
+		template <typename FN>
 		unsigned update_subjects(Genode::Pd_session &pd,
-		                         Genode::Trace::Connection &trace)
+		                         Genode::Trace::Connection &trace,
+		                         FN const &fn)
 		{
 			Genode::Ram_quota ram_quota;
 
 			do {
 				try {
-					return trace.subjects(_subjects, MAX_SUBJECTS);
+					return trace.for_each_subject_info(fn);
 				} catch (Genode::Out_of_ram) {
 					trace.upgrade_ram(4096);
 				}
@@ -104,20 +103,14 @@ struct Trace_subject_registry
 
 	public:
 
+		enum { MAX_SUBJECTS = 1024 };
+
 		void update(Genode::Pd_session &pd, Genode::Trace::Connection &trace,
 		            Genode::Allocator &alloc)
 		{
-			unsigned const num_subjects = update_subjects(pd, trace);
-
-			if (num_subjects == MAX_SUBJECTS)
-				Genode::error("Not enough memory for all threads - "
-				              "calculated utilization is not sane nor "
-				              "complete !", num_subjects);
-
 			/* add and update existing entries */
-			for (unsigned i = 0; i < num_subjects; i++) {
-
-				Genode::Trace::Subject_id const id = _subjects[i];
+			auto update_entry = [&] (Genode::Trace::Subject_id   const  id,
+			                         Genode::Trace::Subject_info const &info) {
 
 				Entry *e = _lookup(id);
 				if (!e) {
@@ -125,7 +118,7 @@ struct Trace_subject_registry
 					_entries.insert(e);
 				}
 
-				e->update(trace.subject_info(id));
+				e->update(info);
 
 				/* remove dead threads which did not run in the last period */
 				if (e->info.state() == Genode::Trace::Subject_info::DEAD &&
@@ -135,7 +128,14 @@ struct Trace_subject_registry
 					_entries.remove(e);
 					Genode::destroy(alloc, e);
 				}
-			}
+			};
+
+			unsigned const num_subjects = update_subjects(pd, trace, update_entry);
+
+			if (num_subjects >= MAX_SUBJECTS)
+				Genode::error("Not enough memory for all threads - "
+				              "calculated utilization is not sane nor "
+				              "complete !", num_subjects);
 
 			if (_reconstruct_trace_connection)
 				throw Genode::Out_of_ram();
@@ -320,8 +320,10 @@ struct App::Main
 	Env &_env;
 
 	enum {
-		TRACE_RAM_QUOTA = 10 * 4096,
-		ARG_BUFFER_RAM  = 32 * 1024,
+		/* holds the information of all subjects */
+		ARG_BUFFER_RAM  = Trace_subject_registry::MAX_SUBJECTS *
+		                  (sizeof(Trace::Subject_info) + sizeof(Trace::Subject_id)),
+		TRACE_RAM_QUOTA = 10 * 4096 + ARG_BUFFER_RAM,
 		PARENT_LEVELS   = 0
 	};
 
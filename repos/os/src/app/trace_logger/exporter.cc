@@ -0,0 +1,224 @@
+/*
+ * \brief  Export of binary trace records to a file
+ * \author Genode Labs
+ * \date   2026-10-16
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* local includes */
+#include <exporter.h>
+
+using namespace Genode;
+
+
+namespace {
+
+	/**
+	 * Printable JSON string literal
+	 */
+	struct Json_string
+	{
+		char const * const str;
+		size_t       const len;
+
+		void print(Output &out) const
+		{
+			out.out_char('"');
+			for (size_t i = 0; i < len; i++) {
+
+				char const c = str[i];
+
+				if (c == '"' || c == '\\') {
+					out.out_char('\\');
+					out.out_char(c);
+				} else if ((unsigned char)c < 0x20) {
+					static char const digits[] = "0123456789abcdef";
+					out.out_string("\\u00");
+					out.out_char(digits[(c >> 4) & 0xf]);
+					out.out_char(digits[c & 0xf]);
+				} else {
+					out.out_char(c);
+				}
+			}
+			out.out_char('"');
+		}
+	};
+}
+
+
+Vfs::Vfs_handle &Exporter::_open()
+{
+	typedef Vfs::Directory_service Directory_service;
+	typedef Directory_service::Open_result Open_result;
+
+	Vfs::File_system &vfs = _vfs_env.root_dir();
+	Vfs::Vfs_handle  *handle = nullptr;
+
+	Open_result res = vfs.open(_path.base(), Directory_service::OPEN_MODE_WRONLY,
+	                           &handle, _vfs_env.alloc());
+
+	/* try to create file if not accessible */
+	if (res == Open_result::OPEN_ERR_UNACCESSIBLE)
+		res = vfs.open(_path.base(), Directory_service::OPEN_MODE_WRONLY |
+		                             Directory_service::OPEN_MODE_CREATE,
+		               &handle, _vfs_env.alloc());
+
+	if (res != Open_result::OPEN_OK) {
+		error("failed to open '", _path, "' res=", (int)res);
+		throw Open_failed();
+	}
+
+	/* discard the output of previous runs */
+	handle->fs().ftruncate(handle, 0);
+	return *handle;
+}
+
+
+void Exporter::_write_buffer()
+{
+	typedef Vfs::File_io_service::Write_result Write_result;
+
+	for (size_t written = 0; !_failed && written < _buf_used; ) {
+
+		Vfs::file_size n = 0;
+
+		_handle.seek(_offset);
+		Write_result const res =
+			_handle.fs().write(&_handle, _buf + written, _buf_used - written, n);
+
+		if (res == Write_result::WRITE_ERR_WOULD_BLOCK ||
+		    res == Write_result::WRITE_ERR_AGAIN) {
+			_env.ep().wait_and_dispatch_one_io_signal();
+			continue;
+		}
+
+		/* a successful write without progress would loop forever */
+		if (res != Write_result::WRITE_OK || n == 0) {
+			error("failed to write trace events to '", _path, "', stop export");
+			_failed = true;
+		}
+
+		_offset += n;
+		written += n;
+	}
+	_buf_used = 0;
+}
+
+
+void Exporter::_print_timestamp(Trace::Timestamp ts)
+{
+	uint64_t const ticks = ts > _ts_start ? ts - _ts_start : 0;
+	uint64_t const ns    = (ticks / _ticks_per_ms) * 1000*1000
+	                     + (ticks % _ticks_per_ms) * 1000*1000 / _ticks_per_ms;
+
+	/* microseconds with three decimal places */
+	unsigned const frac = (unsigned)(ns % 1000);
+	_print(ns / 1000, ".", frac / 100, (frac / 10) % 10, frac % 10);
+}
+
+
+Exporter::Exporter(Env &env, Allocator &alloc, Timer::Connection &timer,
+                   Xml_node vfs_config, Path const &path)
+:
+	_env(env), _timer(timer), _vfs_env(env, alloc, vfs_config), _path(path),
+	_handle(_open()), _ts_start(Trace::timestamp()),
+	_us_start(_timer.elapsed_us())
+{
+	/* the closing bracket of the array is optional */
+	_print("[\n");
+}
+
+
+Exporter::~Exporter()
+{
+	flush();
+	_handle.close();
+}
+
+
+void Exporter::process_name(unsigned pid, Session_label const &label)
+{
+	_print("{\"ph\":\"M\",\"pid\":", pid, ",\"name\":\"process_name\","
+	       "\"args\":{\"name\":", Json_string { label.string(), strlen(label.string()) },
+	       "}},\n");
+}
+
+
+void Exporter::thread_name(unsigned pid, unsigned tid, Thread_name const &name)
+{
+	_print("{\"ph\":\"M\",\"pid\":", pid, ",\"tid\":", tid, ",\"name\":\"thread_name\","
+	       "\"args\":{\"name\":", Json_string { name.string(), strlen(name.string()) },
+	       "}},\n");
+}
+
+
+void Exporter::record(unsigned pid, unsigned tid, Record const &record,
+                      char const *name, size_t name_len)
+{
+	_print("{\"pid\":", pid, ",\"tid\":", tid, ",\"ts\":");
+	_print_timestamp(record.timestamp);
+
+	auto print_rpc = [&] (char const *ph, char const *cat) {
+		_print(",\"ph\":\"", ph, "\",\"cat\":\"", cat, "\",\"name\":",
+		       Json_string { name, name_len }); };
+
+	auto print_signal = [&] (char const *event) {
+		_print(",\"ph\":\"i\",\"s\":\"t\",\"cat\":\"signal\",\"name\":\"", event,
+		       "\",\"args\":{\"num\":", record.value, "}"); };
+
+	switch (record.type) {
+	case Record::RPC_CALL:        print_rpc("B", "rpc");          break;
+	case Record::RPC_RETURNED:    print_rpc("E", "rpc");          break;
+	case Record::RPC_DISPATCH:    print_rpc("B", "rpc dispatch"); break;
+	case Record::RPC_REPLY:       print_rpc("E", "rpc dispatch"); break;
+	case Record::SIGNAL_SUBMIT:   print_signal("signal submit");   break;
+	case Record::SIGNAL_RECEIVED: print_signal("signal received"); break;
+	}
+	_print("},\n");
+}
+
+
+void Exporter::events_lost(unsigned pid, unsigned tid)
+{
+	_print("{\"pid\":", pid, ",\"tid\":", tid, ",\"ts\":");
+	_print_timestamp(Trace::timestamp());
+	_print(",\"ph\":\"i\",\"s\":\"t\",\"name\":\"events lost\"},\n");
+}
+
+
+void Exporter::calibrate()
+{
+	if (_calibrated)
+		return;
+
+	uint64_t         const us = _timer.elapsed_us();
+	Trace::Timestamp const ts = Trace::timestamp();
+
+	/* a short interval would yield an imprecise result */
+	if (us - _us_start < 1000 || ts <= _ts_start)
+		return;
+
+	_ticks_per_ms = max((uint64_t)1, (ts - _ts_start)*1000 / (us - _us_start));
+	_calibrated   = true;
+}
+
+
+void Exporter::flush()
+{
+	_write_buffer();
+
+	if (_failed)
+		return;
+
+	while (!_handle.fs().queue_sync(&_handle))
+		_env.ep().wait_and_dispatch_one_io_signal();
+
+	while (_handle.fs().complete_sync(&_handle) == Vfs::File_io_service::SYNC_QUEUED)
+		_env.ep().wait_and_dispatch_one_io_signal();
+}
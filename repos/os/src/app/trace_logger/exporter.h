@@ -0,0 +1,140 @@
+/*
+ * \brief  Export of binary trace records to a file
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * The records are written in the JSON array variant of the Trace Event
+ * Format, which can be loaded into chrome://tracing or the Perfetto UI.
+ * Each trace subject appears as a thread of a process named after the
+ * subject's session label.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _EXPORTER_H_
+#define _EXPORTER_H_
+
+/* Genode includes */
+#include <base/session_label.h>
+#include <base/trace/types.h>
+#include <os/path.h>
+#include <timer_session/connection.h>
+#include <trace/binary_record.h>
+#include <vfs/simple_env.h>
+
+class Exporter
+{
+	public:
+
+		typedef Genode::Path<256>                     Path;
+		typedef Genode::Trace::Thread_name            Thread_name;
+		typedef Genode::Trace::Binary_record          Record;
+
+		struct Open_failed : Genode::Exception { };
+
+	private:
+
+		enum { BUF_SIZE = 16*1024 };
+
+		struct Output : Genode::Output
+		{
+			Exporter &exporter;
+
+			Output(Exporter &exporter) : exporter(exporter) { }
+
+			void out_char(char c) override
+			{
+				if (exporter._buf_used == BUF_SIZE)
+					exporter._write_buffer();
+
+				exporter._buf[exporter._buf_used++] = c;
+			}
+		};
+
+		Genode::Env       &_env;
+		Timer::Connection &_timer;
+		Vfs::Simple_env    _vfs_env;
+		Path         const _path;
+		Vfs::Vfs_handle   &_handle;
+		Vfs::file_size     _offset   { 0 };
+		bool               _failed   { false };
+		Output             _output   { *this };
+		Genode::size_t     _buf_used { 0 };
+		char               _buf[BUF_SIZE];
+
+		/*
+		 * Calibration of timestamps, which are counted in CPU-specific
+		 * ticks, against the timer
+		 */
+		Genode::Trace::Timestamp const _ts_start;
+		Genode::uint64_t         const _us_start;
+		Genode::uint64_t               _ticks_per_ms { 1 };
+		bool                           _calibrated   { false };
+
+		Vfs::Vfs_handle &_open();
+
+		void _write_buffer();
+
+		template <typename... ARGS>
+		void _print(ARGS &&... args) { Genode::print(_output, args...); }
+
+		/**
+		 * Print timestamp in microseconds relative to the start of the export
+		 */
+		void _print_timestamp(Genode::Trace::Timestamp);
+
+		/*
+		 * Noncopyable
+		 */
+		Exporter(Exporter const &);
+		Exporter &operator = (Exporter const &);
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \throw Open_failed
+		 */
+		Exporter(Genode::Env &env, Genode::Allocator &alloc,
+		         Timer::Connection &timer, Genode::Xml_node vfs_config,
+		         Path const &path);
+
+		~Exporter();
+
+		/**
+		 * Name the process that groups the threads of a session label
+		 */
+		void process_name(unsigned pid, Genode::Session_label const &);
+
+		void thread_name(unsigned pid, unsigned tid, Thread_name const &);
+
+		void record(unsigned pid, unsigned tid, Record const &,
+		            char const *name, Genode::size_t name_len);
+
+		/**
+		 * Mark the loss of events of a thread at the current time
+		 */
+		void events_lost(unsigned pid, unsigned tid);
+
+		/**
+		 * Calibrate timestamps against the timer
+		 *
+		 * The calibration is done only once, at the first call that covers
+		 * a sufficiently long interval, so that the exported timestamps of
+		 * a thread never go backwards.
+		 */
+		void calibrate();
+
+		/**
+		 * Write pending output to the file
+		 */
+		void flush();
+};
+
+#endif /* _EXPORTER_H_ */
@@ -15,6 +15,7 @@
 #include <policy.h>
 #include <monitor.h>
 #include <xml_node.h>
+#include <exporter.h>
 
 /* Genode includes */
 #include <base/component.h>
@@ -23,6 +24,7 @@
 #include <os/session_policy.h>
 #include <timer_session/connection.h>
 #include <util/construct_at.h>
+#include <util/reconstructible.h>
 
 using namespace Genode;
 using Thread_name = String<40>;
@@ -32,10 +34,12 @@ class Main
 {
 	private:
 
-		enum { MAX_SUBJECTS                  = 512 };
 		enum { DEFAULT_PERIOD_SEC            = 5 };
 		enum { DEFAULT_BUFFER                = 1024 * 4 };
-		enum { DEFAULT_SESSION_ARG_BUFFER    = 1024 * 4 };
+		enum { DEFAULT_MAX_SUBJECTS          = 1024 };
+		enum { DEFAULT_SESSION_ARG_BUFFER    = DEFAULT_MAX_SUBJECTS *
+		                                       (sizeof(Trace::Subject_info) +
+		                                        sizeof(Trace::Subject_id)) };
 		enum { DEFAULT_SESSION_RAM           = 1024 * 1024 };
 		enum { DEFAULT_SESSION_PARENT_LEVELS = 0 };
 
@@ -43,9 +47,11 @@ class Main
 		Timer::Connection              _timer               { _env };
 		Attached_rom_dataspace         _config_rom          { _env, "config" };
 		Xml_node                const  _config              { _config_rom.xml() };
+		Number_of_bytes         const  _session_arg_buffer  { _config.attribute_value("session_arg_buffer", Number_of_bytes(DEFAULT_SESSION_ARG_BUFFER)) };
+		size_t                  const  _max_subjects        { Trace::Session::max_subject_infos(_session_arg_buffer) };
 		Trace::Connection              _trace               { _env,
 		                                                      _config.attribute_value("session_ram", Number_of_bytes(DEFAULT_SESSION_RAM)),
-		                                                      _config.attribute_value("session_arg_buffer", Number_of_bytes(DEFAULT_SESSION_ARG_BUFFER)),
+		                                                      _session_arg_buffer,
 		                                                      _config.attribute_value("session_parent_levels", (unsigned)DEFAULT_SESSION_PARENT_LEVELS) };
 		bool                    const  _affinity            { _config.attribute_value("affinity", false) };
 		bool                    const  _activity            { _config.attribute_value("activity", false) };
@@ -54,6 +60,7 @@ class Main
 		Number_of_bytes         const  _default_buf_sz      { _config.attribute_value("default_buffer", Number_of_bytes(DEFAULT_BUFFER)) };
 		Timer::Periodic_timeout<Main>  _period              { _timer, *this, &Main::_handle_period, _period_us };
 		Heap                           _heap                { _env.ram(), _env.rm() };
+		Constructible<Exporter>        _exporter            { };
 		Monitor_tree                   _monitors_0          { };
 		Monitor_tree                   _monitors_1          { };
 		bool                           _monitors_switch     { false };
@@ -63,7 +70,6 @@ class Main
 		unsigned long                  _report_id           { 0 };
 		unsigned long                  _num_subjects        { 0 };
 		unsigned long                  _num_monitors        { 0 };
-		Trace::Subject_id              _subjects[MAX_SUBJECTS];
 
 		void _handle_period(Duration)
 		{
@@ -89,20 +95,17 @@ class Main
 			Monitor_tree &new_monitors = _monitors_switch ? _monitors_0 : _monitors_1;
 			_monitors_switch = !_monitors_switch;
 
-			/* update available subject IDs and iterate over them */
-			try { _num_subjects = _trace.subjects(_subjects, MAX_SUBJECTS); }
-			catch (Out_of_ram ) { warning("Cannot list subjects: Out_of_ram" ); return; }
-			catch (Out_of_caps) { warning("Cannot list subjects: Out_of_caps"); return; }
-			for (unsigned i = 0; i < _num_subjects; i++) {
+			/* update available subjects and iterate over them */
+			auto update_monitor = [&] (Trace::Subject_id   const  id,
+			                           Trace::Subject_info const &info) {
 
-				Trace::Subject_id const id = _subjects[i];
-				try {
-					/* skip dead subjects */
-					if (_trace.subject_info(id).state() == Trace::Subject_info::DEAD)
-						continue;
+				/* skip dead subjects */
+				if (info.state() == Trace::Subject_info::DEAD)
+					return;
 
+				try {
 					/* check if there is a matching policy in the XML config */
-					Session_policy session_policy = _session_policy(id);
+					Session_policy session_policy = _session_policy(info);
 					try {
 						/* lookup monitor by subject ID */
 						Monitor &monitor = old_monitors.find_by_subject_id(id);
@@ -110,6 +113,7 @@ class Main
 						/* move monitor from old to new tree */
 						old_monitors.remove(&monitor);
 						new_monitors.insert(&monitor);
+						monitor.update_info(info);
 
 					} catch (Monitor_tree::No_match) {
 
@@ -117,13 +121,30 @@ class Main
 						_new_monitor(new_monitors, id, session_policy);
 					}
 				}
-				catch (Trace::Nonexistent_subject       ) { continue; }
-				catch (Session_policy::No_policy_defined) { continue; }
-			}
+				catch (Session_policy::No_policy_defined) { }
+			};
+			try { _num_subjects = _trace.for_each_subject_info(update_monitor); }
+			catch (Out_of_ram ) { warning("Cannot list subjects: Out_of_ram" ); return; }
+			catch (Out_of_caps) { warning("Cannot list subjects: Out_of_caps"); return; }
+
+			/* subjects beyond the capacity of the argument buffer are omitted */
+			if (_num_subjects >= _max_subjects)
+				warning("argument buffer holds only ", _max_subjects, " subjects, "
+				        "increase 'session_arg_buffer' to monitor the remaining ones");
+
 			/* all monitors in the old tree are deprecated, destroy them */
 			while (Monitor *monitor = old_monitors.first())
 				_destroy_monitor(old_monitors, *monitor);
 
+			/* export binary records of each monitor in the new tree */
+			if (_exporter.constructed()) {
+				_exporter->calibrate();
+				new_monitors.for_each([&] (Monitor &monitor) {
+					monitor.export_events(*_exporter); });
+				_exporter->flush();
+				return;
+			}
+
 			/* dump information of each monitor in the new tree */
 			log("");
 			log("--- Report ", _report_id++, " (", _num_monitors, "/", _num_subjects, " subjects) ---");
@@ -175,9 +196,8 @@ class Main
 				log("new monitor: subject ", id.id);
 		}
 
-		Session_policy _session_policy(Trace::Subject_id id)
+		Session_policy _session_policy(Trace::Subject_info const &info)
 		{
-			Trace::Subject_info info = _trace.subject_info(id);
 			Session_label const label(info.session_label());
 			Session_policy policy(label, _config);
 			if (policy.has_attribute("thread"))
@@ -187,9 +207,30 @@ class Main
 			return policy;
 		}
 
+		void _construct_exporter()
+		{
+			typedef String<Exporter::Path::capacity()> Path;
+
+			Path const path = _config.attribute_value("export", Path());
+			if (!path.valid())
+				return;
+
+			try {
+				_exporter.construct(_env, _heap, _timer, _config.sub_node("vfs"),
+				                    Exporter::Path(path.string()));
+			}
+			catch (Xml_node::Nonexistent_sub_node) {
+				error("export of trace events requires a <vfs> config node"); }
+			catch (Exporter::Open_failed) { }
+		}
+
 	public:
 
-		Main(Env &env) : _env(env) { _policies.insert(_default_policy); }
+		Main(Env &env) : _env(env)
+		{
+			_policies.insert(_default_policy);
+			_construct_exporter();
+		}
 };
 
 
@@ -65,31 +65,24 @@ Monitor::Monitor(Trace::Connection &trace,
 	Monitor_base(trace, rm, subject_id),
 	_subject_id(subject_id), _buffer(_buffer_raw)
 {
-	_update_info();
+	try { update_info(_trace.subject_info(_subject_id)); }
+	catch (Trace::Nonexistent_subject) { warning("Cannot update subject info: Nonexistent_subject"); }
 }
 
 
-void Monitor::_update_info()
+void Monitor::update_info(Trace::Subject_info const &info)
 {
-	try {
-		Trace::Subject_info const &info =
-			_trace.subject_info(_subject_id);
-
-		uint64_t const last_execution_time =
-			_info.execution_time().thread_context;
+	uint64_t const last_execution_time =
+		_info.execution_time().thread_context;
 
-		_info = info;
-		_recent_exec_time =
-			_info.execution_time().thread_context - last_execution_time;
-	}
-	catch (Trace::Nonexistent_subject) { warning("Cannot update subject info: Nonexistent_subject"); }
+	_info = info;
+	_recent_exec_time =
+		_info.execution_time().thread_context - last_execution_time;
 }
 
 
 void Monitor::print(bool activity, bool affinity)
 {
-	_update_info();
-
 	/* print general subject information */
 	typedef Trace::Subject_info Subject_info;
 	Subject_info::State const state = _info.state();
@@ -140,6 +133,48 @@ void Monitor::print(bool activity, bool affinity)
 }
 
 
+unsigned Monitor::_export_pid() const
+{
+	/* FNV-1a hash of the session label */
+	uint32_t hash = 2166136261u;
+	for (char const *c = _info.session_label().string(); *c; c++)
+		hash = (hash ^ (uint8_t)*c) * 16777619u;
+
+	return hash & 0x7fffffff;
+}
+
+
+void Monitor::export_events(Exporter &exporter)
+{
+	typedef Trace::Binary_record Record;
+
+	unsigned const pid = _export_pid();
+	unsigned const tid = _subject_id.id;
+
+	if (!_names_exported) {
+		exporter.process_name(pid, _info.session_label());
+		exporter.thread_name(pid, tid, _info.thread_name());
+		_names_exported = true;
+	}
+
+	/*
+	 * If the buffer wrapped more than once since the last export, the
+	 * traced thread has overwritten records not exported yet.
+	 */
+	unsigned const wraps = _buffer_raw.wrapped();
+	if (wraps - _exported_wraps > 1)
+		exporter.events_lost(pid, tid);
+	_exported_wraps = wraps;
+
+	_buffer.for_each_new_entry([&] (Trace::Buffer::Entry entry) {
+
+		Record::with_record(entry.data(), entry.length(),
+		                    [&] (Record const &record, char const *name, size_t len) {
+			exporter.record(pid, tid, record, name, len); });
+	});
+}
+
+
 /******************
  ** Monitor_tree **
  ******************/
@@ -17,6 +17,7 @@
 /* local includes */
 #include <avl_tree.h>
 #include <trace_buffer.h>
+#include <exporter.h>
 
 /* Genode includes */
 #include <base/trace/types.h>
@@ -59,8 +60,15 @@ class Monitor : public Monitor_base,
 		Genode::Trace::Subject_info      _info             { };
 		unsigned long long               _recent_exec_time { 0 };
 		char                             _curr_entry_data[MAX_ENTRY_LENGTH];
+		bool                             _names_exported   { false };
+		unsigned                         _exported_wraps   { 0 };
 
-		void _update_info();
+		/**
+		 * Process ID of the subject in the exported trace
+		 *
+		 * All threads with the same session label share a process ID.
+		 */
+		unsigned _export_pid() const;
 
 	public:
 
@@ -68,8 +76,19 @@ class Monitor : public Monitor_base,
 		        Genode::Region_map        &rm,
 		        Genode::Trace::Subject_id  subject_id);
 
+		/**
+		 * Update subject information, e.g., as obtained in bulk via
+		 * 'Trace::Connection::for_each_subject_info'
+		 */
+		void update_info(Genode::Trace::Subject_info const &info);
+
 		void print(bool activity, bool affinity);
 
+		/**
+		 * Export all new binary records of the trace buffer
+		 */
+		void export_events(Exporter &exporter);
+
 
 		/**************
 		 ** Avl_node **
@@ -1,5 +1,5 @@
 TARGET      = trace_logger
 INC_DIR    += $(PRG_DIR)
-SRC_CC      = main.cc monitor.cc policy.cc xml_node.cc
+SRC_CC      = main.cc monitor.cc policy.cc xml_node.cc exporter.cc
 CONFIG_XSD  = config.xsd
-LIBS       += base
+LIBS       += base vfs
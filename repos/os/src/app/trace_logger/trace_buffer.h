@@ -29,6 +29,9 @@ class Trace_buffer
 		Genode::Trace::Buffer::Entry  _curr          { _buffer.first() };
 		unsigned                      _wrapped_count { 0 };
 
+		/* true if '_curr' was passed to the functor already */
+		bool                          _curr_done     { false };
+
 	public:
 
 		Trace_buffer(Genode::Trace::Buffer &buffer) : _buffer(buffer) { }
@@ -50,23 +53,23 @@ class Trace_buffer
 				_curr = _buffer.first();
 
 			/* iterate over all entries that were not processed yet */
-			     Trace::Buffer::Entry e1 = _curr;
-			for (Trace::Buffer::Entry e2 = _curr; wrapped || !e2.last();
-			                          e2 = _buffer.next(e2))
+			Trace::Buffer::Entry e = _curr_done ? _buffer.next(_curr) : _curr;
+			for (; wrapped || !e.last(); e = _buffer.next(e))
 			{
 				/* if buffer wrapped, we pass the last entry once and continue at first entry */
-				if (wrapped && e2.last()) {
+				if (wrapped && e.last()) {
 					wrapped = false;
-					e2 = _buffer.first();
-					if (e2.last())
+					e = _buffer.first();
+					if (e.last())
 						break;
 				}
 
-				e1 = e2;
-				functor(e1);
+				functor(e);
+
+				/* remember the last processed entry in _curr */
+				_curr      = e;
+				_curr_done = true;
 			}
-			/* remember the last processed entry in _curr */
-			_curr = e1;
 		}
 };
 
@@ -58,9 +58,6 @@ struct Trace_subject_registry
 			return nullptr;
 		}
 
-		enum { MAX_SUBJECTS = 512 };
-		Genode::Trace::Subject_id _subjects[MAX_SUBJECTS];
-
 		void _sort_by_recent_execution_time()
 		{
 			Genode::List<Entry> sorted;
@@ -81,24 +78,24 @@ struct Trace_subject_registry
 			_entries = sorted;
 		}
 
-		unsigned update_subjects(Genode::Trace::Connection &trace)
+		template <typename FN>
+		unsigned update_subjects(Genode::Trace::Connection &trace, FN const &fn)
 		{
 			return Genode::retry<Genode::Out_of_ram>(
-				[&] () { return trace.subjects(_subjects, MAX_SUBJECTS); },
+				[&] () { return trace.for_each_subject_info(fn); },
 				[&] () { trace.upgrade_ram(4096); }
 			);
 		}
 
 	public:
 
+		enum { MAX_SUBJECTS = 512 };
+
 		void update(Genode::Trace::Connection &trace, Genode::Allocator &alloc)
 		{
-			unsigned const num_subjects = update_subjects(trace);
-
 			/* add and update existing entries */
-			for (unsigned i = 0; i < num_subjects; i++) {
-
-				Genode::Trace::Subject_id const id = _subjects[i];
+			auto update_entry = [&] (Genode::Trace::Subject_id   const  id,
+			                         Genode::Trace::Subject_info const &info) {
 
 				Entry *e = _lookup(id);
 				if (!e) {
@@ -106,7 +103,7 @@ struct Trace_subject_registry
 					_entries.insert(e);
 				}
 
-				e->update(trace.subject_info(id));
+				e->update(info);
 
 				/* purge dead threads */
 				if (e->info.state() == Genode::Trace::Subject_info::DEAD) {
@@ -114,7 +111,13 @@ struct Trace_subject_registry
 					_entries.remove(e);
 					Genode::destroy(alloc, e);
 				}
-			}
+			};
+
+			unsigned const num_subjects = update_subjects(trace, update_entry);
+
+			if (num_subjects >= MAX_SUBJECTS)
+				Genode::warning("argument buffer holds only ", (unsigned)MAX_SUBJECTS,
+				                " subjects, omitting the remaining ones");
 
 			_sort_by_recent_execution_time();
 		}
@@ -160,7 +163,14 @@ struct App::Main
 {
 	Env &_env;
 
-	Trace::Connection _trace { _env, 10*4096, 32*1024, 0 };
+	enum {
+		/* holds the information of all subjects */
+		ARG_BUFFER_RAM  = Trace_subject_registry::MAX_SUBJECTS *
+		                  (sizeof(Trace::Subject_info) + sizeof(Trace::Subject_id)),
+		TRACE_RAM_QUOTA = 10 * 4096 + ARG_BUFFER_RAM,
+	};
+
+	Trace::Connection _trace { _env, TRACE_RAM_QUOTA, ARG_BUFFER_RAM, 0 };
 
 	Reporter _reporter { _env, "trace_subjects", "trace_subjects", 64*1024 };
 
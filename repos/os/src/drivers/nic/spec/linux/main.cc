@@ -14,6 +14,10 @@
  *  <config>
  *  	<nic mac="12:23:34:45:56:67" tap="tap1"/>
  *  </config>
+ *
+ * The TAP device is opened with 'IFF_VNET_HDR', which enables the checksum
+ * and TCP segmentation offload features of the NIC session. The offload
+ * header of the NIC session is passed unmodified to and from the device.
  */
 
 /*
@@ -43,6 +47,7 @@
 #include <unistd.h>
 #include <fcntl.h>
 #include <sys/ioctl.h>
+#include <sys/uio.h>
 #include <net/if.h>
 #include <linux/if_tun.h>
 
@@ -82,12 +87,31 @@ class Linux_session_component : public Nic::Session_component
 			}
 		};
 
+		enum { VNET_HDR_SIZE = 10, MAX_SUPER_FRAME_SIZE = 64*1024 };
+
+		/* the device uses the default size of the virtio-net header */
+		static_assert(sizeof(Nic::Offload_header) == VNET_HDR_SIZE,
+		              "offload header differs from virtio-net header");
+
 		Genode::Attached_rom_dataspace _config_rom;
 
 		Nic::Mac_address _mac_addr { };
+		bool             _vnet_hdr { false };
 		int              _tap_fd;
 		Rx_signal_thread _rx_thread;
 
+		/*
+		 * Bounce buffer for received super frames
+		 *
+		 * Packets are released by the size given in their descriptor.
+		 * Hence, a super frame is read into the bounce buffer first and
+		 * copied into a packet of the exact size. A frame that cannot be
+		 * copied because the packet buffer is exhausted stays pending
+		 * until the client acknowledged packets.
+		 */
+		char   _rx_buf[VNET_HDR_SIZE + MAX_SUPER_FRAME_SIZE] { };
+		size_t _rx_pending { 0 };
+
 		int _setup_tap_fd()
 		{
 			/* open TAP device */
@@ -121,7 +145,15 @@ class Linux_session_component : public Nic::Session_component
 				Genode::log("no config provided, using tap0");
 			}
 
+			/* prefer the device with virtio-net header, needed for offloading */
+			ifr.ifr_flags |= IFF_VNET_HDR;
 			ret = ioctl(fd, TUNSETIFF, (void *) &ifr);
+			if (ret != 0) {
+				ifr.ifr_flags &= ~IFF_VNET_HDR;
+				ret = ioctl(fd, TUNSETIFF, (void *) &ifr);
+			}
+			_vnet_hdr = ifr.ifr_flags & IFF_VNET_HDR;
+
 			if (ret != 0) {
 				Genode::error("could not configure /dev/net/tun: no virtual network emulation");
 				close(fd);
@@ -148,11 +180,23 @@ class Linux_session_component : public Nic::Session_component
 				return true;
 			}
 
+			/*
+			 * The offload header of the packet is passed to the device as
+			 * is. Without offload features, a zero header is prepended.
+			 */
+			Nic::Offload_header const header { };
+
+			iovec iov[2] = {
+				{ (void *)&header, _offload.any() ? 0 : sizeof(header) },
+				{ _tx.sink()->packet_content(packet), packet.size() } };
+
+			int const iov_start = _vnet_hdr ? 0 : 1;
+
 			int ret;
 
 			/* non-blocking-write packet to TAP */
 			do {
-				ret = write(_tap_fd, _tx.sink()->packet_content(packet), packet.size());
+				ret = writev(_tap_fd, iov + iov_start, 2 - iov_start);
 				/* drop packet if write would block */
 				if (ret < 0 && errno == EAGAIN)
 					continue;
@@ -165,9 +209,42 @@ class Linux_session_component : public Nic::Session_component
 			return true;
 		}
 
+		bool _receive_super_frame()
+		{
+			if (!_rx.source()->ready_to_submit())
+				return false;
+
+			if (!_rx_pending) {
+				int const size = read(_tap_fd, _rx_buf, sizeof(_rx_buf));
+				if (size <= 0)
+					return false;
+
+				_rx_pending = size;
+			}
+
+			Nic::Packet_descriptor p;
+			try {
+				p = _rx.source()->alloc_packet(_rx_pending);
+			} catch (Session::Rx::Source::Packet_alloc_failed) { return false; }
+
+			Genode::memcpy(_rx.source()->packet_content(p), _rx_buf, _rx_pending);
+			_rx.source()->submit_packet(p);
+			_rx_pending = 0;
+
+			return true;
+		}
+
 		bool _receive()
 		{
-			unsigned const max_size = Nic::Packet_allocator::DEFAULT_PACKET_SIZE;
+			if (_offload.tso)
+				return _receive_super_frame();
+
+			Nic::Offload_header header { };
+
+			/* the device delivers the header if offloading is disabled */
+			size_t const skip_size = (_vnet_hdr && !_offload.any()) ? sizeof(header) : 0;
+
+			size_t const max_size = Nic::Packet_allocator::DEFAULT_PACKET_SIZE;
 
 			if (!_rx.source()->ready_to_submit())
 				return false;
@@ -177,13 +254,19 @@ class Linux_session_component : public Nic::Session_component
 				p = _rx.source()->alloc_packet(max_size);
 			} catch (Session::Rx::Source::Packet_alloc_failed) { return false; }
 
-			int size = read(_tap_fd, _rx.source()->packet_content(p), max_size);
+			iovec iov[2] = {
+				{ &header, skip_size },
+				{ _rx.source()->packet_content(p), max_size } };
+
+			int const iov_start = skip_size ? 0 : 1;
+
+			int size = readv(_tap_fd, iov + iov_start, 2 - iov_start) - (int)skip_size;
 			if (size <= 0) {
 				_rx.source()->release_packet(p);
 				return false;
 			}
 
-			/* adjust packet size */
+			/* adjust packet size, which stays within the allocated block */
 			Nic::Packet_descriptor p_adjust(p.offset(), size);
 			_rx.source()->submit_packet(p_adjust);
 
@@ -192,6 +275,30 @@ class Linux_session_component : public Nic::Session_component
 
 	protected:
 
+		Nic::Offload _enable_offload(Nic::Offload const &requested) override
+		{
+			Nic::Offload offload;
+			if (!_vnet_hdr)
+				return offload;
+
+			/* segmentation offload requires checksum offload */
+			offload.checksum = requested.checksum;
+			offload.tso      = requested.checksum && requested.tso;
+
+			unsigned const flags = (offload.checksum ? TUN_F_CSUM : 0)
+			                     | (offload.tso      ? TUN_F_TSO4 : 0);
+
+			if (ioctl(_tap_fd, TUNSETOFFLOAD, flags) != 0) {
+				Genode::warning("could not enable offloading of TAP device");
+				return Nic::Offload();
+			}
+
+			if (offload.any())
+				Genode::log("offload: ", offload);
+
+			return offload;
+		}
+
 		void _handle_packet_stream() override
 		{
 			while (_rx.source()->ack_avail())
@@ -35,18 +35,9 @@ Init::Child::apply_config(Xml_node start_node)
 	 * If the child's environment is incomplete, restart it to attempt
 	 * the re-routing of its environment sessions.
 	 */
-	{
-		bool env_log_exists = false, env_binary_exists = false;
-		_child.for_each_session([&] (Session_state const &session) {
-			Parent::Client::Id const id = session.id_at_client();
-			env_log_exists    |= (id == Parent::Env::log());
-			env_binary_exists |= (id == Parent::Env::binary());
-		});
-
-		if (!env_binary_exists || !env_log_exists) {
-			abandon();
-			return MAY_HAVE_SIDE_EFFECTS;
-		}
+	if (env_sessions_incomplete()) {
+		abandon();
+		return MAY_HAVE_SIDE_EFFECTS;
 	}
 
 	bool provided_services_changed = false;
@@ -508,11 +499,7 @@ Init::Child::Route Init::Child::resolve_session_request(Service::Name const &ser
 		               Session::Label(), Session::Diag{false} };
 
 	try {
-		Xml_node route_node = _default_route_accessor.default_route();
-		try {
-			route_node = _start_node->xml().sub_node("route"); }
-		catch (...) { }
-		Xml_node service_node = route_node.sub_node();
+		Xml_node service_node = _route_node().sub_node();
 
 		for (; ; service_node = service_node.next()) {
 
@@ -20,6 +20,7 @@
 #include <os/session_requester.h>
 #include <os/session_policy.h>
 #include <os/buffered_xml.h>
+#include <util/avl_tree.h>
 
 /* local includes */
 #include <types.h>
@@ -44,7 +45,10 @@ class Init::Child : Child_policy, Routed_service::Wakeup
 		struct Missing_name_attribute   : Exception { };
 
 		/**
-		 * Unique ID of the child, solely used for diagnostic purposes
+		 * Unique ID of the child
+		 *
+		 * IDs are assigned in ascending order, which allows for the
+		 * distinction of children started by the latest config update.
 		 */
 		struct Id { unsigned value; };
 
@@ -84,6 +88,35 @@ class Init::Child : Child_policy, Routed_service::Wakeup
 
 		List_element<Child> _list_element;
 
+		/**
+		 * Element of the name-indexed child tree of 'Child_registry'
+		 *
+		 * Children of the same name, e.g., an abandoned child and its
+		 * restarted successor, are ordered by their IDs.
+		 */
+		struct Name_index_element : Avl_node<Name_index_element>
+		{
+			Child &object;
+
+			Name_index_element(Child &child) : object(child) { }
+
+			bool higher(Name_index_element const *other) const
+			{
+				int const cmp = strcmp(other->object._unique_name.string(),
+				                       object._unique_name.string());
+
+				return cmp ? (cmp > 0) : (other->object._id.value > object._id.value);
+			}
+		};
+
+		Name_index_element _name_index_element { *this };
+
+		/*
+		 * Number of the config-update pass that marked the child last,
+		 * see 'Init::Main::_update_children_config'
+		 */
+		unsigned _marked_pass = 0;
+
 		Reconstructible<Buffered_xml> _start_node;
 
 		/*
@@ -391,6 +424,18 @@ class Init::Child : Child_policy, Routed_service::Wakeup
 			catch (Service_denied) { return false; }
 		}
 
+		/**
+		 * Return route node that applies to the child
+		 */
+		Xml_node _route_node() const
+		{
+			Xml_node const start_node = _start_node->xml();
+
+			return start_node.has_sub_node("route")
+			     ? start_node.sub_node("route")
+			     : _default_route_accessor.default_route();
+		}
+
 		static Xml_node _provides_sub_node(Xml_node start_node)
 		{
 			return start_node.has_sub_node("provides")
@@ -491,6 +536,8 @@ class Init::Child : Child_policy, Routed_service::Wakeup
 
 		bool has_version(Version const &version) const { return version == _version; }
 
+		Id id() const { return _id; }
+
 		Ram_quota ram_quota() const { return _resources.assigned_ram_quota; }
 		Cap_quota cap_quota() const { return _resources.assigned_cap_quota; }
 
@@ -537,6 +584,64 @@ class Init::Child : Child_policy, Routed_service::Wakeup
 
 		bool env_sessions_closed() const { return _child.env_sessions_closed(); }
 
+		/**
+		 * Return true if one of the child's environment sessions is missing
+		 */
+		bool env_sessions_incomplete() const
+		{
+			bool env_log_exists = false, env_binary_exists = false;
+			_child.for_each_session([&] (Session_state const &session) {
+				Parent::Client::Id const id = session.id_at_client();
+				env_log_exists    |= (id == Parent::Env::log());
+				env_binary_exists |= (id == Parent::Env::binary());
+			});
+
+			return !env_binary_exists || !env_log_exists;
+		}
+
+		/**
+		 * Return true if the start node differs from the applied one
+		 */
+		bool start_node_differs(Xml_node start_node) const
+		{
+			return start_node.differs_from(_start_node->xml());
+		}
+
+		/**
+		 * Return true if the routes of the child may lead to a child for
+		 * which 'fn' returns true
+		 *
+		 * A route to any child may lead to each child.
+		 */
+		template <typename FN>
+		bool route_may_lead_to(FN const &fn) const
+		{
+			typedef Name_registry::Name Name;
+
+			bool result = false;
+			_route_node().for_each_sub_node([&] (Xml_node service) {
+				service.for_each_sub_node([&] (Xml_node target) {
+
+					if (result)
+						return;
+
+					if (target.has_type("any-child"))
+						result = true;
+
+					if (target.has_type("child"))
+						result = fn(_name_registry.deref_alias(
+						            target.attribute_value("name", Name())));
+				});
+			});
+			return result;
+		}
+
+		/**
+		 * Bookkeeping of the config-update passes of 'Init::Main'
+		 */
+		void mark(unsigned pass)         { _marked_pass = pass; }
+		bool marked(unsigned pass) const { return _marked_pass == pass; }
+
 		enum Apply_config_result { MAY_HAVE_SIDE_EFFECTS, NO_SIDE_EFFECTS };
 
 		/**
@@ -29,6 +29,33 @@ class Init::Child_registry : public Name_registry, Child_list
 
 		List<Alias> _aliases { };
 
+		typedef Child::Name_index_element Name_index_element;
+
+		Avl_tree<Name_index_element> _name_index { };
+
+		/**
+		 * Call 'fn' for each child of the name-index subtree with the given name
+		 */
+		template <typename FN>
+		static void _for_each_child_with_name(Name_index_element *element,
+		                                      char const *name, FN const &fn)
+		{
+			if (!element)
+				return;
+
+			int const cmp = strcmp(name, element->object._unique_name.string());
+
+			/* children of the same name may reside in both subtrees */
+			if (cmp <= 0)
+				_for_each_child_with_name(element->child(Name_index_element::LEFT), name, fn);
+
+			if (cmp == 0)
+				fn(element->object);
+
+			if (cmp >= 0)
+				_for_each_child_with_name(element->child(Name_index_element::RIGHT), name, fn);
+		}
+
 		bool _unique(const char *name) const
 		{
 			/* check for name clash with an existing child */
@@ -59,6 +86,7 @@ class Init::Child_registry : public Name_registry, Child_list
 		void insert(Child *child)
 		{
 			Child_list::insert(&child->_list_element);
+			_name_index.insert(&child->_name_index_element);
 		}
 
 		/**
@@ -67,6 +95,7 @@ class Init::Child_registry : public Name_registry, Child_list
 		void remove(Child *child)
 		{
 			Child_list::remove(&child->_list_element);
+			_name_index.remove(&child->_name_index_element);
 		}
 
 		/**
@@ -123,6 +152,29 @@ class Init::Child_registry : public Name_registry, Child_list
 			}
 		}
 
+		/**
+		 * Call 'fn' for each child with the specified name
+		 *
+		 * Besides the child currently in charge, the name may refer to
+		 * abandoned children that are not yet destroyed.
+		 */
+		template <typename FN>
+		void for_each_child_with_name(Child::Name const &name, FN const &fn)
+		{
+			_for_each_child_with_name(_name_index.first(), name.string(), fn);
+		}
+
+		/**
+		 * Call 'fn' with the non-abandoned child of the specified name
+		 */
+		template <typename FN>
+		void with_child(Child::Name const &name, FN const &fn)
+		{
+			for_each_child_with_name(name, [&] (Child &child) {
+				if (!child.abandoned())
+					fn(child); });
+		}
+
 		void report_state(Xml_generator &xml, Report_detail const &detail) const
 		{
 			for_each_child([&] (Child &child) { child.report_state(xml, detail); });
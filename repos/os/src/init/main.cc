@@ -48,6 +48,35 @@ struct Init::Main : State_reporter::Producer,
 
 	unsigned _child_cnt = 0;
 
+	/* value of '_child_cnt' before starting the children of the last update */
+	unsigned _child_cnt_applied = 0;
+
+	/* counter of config-update passes, used for marking children */
+	unsigned _config_pass = 0;
+
+	/*
+	 * Checksum of the parts of the configuration that affect the routing
+	 * of all children
+	 */
+	uint64_t _routing_checksum = 0;
+
+	static uint64_t _routing_checksum_from_config(Xml_node config)
+	{
+		/* FNV-1a hash */
+		uint64_t hash = 0xcbf29ce484222325ULL;
+
+		auto add_node = [&] (Xml_node node) {
+			node.with_raw_node([&] (char const *start, size_t num_bytes) {
+				for (size_t i = 0; i < num_bytes; i++)
+					hash = (hash ^ (unsigned char)start[i])*0x100000001b3ULL; }); };
+
+		config.for_each_sub_node("default-route",   add_node);
+		config.for_each_sub_node("alias",           add_node);
+		config.for_each_sub_node("parent-provides", add_node);
+
+		return hash;
+	}
+
 	static Ram_quota _preserved_ram_from_config(Xml_node config)
 	{
 		Number_of_bytes preserve { 40*sizeof(long)*1024 };
@@ -147,8 +176,8 @@ struct Init::Main : State_reporter::Producer,
 
 	void _update_aliases_from_config();
 	void _update_parent_services_from_config();
-	void _abandon_obsolete_children();
-	void _update_children_config();
+	bool _abandon_obsolete_children();
+	void _update_children_config(bool routing_changed, bool side_effects);
 	void _destroy_abandoned_parent_services();
 	void _handle_config();
 
@@ -245,51 +274,97 @@ void Init::Main::_update_aliases_from_config()
 }
 
 
-void Init::Main::_abandon_obsolete_children()
+bool Init::Main::_abandon_obsolete_children()
 {
-	_children.for_each_child([&] (Child &child) {
+	/* mark children that still correspond to a start node */
+	unsigned const present_pass = ++_config_pass;
+
+	_config_xml.for_each_sub_node("start", [&] (Xml_node node) {
+		_children.with_child(node.attribute_value("name", Child_policy::Name()),
+		                     [&] (Child &child) {
+			if (child.has_version(node.attribute_value("version", Child::Version())))
+				child.mark(present_pass); });
+	});
 
-		bool obsolete = true;
-		_config_xml.for_each_sub_node("start", [&] (Xml_node node) {
-			if (child.has_name   (node.attribute_value("name", Child_policy::Name()))
-			 && child.has_version(node.attribute_value("version", Child::Version())))
-				obsolete = false; });
+	/*
+	 * Abandon the remaining children, marking them as side effects of the
+	 * subsequent pass
+	 */
+	unsigned const abandon_pass = ++_config_pass;
 
-		if (obsolete)
-			child.abandon();
+	bool side_effects = false;
+	_children.for_each_child([&] (Child &child) {
+		if (child.abandoned() || child.marked(present_pass))
+			return;
+
+		child.abandon();
+		child.mark(abandon_pass);
+		side_effects = true;
 	});
+
+	return side_effects;
 }
 
 
-void Init::Main::_update_children_config()
+void Init::Main::_update_children_config(bool const routing_changed,
+                                         bool       side_effects)
 {
-	for (;;) {
+	/*
+	 * Children are abandoned if any of their client sessions can no longer
+	 * be routed or result in a different route. As each child may be a
+	 * service, an avalanche effect may occur.
+	 *
+	 * The first pass evaluates the children with a changed start node or
+	 * an incomplete environment, or all children if the routing rules
+	 * shared by all children changed. Each pass also evaluates the children
+	 * with routes that may lead to a child that was abandoned or changed
+	 * its services in the previous pass. For the first pass, these are the
+	 * obsolete children and the children started by the previous update.
+	 * The iteration stops if no update causes a potential side effect in
+	 * one pass.
+	 */
+	for (bool first_pass = true; first_pass || side_effects; first_pass = false) {
 
-		/*
-		 * Children are abandoned if any of their client sessions can no longer
-		 * be routed or result in a different route. As each child may be a
-		 * service, an avalanche effect may occur. It stops if no update causes
-		 * a potential side effect in one iteration over all chilren.
-		 */
-		bool side_effects = false;
+		unsigned const previous_pass = _config_pass++;
+
+		auto changed_in_previous_pass = [&] (Child_policy::Name const &name)
+		{
+			bool changed = false;
+			_children.for_each_child_with_name(name, [&] (Child const &child) {
+				changed |= child.marked(previous_pass)
+				        || (first_pass && child.id().value > _child_cnt_applied); });
+			return changed;
+		};
+
+		bool const previous_side_effects = side_effects;
+		side_effects = false;
 
 		_config_xml.for_each_sub_node("start", [&] (Xml_node node) {
 
 			Child_policy::Name const start_node_name =
 				node.attribute_value("name", Child_policy::Name());
 
-			_children.for_each_child([&] (Child &child) {
-				if (!child.abandoned() && child.name() == start_node_name) {
-					switch (child.apply_config(node)) {
-					case Child::NO_SIDE_EFFECTS: break;
-					case Child::MAY_HAVE_SIDE_EFFECTS: side_effects = true; break;
-					};
-				}
+			_children.with_child(start_node_name, [&] (Child &child) {
+
+				bool const evaluate =
+					(first_pass && (routing_changed
+					             || child.start_node_differs(node)
+					             || child.env_sessions_incomplete()))
+					|| (previous_side_effects
+					 && child.route_may_lead_to(changed_in_previous_pass));
+
+				if (!evaluate)
+					return;
+
+				switch (child.apply_config(node)) {
+				case Child::NO_SIDE_EFFECTS: break;
+				case Child::MAY_HAVE_SIDE_EFFECTS:
+					child.mark(_config_pass);
+					side_effects = true;
+					break;
+				};
 			});
 		});
-
-		if (!side_effects)
-			break;
 	}
 }
 
@@ -320,10 +395,19 @@ void Init::Main::_handle_config()
 	Prio_levels     const prio_levels    = prio_levels_from_xml(_config_xml);
 	Affinity::Space const affinity_space = affinity_space_from_xml(_config_xml);
 
+	uint64_t const routing_checksum = _routing_checksum_from_config(_config_xml);
+	bool     const routing_changed  = (routing_checksum != _routing_checksum);
+	_routing_checksum = routing_checksum;
+
 	_update_aliases_from_config();
 	_update_parent_services_from_config();
-	_abandon_obsolete_children();
-	_update_children_config();
+
+	bool const obsolete_children = _abandon_obsolete_children();
+	bool const new_children      = (_child_cnt != _child_cnt_applied);
+
+	_update_children_config(routing_changed, obsolete_children || new_children);
+
+	_child_cnt_applied = _child_cnt;
 
 	/* kill abandoned children */
 	_children.for_each_child([&] (Child &child) {
@@ -361,14 +445,13 @@ void Init::Main::_handle_config()
 
 			unsigned num_abandoned = 0;
 
-			_children.for_each_child([&] (Child const &child) {
-				if (child.name() == start_node.attribute_value("name", Child_policy::Name())) {
+			_children.for_each_child_with_name(
+				start_node.attribute_value("name", Child_policy::Name()),
+				[&] (Child const &child) {
 					if (child.abandoned())
 						num_abandoned++;
 					else
-						exists = true;
-				}
-			});
+						exists = true; });
 
 			/* skip start node if corresponding child already exists */
 			if (exists)
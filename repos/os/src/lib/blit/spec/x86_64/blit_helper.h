@@ -0,0 +1,281 @@
+/*
+ * \brief  Blitting utilities for x86_64
+ * \author Genode Labs
+ * \date   2026-10-15
+ *
+ * The bulk of each line is copied via SSE2 or, if supported by the CPU and
+ * enabled by the kernel, via AVX2. Large blits use non-temporal stores to
+ * bypass the cache. They are typically full-screen updates of a scanout
+ * buffer, which is never read back by the CPU.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _LIB__BLIT__SPEC__X86_64__BLIT_HELPER_H_
+#define _LIB__BLIT__SPEC__X86_64__BLIT_HELPER_H_
+
+#include <copy_32bit.h>
+
+namespace Blit {
+
+	enum {
+		/*
+		 * Minimum number of bytes of a blit to use non-temporal stores
+		 *
+		 * Below this size, the destination is likely to remain in the
+		 * cache and the copy benefits from regular stores.
+		 */
+		NON_TEMPORAL_MIN_BYTES = 1024*1024,
+	};
+
+	struct Sse2;
+	struct Avx2;
+
+	static inline bool avx2_usable();
+}
+
+
+static inline void cpuid(unsigned leaf, unsigned subleaf,
+                         unsigned &eax, unsigned &ebx,
+                         unsigned &ecx, unsigned &edx)
+{
+	asm volatile ("cpuid"
+	              : "=a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx)
+	              : "a" (leaf), "c" (subleaf));
+}
+
+
+/**
+ * Return true if the CPU supports AVX2 and the kernel saves the YMM state
+ */
+static inline bool Blit::avx2_usable()
+{
+	/* -1 means not yet probed, concurrent probing yields the same result */
+	static int usable = -1;
+
+	if (usable >= 0)
+		return usable;
+
+	unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+
+	cpuid(0, 0, eax, ebx, ecx, edx);
+	unsigned const max_leaf = eax;
+
+	cpuid(1, 0, eax, ebx, ecx, edx);
+	bool const osxsave = ecx & (1 << 27);
+	bool const avx     = ecx & (1 << 28);
+
+	bool ymm_enabled = false;
+	if (osxsave && avx) {
+		unsigned xcr0_lo = 0, xcr0_hi = 0;
+		asm volatile ("xgetbv" : "=a" (xcr0_lo), "=d" (xcr0_hi) : "c" (0));
+
+		/* SSE and AVX state must be enabled in XCR0 */
+		ymm_enabled = (xcr0_lo & 6) == 6;
+	}
+
+	bool avx2 = false;
+	if (ymm_enabled && max_leaf >= 7) {
+		cpuid(7, 0, eax, ebx, ecx, edx);
+		avx2 = ebx & (1 << 5);
+	}
+
+	usable = avx2;
+	return avx2;
+}
+
+
+/**
+ * Copy routines based on 16-byte SSE2 registers
+ *
+ * SSE2 is part of the x86_64 base architecture.
+ */
+struct Blit::Sse2
+{
+	enum { STREAM_ALIGN = 16 };
+
+	/**
+	 * Copy 32byte chunks via regular stores
+	 */
+	static void copy(char const *src, char *dst, int size)
+	{
+		asm volatile (
+			".align 16                     \n\t"
+			"0:                            \n\t"
+			"movdqu (%0),%%xmm0            \n\t"
+			"movdqu 16(%0),%%xmm1          \n\t"
+			"movdqu %%xmm0,(%1)            \n\t"
+			"movdqu %%xmm1,16(%1)          \n\t"
+			"add    $32,%0                 \n\t"
+			"add    $32,%1                 \n\t"
+			"dec    %2                     \n\t"
+			"jnz    0b                     \n\t"
+			: "+r" (src), "+r" (dst), "+r" (size)
+			:
+			: "xmm0", "xmm1", "memory"
+		);
+	}
+
+	/**
+	 * Copy 32byte chunks via non-temporal stores
+	 *
+	 * \param dst  destination address aligned to 'STREAM_ALIGN'
+	 */
+	static void stream(char const *src, char *dst, int size)
+	{
+		asm volatile (
+			".align 16                     \n\t"
+			"0:                            \n\t"
+			"movdqu  (%0),%%xmm0           \n\t"
+			"movdqu  16(%0),%%xmm1         \n\t"
+			"movntdq %%xmm0,(%1)           \n\t"
+			"movntdq %%xmm1,16(%1)         \n\t"
+			"add     $32,%0                \n\t"
+			"add     $32,%1                \n\t"
+			"dec     %2                    \n\t"
+			"jnz     0b                    \n\t"
+			: "+r" (src), "+r" (dst), "+r" (size)
+			:
+			: "xmm0", "xmm1", "memory"
+		);
+	}
+
+	static void finish() { }
+};
+
+
+/**
+ * Copy routines based on 32-byte AVX registers
+ */
+struct Blit::Avx2
+{
+	enum { STREAM_ALIGN = 32 };
+
+	/**
+	 * Copy 32byte chunks via regular stores
+	 */
+	static void copy(char const *src, char *dst, int size)
+	{
+		asm volatile (
+			".align 16                     \n\t"
+			"0:                            \n\t"
+			"vmovdqu (%0),%%ymm0           \n\t"
+			"vmovdqu %%ymm0,(%1)           \n\t"
+			"add     $32,%0                \n\t"
+			"add     $32,%1                \n\t"
+			"dec     %2                    \n\t"
+			"jnz     0b                    \n\t"
+			: "+r" (src), "+r" (dst), "+r" (size)
+			:
+			: "xmm0", "memory"
+		);
+	}
+
+	/**
+	 * Copy 32byte chunks via non-temporal stores
+	 *
+	 * \param dst  destination address aligned to 'STREAM_ALIGN'
+	 */
+	static void stream(char const *src, char *dst, int size)
+	{
+		asm volatile (
+			".align 16                     \n\t"
+			"0:                            \n\t"
+			"vmovdqu  (%0),%%ymm0          \n\t"
+			"vmovntdq %%ymm0,(%1)          \n\t"
+			"add      $32,%0               \n\t"
+			"add      $32,%1               \n\t"
+			"dec      %2                   \n\t"
+			"jnz      0b                   \n\t"
+			: "+r" (src), "+r" (dst), "+r" (size)
+			:
+			: "xmm0", "memory"
+		);
+	}
+
+	/**
+	 * Avoid the AVX-SSE transition penalty in subsequent SSE code
+	 */
+	static void finish() { asm volatile ("vzeroupper"); }
+};
+
+
+/**
+ * Copy line of 32byte chunks via non-temporal stores
+ *
+ * Non-temporal stores require an aligned destination. If the line is not
+ * aligned, its first and last chunk are copied via regular stores that
+ * overlap with the aligned part in between.
+ */
+template <typename SIMD>
+static inline void stream_32byte_chunks(char const *src, char *dst, int size)
+{
+	unsigned long const misalign = (unsigned long)dst & (SIMD::STREAM_ALIGN - 1);
+
+	if (!misalign) {
+		SIMD::stream(src, dst, size);
+		return;
+	}
+
+	if (size < 2) {
+		SIMD::copy(src, dst, size);
+		return;
+	}
+
+	unsigned long const head = SIMD::STREAM_ALIGN - misalign;
+	unsigned long const tail = 32*(size - 1);
+
+	SIMD::copy  (src,        dst,        1);
+	SIMD::stream(src + head, dst + head, size - 1);
+	SIMD::copy  (src + tail, dst + tail, 1);
+}
+
+
+template <typename SIMD>
+static inline void copy_block_32byte(char const *src, int src_w,
+                                     char *dst, int dst_w,
+                                     int w, int h)
+{
+	bool const non_temporal = 32UL*w*h >= Blit::NON_TEMPORAL_MIN_BYTES;
+
+	if (non_temporal) {
+		for (; h--; src += src_w, dst += dst_w)
+			stream_32byte_chunks<SIMD>(src, dst, w);
+
+		/* order the weakly-ordered stores before subsequent stores */
+		asm volatile ("sfence" : : : "memory");
+
+	} else {
+		for (; h--; src += src_w, dst += dst_w)
+			SIMD::copy(src, dst, w);
+	}
+
+	SIMD::finish();
+}
+
+
+/**
+ * Copy block with a size of multiple of 32 bytes
+ *
+ * \param w  width in 32 byte chunks to copy per line
+ * \param h  number of lines of copy
+ */
+static inline void copy_block_32byte(char const *src, int src_w,
+                                     char *dst, int dst_w,
+                                     int w, int h)
+{
+	if (!w || h <= 0)
+		return;
+
+	if (Blit::avx2_usable())
+		copy_block_32byte<Blit::Avx2>(src, src_w, dst, dst_w, w, h);
+	else
+		copy_block_32byte<Blit::Sse2>(src, src_w, dst, dst_w, w, h);
+}
+
+#endif /* _LIB__BLIT__SPEC__X86_64__BLIT_HELPER_H_ */
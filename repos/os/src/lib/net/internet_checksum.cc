@@ -18,12 +18,70 @@ using namespace Net;
 using namespace Genode;
 
 
+/**
+ * Fold sum to 16-bit value
+ */
+static inline uint16_t fold(uint64_t sum)
+{
+	while (uint64_t const sum_rsh = sum >> 16)
+		sum = (sum & 0xffff) + sum_rsh;
+
+	return (uint16_t)sum;
+}
+
+
+/*
+ * The bulk of the data is added up in vectors of 32-bit lanes using the
+ * generic vector extension of the compiler. It gets translated to AVX2 or
+ * SSE2 on x86, to NEON on ARM, or to scalar code if the target has no
+ * vector unit.
+ */
+#if defined(__AVX2__)
+enum { VECTOR_SIZE = 32 };
+#else
+enum { VECTOR_SIZE = 16 };
+#endif
+
+typedef uint32_t Vector __attribute__((vector_size(VECTOR_SIZE)));
+typedef uint32_t Unaligned_vector __attribute__((vector_size(VECTOR_SIZE), aligned(2)));
+
+
+/**
+ * Add up 16-bit words as long as at least one vector is left
+ *
+ * Each 32-bit lane holds two words, which are split and added up in
+ * separate lanes with deferred carries. A lane absorbs two words per round,
+ * so the lanes get flushed to the 64-bit sum before they can overflow.
+ */
+static inline uint64_t add_up_vectors(uint16_t const *&addr, size_t &size,
+                                      uint64_t sum)
+{
+	enum { MAX_ROUNDS = 0x8000, NUM_LANES = VECTOR_SIZE / sizeof(uint32_t) };
+
+	while (size >= VECTOR_SIZE) {
+
+		Vector acc = { };
+		for (unsigned rounds = 0; size >= VECTOR_SIZE && rounds < MAX_ROUNDS;
+		     rounds++, size -= VECTOR_SIZE, addr += VECTOR_SIZE / 2)
+		{
+			Vector const v = *(Unaligned_vector const *)addr;
+			acc += (v & 0xffff) + (v >> 16);
+		}
+		for (unsigned i = 0; i < NUM_LANES; i++)
+			sum += acc[i];
+	}
+	return sum;
+}
+
+
 uint16_t Net::internet_checksum(uint16_t const *addr,
                                 size_t          size,
                                 addr_t          init_sum)
 {
-	/* add up bytes in pairs */
-	addr_t sum = init_sum;
+	/* add up the bulk of the data in vectors */
+	uint64_t sum = add_up_vectors(addr, size, init_sum);
+
+	/* add up remaining bytes in pairs */
 	for (; size > 1; size -= 2)
 		sum += *addr++;
 
@@ -31,12 +89,8 @@ uint16_t Net::internet_checksum(uint16_t const *addr,
 	if (size > 0)
 		sum += *(uint8_t *)addr;
 
-	/* fold sum to 16-bit value */
-	while (addr_t const sum_rsh = sum >> 16)
-		sum = (sum & 0xffff) + sum_rsh;
-
 	/* return one's complement */
-	return ~sum;
+	return ~fold(sum);
 }
 
 
@@ -62,3 +116,23 @@ uint16_t Net::internet_checksum_pseudo_ip(uint16_t        const *ip_data,
 	/* add up IP data bytes */
 	return internet_checksum(ip_data, ip_data_sz, sum);
 }
+
+
+/****************************
+ ** Internet_checksum_diff **
+ ****************************/
+
+void Internet_checksum_diff::add_up_diff(uint16_t const *new_data,
+                                         uint16_t const *old_data,
+                                         size_t          size)
+{
+	/* RFC 1624, eqn. 3: HC' = ~(~HC + ~m + m') */
+	for (; size > 1; size -= 2)
+		_value += (uint16_t)~*old_data++ + (uint64_t)*new_data++;
+}
+
+
+uint16_t Internet_checksum_diff::apply_to(uint16_t checksum) const
+{
+	return ~fold((uint16_t)~checksum + _value);
+}
@@ -0,0 +1,125 @@
+/*
+ * \brief  Software fallback for NIC offload features
+ * \author Genode Labs
+ * \date   2026-10-16
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <net/ethernet.h>
+#include <net/internet_checksum.h>
+#include <net/ipv4.h>
+#include <net/offload.h>
+#include <net/tcp.h>
+
+using namespace Net;
+using namespace Genode;
+
+
+bool Net::complete_checksum(void *frame, size_t size,
+                            Nic::Offload_header const &header)
+{
+	size_t const start = header.csum_start;
+	size_t const field = start + header.csum_offset;
+
+	if (start >= size || field + sizeof(uint16_t) > size)
+		return false;
+
+	/* the checksum field holds the sum of the pseudo header */
+	uint8_t * const base = (uint8_t *)frame;
+	uint16_t  const sum  = internet_checksum((uint16_t const *)(base + start),
+	                                         size - start);
+	memcpy(base + field, &sum, sizeof(sum));
+	return true;
+}
+
+
+/*********************
+ ** Tcp_super_frame **
+ *********************/
+
+Tcp_super_frame::Tcp_super_frame(void const *frame, size_t size,
+                                 Nic::Offload_header const &header)
+:
+	_frame((uint8_t const *)frame), _mss(header.gso_size)
+{
+	enum { MIN_HEADER_SIZE = 20 };
+
+	if (header.gso_type != Nic::Offload_header::GSO_TCPV4 || !_mss)
+		throw Invalid();
+
+	size_t const ip_offset = sizeof(Ethernet_frame);
+	if (size < ip_offset + MIN_HEADER_SIZE)
+		throw Invalid();
+
+	Ethernet_frame const &eth = *(Ethernet_frame const *)_frame;
+	Ipv4_packet    const &ip  = *(Ipv4_packet const *)(_frame + ip_offset);
+
+	/* more-fragments flag and fragment offset in network byte order */
+	uint8_t const *fragment_info = _frame + ip_offset + 6;
+	bool    const  fragment      = (fragment_info[0] & 0x3f) || fragment_info[1];
+
+	if (eth.type() != Ethernet_frame::Type::IPV4 ||
+	    ip.protocol() != Ipv4_packet::Protocol::TCP || fragment)
+		throw Invalid();
+
+	size_t const ip_header_size = ip.header_length() * 4;
+	size_t const ip_end         = ip_offset + ip.total_length();
+
+	_tcp_offset = ip_offset + ip_header_size;
+	if (ip_header_size < MIN_HEADER_SIZE || ip_end > size ||
+	    _tcp_offset + MIN_HEADER_SIZE > ip_end)
+		throw Invalid();
+
+	/* data offset in the upper nibble of the 13th byte of the TCP header */
+	size_t const tcp_header_size = (_frame[_tcp_offset + 12] >> 4) * 4;
+
+	_header_size = _tcp_offset + tcp_header_size;
+	if (tcp_header_size < MIN_HEADER_SIZE || _header_size > ip_end)
+		throw Invalid();
+
+	_payload_size = ip_end - _header_size;
+}
+
+
+size_t Tcp_super_frame::segment_size(unsigned i) const
+{
+	size_t const offset = (size_t)i * _mss;
+
+	return _header_size + min(_mss, _payload_size - offset);
+}
+
+
+void Tcp_super_frame::write_segment(unsigned i, void *dst) const
+{
+	size_t  const offset = (size_t)i * _mss;
+	size_t  const size   = segment_size(i);
+	uint8_t      *base   = (uint8_t *)dst;
+
+	memcpy(base, _frame, _header_size);
+	memcpy(base + _header_size, _frame + _header_size + offset,
+	       size - _header_size);
+
+	Ipv4_packet &ip = *(Ipv4_packet *)(base + sizeof(Ethernet_frame));
+	ip.total_length(size - sizeof(Ethernet_frame));
+	ip.identification((uint16_t)(ip.identification() + i));
+	ip.update_checksum();
+
+	/* FIN and PSH belong to the last segment, CWR to the first one */
+	Tcp_packet &tcp = *(Tcp_packet *)(base + _tcp_offset);
+	tcp.seq_nr(tcp.seq_nr() + (uint32_t)offset);
+	if (i + 1 < num_segments()) {
+		tcp.fin(false);
+		tcp.psh(false);
+	}
+	if (i > 0)
+		tcp.crw(false);
+
+	tcp.update_checksum(ip.src(), ip.dst(), size - _tcp_offset);
+}
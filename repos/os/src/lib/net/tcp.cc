@@ -47,3 +47,9 @@ void Net::Tcp_packet::update_checksum(Ipv4_address ip_src,
 	                                        host_to_big_endian((uint16_t)tcp_size),
 	                                        Ipv4_packet::Protocol::TCP, ip_src, ip_dst);
 }
+
+
+void Net::Tcp_packet::update_checksum(Internet_checksum_diff const &icd)
+{
+	_checksum = icd.apply_to(_checksum);
+}
@@ -41,6 +41,18 @@ void Net::Udp_packet::update_checksum(Ipv4_address ip_src,
 }
 
 
+void Net::Udp_packet::update_checksum(Internet_checksum_diff const &icd)
+{
+	if (!_checksum) {
+		return; }
+
+	/* a computed checksum of zero is transmitted as all ones (RFC 768) */
+	_checksum = icd.apply_to(_checksum);
+	if (!_checksum) {
+		_checksum = ~(uint16_t)0; }
+}
+
+
 bool Net::Udp_packet::checksum_error(Ipv4_address ip_src,
                                      Ipv4_address ip_dst) const
 {
@@ -0,0 +1,41 @@
+#include <trace/policy.h>
+#include <trace/binary_record.h>
+
+using namespace Genode;
+
+typedef Trace::Binary_record Record;
+
+size_t max_event_size()
+{
+	return Record::max_size();
+}
+
+size_t rpc_call(char *dst, char const *rpc_name, Msgbuf_base const &)
+{
+	return Record::write(dst, Record::RPC_CALL, 0, rpc_name);
+}
+
+size_t rpc_returned(char *dst, char const *rpc_name, Msgbuf_base const &)
+{
+	return Record::write(dst, Record::RPC_RETURNED, 0, rpc_name);
+}
+
+size_t rpc_dispatch(char *dst, char const *rpc_name)
+{
+	return Record::write(dst, Record::RPC_DISPATCH, 0, rpc_name);
+}
+
+size_t rpc_reply(char *dst, char const *rpc_name)
+{
+	return Record::write(dst, Record::RPC_REPLY, 0, rpc_name);
+}
+
+size_t signal_submit(char *dst, unsigned const num)
+{
+	return Record::write(dst, Record::SIGNAL_SUBMIT, num, nullptr);
+}
+
+size_t signal_receive(char *dst, Signal_context const &, unsigned num)
+{
+	return Record::write(dst, Record::SIGNAL_RECEIVED, num, nullptr);
+}
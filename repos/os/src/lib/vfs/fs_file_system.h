@@ -46,6 +46,11 @@ class Vfs::Fs_file_system : public File_system
 		typedef Genode::String<::File_system::MAX_NAME_LEN> Root_string;
 		Root_string _root;
 
+		enum { MAX_QUEUE_DEPTH = 8 };
+
+		/* number of read packets kept in flight per file handle */
+		unsigned const _queue_depth;
+
 		::File_system::Connection _fs;
 
 		typedef Genode::Id_space<::File_system::Node> Handle_space;
@@ -175,6 +180,19 @@ class Vfs::Fs_file_system : public File_system
 				return READ_ERR_INVALID;
 			}
 
+			/**
+			 * Take acknowledged read packet if it belongs to the read ahead
+			 */
+			virtual bool read_ahead_acked(::File_system::Packet_descriptor const &) {
+				return false; }
+
+			virtual bool read_ahead_in_flight() const { return false; }
+
+			/**
+			 * Drop the read ahead, e.g., because the file gets modified
+			 */
+			virtual void discard_read_ahead() { }
+
 			bool queue_sync()
 			{
 				if (queued_sync_state != Handle_state::Queued_state::IDLE)
@@ -227,19 +245,196 @@ class Vfs::Fs_file_system : public File_system
 			}
 		};
 
+		/**
+		 * File handle that keeps several read packets in flight
+		 *
+		 * With a queue depth greater than one, the handle reads ahead of
+		 * the seek offset in packets of equal size. A read is served from
+		 * the packet that continues at the seek offset. Packets that do not
+		 * match the seek offset anymore are dropped, or marked as stale
+		 * while still in flight.
+		 */
 		struct Fs_vfs_file_handle : Fs_vfs_handle
 		{
-			using Fs_vfs_handle::Fs_vfs_handle;
+			struct Read_packet
+			{
+				enum class State { FREE, QUEUED, ACK };
+
+				State     state    = State::FREE;
+				bool      stale    = false;
+				file_size position = 0;
+				file_size size     = 0;   /* requested bytes */
+				file_size consumed = 0;   /* bytes passed to the reader */
+
+				::File_system::Packet_descriptor packet { };
+
+				file_size next() const { return position + consumed; }
+				file_size end()  const { return position + size; }
+			};
+
+			unsigned const _queue_depth;
+
+			Read_packet _read_packets[MAX_QUEUE_DEPTH] { };
+
+			Fs_vfs_file_handle(File_system &fs, Allocator &alloc,
+			                   int status_flags, Handle_space &space,
+			                   ::File_system::Node_handle node_handle,
+			                   ::File_system::Connection &fs_connection,
+			                   unsigned queue_depth)
+			:
+				Fs_vfs_handle(fs, alloc, status_flags, space, node_handle,
+				              fs_connection),
+				_queue_depth(queue_depth)
+			{ }
+
+			void _release(Read_packet &p)
+			{
+				_fs.tx()->release_packet(p.packet);
+				p = Read_packet();
+			}
+
+			void _release_stale()
+			{
+				for (Read_packet &p : _read_packets)
+					if (p.stale && p.state == Read_packet::State::ACK)
+						_release(p);
+			}
+
+			Read_packet *_packet_at(file_size const position)
+			{
+				for (Read_packet &p : _read_packets)
+					if (p.state != Read_packet::State::FREE && !p.stale
+					 && p.next() == position)
+						return &p;
+				return nullptr;
+			}
 
 			bool queue_read(file_size count) override
 			{
-				return _queue_read(count, seek());
+				if (_queue_depth <= 1)
+					return _queue_read(count, seek());
+
+				_release_stale();
+
+				file_size const position = seek();
+
+				if (!_packet_at(position))
+					discard_read_ahead();
+
+				/* continue the read ahead after the last packet */
+				file_size next = position;
+				unsigned  used = 0;
+				for (Read_packet const &p : _read_packets) {
+					if (p.state == Read_packet::State::FREE)
+						continue;
+					used++;
+					if (!p.stale)
+						next = Genode::max(next, p.end());
+				}
+
+				::File_system::Session::Tx::Source &source = *_fs.tx();
+
+				file_size const size = source.bulk_buffer_size() / (2*_queue_depth);
+
+				for (Read_packet &p : _read_packets) {
+
+					if (used >= _queue_depth || !source.ready_to_submit())
+						break;
+
+					if (p.state != Read_packet::State::FREE)
+						continue;
+
+					try {
+						p.packet = ::File_system::Packet_descriptor(
+							source.alloc_packet(size), file_handle(),
+							::File_system::Packet_descriptor::READ, size, next);
+					} catch (::File_system::Session::Tx::Source::Packet_alloc_failed) {
+						break;
+					}
+
+					p.state    = Read_packet::State::QUEUED;
+					p.position = next;
+					p.size     = size;
+
+					source.submit_packet(p.packet);
+
+					next += size;
+					used++;
+				}
+
+				if (!_packet_at(position))
+					return false;
+
+				read_ready_state = Fs_file_system::Handle_state::Read_ready_state::IDLE;
+				return true;
 			}
 
 			Read_result complete_read(char *dst, file_size count,
 			                          file_size &out_count) override
 			{
-				return _complete_read(dst, count, out_count);
+				if (_queue_depth <= 1)
+					return _complete_read(dst, count, out_count);
+
+				_release_stale();
+
+				Read_packet *p = _packet_at(seek());
+				if (!p)
+					return READ_ERR_INVALID;
+
+				if (p->state != Read_packet::State::ACK)
+					return READ_QUEUED;
+
+				file_size const length = p->packet.length();
+				file_size const n = length > p->consumed
+				                  ? min(length - p->consumed, count) : 0;
+
+				memcpy(dst, _fs.tx()->packet_content(p->packet) + p->consumed, n);
+
+				p->consumed += n;
+				out_count    = n;
+
+				if (p->consumed < length)
+					return READ_OK;
+
+				/* a short packet marks the end of the file */
+				bool const end_of_file = length < p->size;
+
+				_release(*p);
+
+				if (end_of_file)
+					discard_read_ahead();
+
+				return READ_OK;
+			}
+
+			bool read_ahead_acked(::File_system::Packet_descriptor const &packet) override
+			{
+				for (Read_packet &p : _read_packets)
+					if (p.state == Read_packet::State::QUEUED
+					 && p.packet.offset() == packet.offset()) {
+						p.packet = packet;
+						p.state  = Read_packet::State::ACK;
+						return true;
+					}
+				return false;
+			}
+
+			bool read_ahead_in_flight() const override
+			{
+				for (Read_packet const &p : _read_packets)
+					if (p.state == Read_packet::State::QUEUED)
+						return true;
+				return false;
+			}
+
+			void discard_read_ahead() override
+			{
+				for (Read_packet &p : _read_packets) {
+					if (p.state == Read_packet::State::ACK)
+						_release(p);
+					else if (p.state == Read_packet::State::QUEUED)
+						p.stale = true;
+				}
 			}
 		};
 
@@ -495,6 +690,10 @@ class Vfs::Fs_file_system : public File_system
 						break;
 
 					case Packet_descriptor::READ:
+						if (handle.read_ahead_acked(packet)) {
+							handle.io_progress_response();
+							break;
+						}
 						handle.queued_read_packet = packet;
 						handle.queued_read_state  = Handle_state::Queued_state::ACK;
 						handle.io_progress_response();
@@ -566,10 +765,12 @@ class Vfs::Fs_file_system : public File_system
 			_env(env),
 			_label(config.attribute_value("label", Label_string())),
 			_root( config.attribute_value("root",  Root_string())),
+			_queue_depth(Genode::max(1U, Genode::min((unsigned)MAX_QUEUE_DEPTH,
+			             config.attribute_value("queue_depth", 1U)))),
 			_fs(_env.env(), _fs_packet_alloc,
 			    _label.string(), _root.string(),
 			    config.attribute_value("writeable", true),
-			    buffer_size(config))
+			    buffer_size(config), _queue_depth)
 		{
 			_fs.sigh_ack_avail(_ack_handler);
 			_fs.sigh_ready_to_submit(_ready_handler);
@@ -761,7 +962,8 @@ class Vfs::Fs_file_system : public File_system
 				                                           mode, create);
 
 				*out_handle = new (alloc)
-					Fs_vfs_file_handle(*this, alloc, vfs_mode, _handle_space, file, _fs);
+					Fs_vfs_file_handle(*this, alloc, vfs_mode, _handle_space, file,
+					                   _fs, _queue_depth);
 			}
 			catch (::File_system::Lookup_failed)       { return OPEN_ERR_UNACCESSIBLE;  }
 			catch (::File_system::Permission_denied)   { return OPEN_ERR_NO_PERM;       }
@@ -846,9 +1048,16 @@ class Vfs::Fs_file_system : public File_system
 
 		void close(Vfs_handle *vfs_handle) override
 		{
+			Fs_vfs_handle *fs_handle = static_cast<Fs_vfs_handle *>(vfs_handle);
+
+			/* acknowledgements of the read ahead refer to the handle */
+			while (fs_handle->read_ahead_in_flight())
+				_env.env().ep().wait_and_dispatch_one_io_signal();
+
 			Lock::Guard guard(_lock);
 
-			Fs_vfs_handle *fs_handle = static_cast<Fs_vfs_handle *>(vfs_handle);
+			fs_handle->discard_read_ahead();
+
 			if (fs_handle->enqueued())
 				_congested_handles.remove(*fs_handle);
 
@@ -911,6 +1120,9 @@ class Vfs::Fs_file_system : public File_system
 
 			Fs_vfs_handle &handle = static_cast<Fs_vfs_handle &>(*vfs_handle);
 
+			/* data read ahead may be outdated by the write */
+			handle.discard_read_ahead();
+
 			out_count = _write(handle, buf, buf_size, handle.seek());
 			return WRITE_OK;
 		}
@@ -118,7 +118,10 @@ namespace Cache {
 		private:
 
 			char        _data[CHUNK_SIZE];
-			unsigned    _writes;
+			bool        _populated;  /* content is valid */
+			bool        _dirty;      /* content differs from backend device */
+			bool        _syncing;    /* write-back in flight */
+			bool        _rewritten;  /* modified since write-back started */
 
 		public:
 
@@ -136,12 +139,15 @@ namespace Cache {
 			 * of 'Chunk_index'.
 			 */
 			Chunk(Genode::Allocator &, offset_t base_offset, Chunk_base *p)
-			: Chunk_base(base_offset, p), _writes(0) { }
+			: Chunk_base(base_offset, p), _populated(false), _dirty(false),
+			  _syncing(false), _rewritten(false) { }
 
 			/**
 			 * Construct zero chunk
 			 */
-			Chunk() : _writes(0) { }
+			Chunk()
+			: _populated(false), _dirty(false), _syncing(false),
+			  _rewritten(false) { }
 
 			/**
 			 * Return number of used entries
@@ -152,6 +158,48 @@ namespace Cache {
 			 */
 			size_t used_size() const { return _num_entries; }
 
+			/**
+			 * Return true if the chunk has modifications not yet written
+			 * back to the backend device
+			 */
+			bool dirty() const { return _dirty; }
+
+			/**
+			 * Return true if a write-back of the chunk is in flight
+			 */
+			bool syncing() const { return _syncing; }
+
+			/**
+			 * Return content of the chunk
+			 */
+			char const *data() const { return _data; }
+
+			/**
+			 * Mark write-back of the chunk as submitted to the backend device
+			 */
+			void sync_submitted()
+			{
+				_syncing   = true;
+				_rewritten = false;
+			}
+
+			/**
+			 * Account acknowledgement of a write-back by the backend device
+			 *
+			 * The chunk becomes clean only if the write succeeded and the
+			 * chunk was not modified while the write was in flight.
+			 */
+			void synced(size_t, offset_t, bool success)
+			{
+				if (zero() || !_syncing)
+					return;
+
+				if (success && !_rewritten)
+					_dirty = false;
+
+				_syncing = false;
+			}
+
 			void write(char const *src, size_t len, offset_t seek_offset)
 			{
 				assert_valid_range(seek_offset, len, SIZE);
@@ -165,7 +213,33 @@ namespace Cache {
 
 				_num_entries = Genode::max(_num_entries, local_offset + len);
 
-				_writes++;
+				_populated = true;
+				_dirty     = true;
+				_rewritten = true;
+			}
+
+			/**
+			 * Populate chunk with content read from the backend device
+			 *
+			 * A chunk that is already populated keeps its content because
+			 * it may have been modified in the meantime.
+			 */
+			void fill(char const *src, size_t len, offset_t seek_offset)
+			{
+				if (zero() || _populated)
+					return;
+
+				assert_valid_range(seek_offset, len, SIZE);
+
+				POLICY::write(this);
+
+				offset_t const local_offset = seek_offset - base_offset();
+
+				Genode::memcpy(&_data[local_offset], src, len);
+
+				_num_entries = Genode::max(_num_entries, local_offset + len);
+
+				_populated = true;
 			}
 
 			void read(char *dst, size_t len, offset_t seek_offset) const
@@ -181,18 +255,19 @@ namespace Cache {
 			{
 				assert_valid_range(seek_offset, len, SIZE);
 
-				if (_writes == 0)
+				if (!_populated)
 					throw Range_incomplete(base_offset(), SIZE);
 			}
 
 			void sync(size_t len, offset_t seek_offset)
 			{
-				if (_writes > 1) {
+				if (_dirty && !_syncing)
 					POLICY::sync(this, (char*)_data);
-					_writes = 1;
-				}
 			}
 
+			template <typename FN>
+			void for_each_chunk(FN const &fn) { fn(*this); }
+
 			void alloc(size_t len, offset_t seek_offset) { }
 
 			void truncate(size_t size)
@@ -215,7 +290,7 @@ namespace Cache {
 
 			void free(size_t, offset_t)
 			{
-				if (_writes > 1) throw Dirty_chunk(_base_offset, SIZE);
+				if (_dirty) throw Dirty_chunk(_base_offset, SIZE);
 
 				_num_entries = 0;
 				if (_parent) _parent->free(SIZE, _base_offset);
@@ -433,6 +508,38 @@ namespace Cache {
 					entry.stat(len, seek_offset); }
 			};
 
+			struct Fill_func
+			{
+				typedef ENTRY_TYPE Entry;
+
+				/* chunks evicted meanwhile are skipped via the zero chunk */
+				static Entry &lookup(Chunk_index const &chunk, unsigned i) {
+					return chunk._entry_for_syncing(i); }
+
+				void operator () (Entry &entry, char const *src, size_t len,
+				                  offset_t seek_offset) const
+				{
+					entry.fill(src, len, seek_offset);
+				}
+			};
+
+			struct Synced_func
+			{
+				typedef ENTRY_TYPE Entry;
+
+				bool const success;
+
+				/* chunks evicted meanwhile are skipped via the zero chunk */
+				static Entry &lookup(Chunk_index const &chunk, unsigned i) {
+					return chunk._entry_for_syncing(i); }
+
+				void operator () (Entry &entry, char*, size_t len,
+				                  offset_t seek_offset) const
+				{
+					entry.synced(len, seek_offset, success);
+				}
+			};
+
 			struct Sync_func
 			{
 				typedef ENTRY_TYPE Entry;
@@ -515,6 +622,24 @@ namespace Cache {
 			void write(char const *src, size_t len, offset_t seek_offset) {
 				_range_op(*this, src, len, seek_offset, Write_func()); }
 
+			/**
+			 * Populate chunks with content read from the backend device
+			 */
+			void fill(char const *src, size_t len, offset_t seek_offset) {
+				if (zero()) return;
+				_range_op(*this, src, len, seek_offset, Fill_func()); }
+
+			/**
+			 * Call 'fn' for each allocated leaf chunk in ascending order
+			 */
+			template <typename FN>
+			void for_each_chunk(FN const &fn)
+			{
+				for (unsigned i = 0; i < _num_entries; i++)
+					if (_entries[i])
+						_entries[i]->for_each_chunk(fn);
+			}
+
 			/**
 			 * Allocate needed chunks
 			 */
@@ -540,6 +665,13 @@ namespace Cache {
 				if (zero()) return;
 				_range_op(*this, (char*)0, len, seek_offset, Sync_func()); }
 
+			/**
+			 * Account acknowledgement of write-back by the backend device
+			 */
+			void synced(size_t len, offset_t seek_offset, bool success) {
+				if (zero()) return;
+				_range_op(*this, (char*)0, len, seek_offset, Synced_func { success }); }
+
 			/**
 			 * Free chunks
 			 */
@@ -0,0 +1,111 @@
+/*
+ * \brief  CLOCK cache replacement strategy
+ * \author Genode Labs
+ * \date   2026-10-15
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include "clock.h"
+#include "driver.h"
+
+typedef Driver<Clock_policy>::Chunk_level_4 Chunk;
+typedef Clock_policy::Element               Element;
+
+static Policy_list<Element> ring;
+static Element             *hand = nullptr;
+
+
+/**
+ * Return element following 'e' on the clock face
+ */
+static Element *clock_next(Element const &e)
+{
+	Element *next = ring.next(e);
+	return next ? next : ring.first();
+}
+
+
+static void clock_access(const Element *e)
+{
+	Element &elem = *const_cast<Element *>(e);
+
+	/*
+	 * New chunks are placed right behind the hand, i.e., they are visited
+	 * last by the sweeping hand.
+	 */
+	if (!elem.linked()) {
+		if (hand) ring.insert_before(elem, *hand);
+		else {
+			ring.enqueue(elem);
+			hand = &elem;
+		}
+		return;
+	}
+
+	elem.referenced = true;
+}
+
+
+void Clock_policy::read(const Element *e) {
+	clock_access(e); }
+
+
+void Clock_policy::write(const Element *e) {
+	clock_access(e); }
+
+
+void Clock_policy::release(const Element *e)
+{
+	Element &elem = *const_cast<Element *>(e);
+
+	if (!elem.linked())
+		return;
+
+	if (hand == &elem)
+		hand = (ring.count() > 1) ? clock_next(elem) : nullptr;
+
+	ring.remove(elem);
+	elem.referenced = false;
+}
+
+
+void Clock_policy::flush(Cache::size_t size)
+{
+	Cache::size_t s = 0;
+
+	/*
+	 * Each chunk is visited at most twice, once for clearing its reference
+	 * bit and once for evicting it.
+	 */
+	unsigned long steps = 2*ring.count();
+
+	while (hand && steps-- && ((size == 0) || (s < size))) {
+
+		Chunk *cb = static_cast<Chunk*>(hand);
+
+		if (hand->referenced && size) {
+			hand->referenced = false;
+			hand = clock_next(*hand);
+			continue;
+		}
+
+		/* dirty chunks are written back asynchronously and evicted later */
+		if (cb->dirty()) {
+			Write_back::schedule(*cb);
+			hand = clock_next(*hand);
+			continue;
+		}
+
+		release(cb);
+		cb->free(Driver<Clock_policy>::CACHE_BLK_SIZE, cb->base_offset());
+		s += sizeof(Chunk);
+	}
+
+	if (s < size) throw Block::Driver::Request_congestion();
+}
@@ -0,0 +1,48 @@
+/*
+ * \brief  CLOCK cache replacement strategy
+ * \author Genode Labs
+ * \date   2026-10-15
+ *
+ * The CLOCK strategy approximates LRU. A cache hit merely sets the
+ * reference bit of the chunk without relinking any list. On eviction, the
+ * clock hand sweeps over the chunks, clears set reference bits, and evicts
+ * the first chunk found unreferenced.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _CLOCK_H_
+#define _CLOCK_H_
+
+#include "chunk.h"
+#include "policy_list.h"
+#include "write_back.h"
+
+struct Clock_policy
+{
+	class Element : public Policy_list<Element>::Element,
+	                public Write_back::Element
+	{
+		public:
+
+			bool referenced = false;
+
+		protected:
+
+			~Element() { Clock_policy::release(this); }
+	};
+
+	static char const *name() { return "clock"; }
+
+	static void read(const Element  *e);
+	static void write(const Element *e);
+	static void release(const Element *e);
+	static void flush(Cache::size_t size = 0);
+};
+
+#endif /* _CLOCK_H_ */
@@ -15,8 +15,24 @@
 #include <block_session/connection.h>
 #include <block/component.h>
 #include <os/packet_allocator.h>
+#include <os/reporter.h>
+#include <os/ring_buffer.h>
+#include <timer_session/connection.h>
 
 #include "chunk.h"
+#include "write_back.h"
+
+
+/**
+ * Tunables of the cache driver
+ */
+struct Driver_config
+{
+	bool           report;           /* report cache statistics */
+	Genode::size_t read_ahead_max;   /* maximum read-ahead window in bytes */
+	unsigned       write_behind_ms;  /* write-behind period, 0 disables */
+};
+
 
 /**
  * Cache driver used by the generic block driver framework
@@ -31,6 +47,9 @@ class Driver : public Block::Driver
 		/**
 		 * This class encapsulates requests to the backend device in progress,
 		 * and the packets from the client side that triggered the request.
+		 *
+		 * Read-ahead requests are not triggered by a client packet. They
+		 * are marked by an invalid buffer.
 		 */
 		struct Request : public Genode::List<Request>::Element
 		{
@@ -75,6 +94,27 @@ class Driver : public Block::Driver
 		};
 
 
+		/**
+		 * Client request that could not be processed because the cache
+		 * is congested, e.g., when all evictable chunks are dirty
+		 *
+		 * Deferred requests are replayed once the backend device made
+		 * progress. The number of deferred requests is bounded by the
+		 * packets a client can have in flight.
+		 */
+		struct Deferred
+		{
+			Block::Packet_descriptor cli    { };
+			char                    *buffer { nullptr };
+		};
+
+		enum { MAX_DEFERRED = Block::Session::TX_QUEUE_SIZE };
+
+		typedef Genode::Ring_buffer<Deferred, MAX_DEFERRED + 1,
+		                            Genode::Ring_buffer_unsynchronized>
+		        Deferred_queue;
+
+
 		/**
 		 * Write failed exception at a specific device offset,
 		 * can be triggered whenever the backend device is not ready
@@ -99,7 +139,10 @@ class Driver : public Block::Driver
 
 		enum {
 			SLAB_SZ = Block::Session::TX_QUEUE_SIZE*sizeof(Request),
-			CACHE_BLK_SIZE = 4096
+			CACHE_BLK_SIZE = 4096,
+			REPORT_INTERVAL = 1024, /* number of read requests per report */
+			BUFFER_SIZE = Block::Session::TX_QUEUE_SIZE*CACHE_BLK_SIZE,
+			MAX_WRITE_CHUNKS = 64   /* chunks coalesced per write request */
 		};
 
 		/**
@@ -117,13 +160,31 @@ class Driver : public Block::Driver
 		Genode::Env                      &_env;
 		Genode::Tslab<Request, SLAB_SZ>   _r_slab;    /* slab for requests  */
 		Genode::List<Request>             _r_list;    /* list of requests   */
+		Deferred_queue                    _deferred;  /* congested requests */
 		Genode::Packet_allocator          _alloc;     /* packet allocator   */
 		Block::Connection<>               _blk;       /* backend device     */
 		Block::Session::Info        const _info;      /* block-device info  */
 		Chunk_level_0                     _cache;     /* chunk hierarchy    */
 		Genode::Io_signal_handler<Driver> _source_ack;
 		Genode::Io_signal_handler<Driver> _source_submit;
+		Genode::Io_signal_handler<Driver> _write_back_handler;
 		Genode::Io_signal_handler<Driver> _yield;
+		Genode::Reporter                  _reporter;  /* cache statistics */
+		Genode::uint64_t                  _hits   = 0;
+		Genode::uint64_t                  _misses = 0;
+		unsigned                          _writes_in_flight = 0;
+		bool                              _write_failed     = false;
+
+		Genode::Constructible<Timer::Connection> _timer { };
+		Genode::Io_signal_handler<Driver>        _write_behind_handler;
+
+		/*
+		 * Sequential-stream detection for read-ahead
+		 */
+		Genode::size_t  const _ra_max;          /* maximum window in blocks */
+		Genode::size_t        _ra_window   = 0; /* current window in blocks */
+		Block::sector_t       _stream_next = 0; /* block expected next */
+		Block::sector_t       _ra_end      = 0; /* end of issued read-ahead */
 
 		Driver(Driver const&);            /* singleton pattern */
 		Driver& operator=(Driver const&); /* singleton pattern */
@@ -148,26 +209,99 @@ class Driver : public Block::Driver
 			       : nr; }
 
 		/*
-		 * Handle response to a single request
+		 * Process client request within the cache
 		 *
-		 * \param srv  packet received from the backend device
-		 * \param r    outstanding request
+		 * \throw Request_congestion
+		 * \throw Io_error
 		 */
-		inline void _handle_reply(Block::Packet_descriptor &srv, Request *r)
+		void _process(Block::Packet_descriptor &cli, char * const buffer)
 		{
-			try {
-			if (r->cli.operation() == Block::Packet_descriptor::READ)
-				read(r->cli.block_number(), r->cli.block_count(),
-				     r->buffer, r->cli);
+			if (cli.operation() == Block::Packet_descriptor::READ)
+				_read(cli.block_number(), cli.block_count(), buffer, cli);
 			else
-				write(r->cli.block_number(), r->cli.block_count(),
-				      r->buffer, r->cli);
-			} catch(Block::Driver::Request_congestion) {
-				Genode::warning("cli (", r->cli.block_number(), " ",
-				                         r->cli.block_count(), ") "
-				                "srv (", r->srv.block_number(), " ",
-				                         r->srv.block_count(), ")");
+				_write(cli.block_number(), cli.block_count(), buffer, cli);
+		}
+
+		/*
+		 * Return true if no request to the backend device is outstanding
+		 *
+		 * In this case, nothing will ever resume a congested request.
+		 */
+		bool _stalled()
+		{
+			return !_r_list.first() && !_writes_in_flight
+			    && !Write_back::pending();
+		}
+
+		/*
+		 * Defer congested client request until the backend device made
+		 * progress
+		 *
+		 * The client session resumes a congested driver only when the
+		 * driver acknowledges a packet. Hence, instead of propagating the
+		 * congestion to the session, the request is kept by the driver.
+		 *
+		 * \throw Io_error  cache is congested without any outstanding
+		 *                  backend request
+		 */
+		void _defer(Block::Packet_descriptor &cli, char * const buffer)
+		{
+			if (_stalled()) {
+				Genode::error("cache congested without pending write-back");
+				throw Io_error();
 			}
+
+			_deferred.add(Deferred { cli, buffer });
+		}
+
+		/*
+		 * Replay deferred client requests in the order of their arrival
+		 */
+		void _replay()
+		{
+			bool congested = false;
+
+			for (int n = MAX_DEFERRED - _deferred.avail_capacity(); n > 0; n--) {
+
+				Deferred d = _deferred.get();
+
+				if (!congested) {
+					try {
+						_process(d.cli, d.buffer);
+						continue;
+					}
+					catch (Request_congestion) { congested = true; }
+					catch (Io_error) {
+						ack_packet(d.cli, false);
+						continue;
+					}
+
+					if (_stalled()) {
+						Genode::error("cache congested without pending write-back");
+						ack_packet(d.cli, false);
+						continue;
+					}
+				}
+
+				_deferred.add(d);
+			}
+		}
+
+		/*
+		 * Handle response to a single request
+		 *
+		 * \param r  outstanding request
+		 */
+		inline void _handle_reply(Request *r)
+		{
+			/* read-ahead request */
+			if (!r->buffer)
+				return;
+
+			try {
+				try { _process(r->cli, r->buffer); }
+				catch (Request_congestion) { _defer(r->cli, r->buffer); }
+			} catch (Io_error) { ack_packet(r->cli, false); }
 		}
 
 		/*
@@ -178,31 +312,89 @@ class Driver : public Block::Driver
 			while (_blk.tx()->ack_avail()) {
 				Block::Packet_descriptor p = _blk.tx()->get_acked_packet();
 
-				/* when reading, write result into cache */
+				/* when reading, fill result into cache */
 				if (p.operation() == Block::Packet_descriptor::READ)
-					_cache.write(_blk.tx()->packet_content(p),
-					             p.block_count() * _info.block_size,
-					             p.block_number() * _info.block_size);
+					_cache.fill(_blk.tx()->packet_content(p),
+					            p.block_count() * _info.block_size,
+					            p.block_number() * _info.block_size);
+
+				/* written chunks become clean not before the device acked */
+				if (p.operation() == Block::Packet_descriptor::WRITE) {
+					_writes_in_flight--;
+					_cache.synced(p.block_count() * _info.block_size,
+					              p.block_number() * _info.block_size,
+					              p.succeeded());
+					if (!p.succeeded()) {
+						Genode::error("write-back of blocks ", p.block_number(),
+						              "+", p.block_count(), " failed");
+						_write_failed = true;
+					}
+				}
 
 				/* loop through the list of requests, and ack all related */
 				for (Request *r = _r_list.first(), *r_to_handle = r; r;
 				     r_to_handle = r) {
 					r = r->next();
 					if (r_to_handle->match(p)) {
-						_handle_reply(p, r_to_handle);
 						_r_list.remove(r_to_handle);
+						_handle_reply(r_to_handle);
 						Genode::destroy(&_r_slab, r_to_handle);
 					}
 				}
 
 				_blk.tx()->release_packet(p);
 			}
+
+			_write_back();
+			_replay();
 		}
 
 		/*
 		 * Handle that the backend device is ready to receive again
 		 */
-		void _ready_to_submit() { }
+		void _ready_to_submit()
+		{
+			_write_back();
+			_replay();
+		}
+
+		/*
+		 * Write back dirty chunks evicted by the replacement policy
+		 *
+		 * The chunks are submitted as one batch as long as the backend
+		 * device accepts requests. The device is signalled once per batch.
+		 */
+		void _write_back()
+		{
+			Write_back::process([&] (Write_back::Element &e) {
+				Chunk_level_4 &chunk = static_cast<Chunk_level_4 &>(e);
+				try {
+					chunk.sync(CACHE_BLK_SIZE, chunk.base_offset());
+					return true;
+				} catch (Write_failed) { return false; }
+			});
+
+			_blk.tx()->wakeup();
+		}
+
+		/*
+		 * Report cache statistics
+		 */
+		void _report()
+		{
+			if (!_reporter.enabled())
+				return;
+
+			Genode::uint64_t const total = _hits + _misses;
+
+			Genode::Reporter::Xml_generator xml(_reporter, [&] () {
+				xml.attribute("policy",     POLICY::name());
+				xml.attribute("hits",       _hits);
+				xml.attribute("misses",     _misses);
+				xml.attribute("hit_ratio",  total ? (100*_hits)/total : 0);
+				xml.attribute("write_back", Write_back::pending());
+			});
+		}
 
 		/*
 		 * Setup a request to the backend device
@@ -258,8 +450,186 @@ class Driver : public Block::Driver
 			}
 		}
 
+		/*
+		 * Return true if the cache block containing block 'nr' is populated
+		 */
+		bool _cached(Block::sector_t nr)
+		{
+			try {
+				_cache.stat(_info.block_size, nr * _info.block_size);
+				return true;
+			} catch (Cache::Chunk_base::Range_incomplete) { }
+			return false;
+		}
+
+		/*
+		 * Return true if a request to the backend device covers block 'nr'
+		 */
+		bool _pending(Block::sector_t nr)
+		{
+			for (Request *r = _r_list.first(); r; r = r->next())
+				if (r->match(false, nr, 1))
+					return true;
+			return false;
+		}
+
+		/*
+		 * Issue read-ahead request for the first uncached range within
+		 * the blocks 'from' to 'to'
+		 *
+		 * Read-ahead is opportunistic. If the backend device or the cache
+		 * is congested, no request is issued.
+		 */
+		void _read_ahead(Block::sector_t from, Block::sector_t to)
+		{
+			Block::sector_t const mod = _cache_blk_mod();
+
+			from = _cache_blk_round_off(from);
+			to   = Genode::min(_cache_blk_round_up(to),
+			                   (Block::sector_t)_info.block_count);
+
+			while (from < to && (_cached(from) || _pending(from)))
+				from += mod;
+
+			Block::sector_t end = from;
+			while (end < to && !_cached(end) && !_pending(end))
+				end += mod;
+
+			end = Genode::min(end, (Block::sector_t)_info.block_count);
+
+			if (from >= end) {
+				_ra_end = Genode::max(_ra_end, to);
+				return;
+			}
+
+			if (!_blk.tx()->ready_to_submit())
+				return;
+
+			Genode::size_t const cnt = end - from;
+
+			try {
+				_cache.alloc(cnt * _info.block_size, from * _info.block_size);
+
+				Block::Packet_descriptor p(_blk.alloc_packet(cnt * _info.block_size),
+				                           Block::Packet_descriptor::READ,
+				                           from, cnt);
+				Block::Packet_descriptor no_client { };
+
+				_r_list.insert(new (&_r_slab) Request(p, no_client, nullptr));
+				_blk.tx()->submit_packet(p);
+				_ra_end = end;
+			}
+			catch (Block::Session::Tx::Source::Packet_alloc_failed) { }
+			catch (Request_congestion) { }
+			catch (Genode::Allocator::Out_of_memory) { }
+		}
+
+		/*
+		 * Track sequential read stream and grow read-ahead window
+		 *
+		 * The window doubles with each sequential request up to the
+		 * configured maximum and collapses on any non-sequential request.
+		 */
+		void _track_stream(Block::sector_t nr, Genode::size_t cnt)
+		{
+			if (!_ra_max)
+				return;
+
+			bool const sequential = (nr == _stream_next);
+
+			_stream_next = nr + cnt;
+
+			if (!sequential) {
+				_ra_window = 0;
+				_ra_end    = 0;
+				return;
+			}
+
+			_ra_window = Genode::min(_ra_max, Genode::max(2*_ra_window, cnt));
+
+			_read_ahead(Genode::max(_ra_end, _stream_next),
+			            _stream_next + _ra_window);
+		}
+
+		/*
+		 * Submit one write request covering 'n' adjacent chunks
+		 *
+		 * \return false if the backend device cannot take the request
+		 */
+		bool _submit_write(Chunk_level_4 **chunks, unsigned n)
+		{
+			if (!_blk.tx()->ready_to_submit())
+				return false;
+
+			Genode::size_t  const size = n * CACHE_BLK_SIZE;
+			Cache::offset_t const off  = chunks[0]->base_offset();
+
+			try {
+				Block::Packet_descriptor
+					p(_blk.alloc_packet(size), Block::Packet_descriptor::WRITE,
+					  off / _info.block_size, size / _info.block_size);
+
+				char * const dst = _blk.tx()->packet_content(p);
+				for (unsigned i = 0; i < n; i++) {
+					Genode::memcpy(dst + i*CACHE_BLK_SIZE, chunks[i]->data(),
+					               CACHE_BLK_SIZE);
+					chunks[i]->sync_submitted();
+				}
+				_blk.tx()->try_submit_packet(p);
+				_writes_in_flight++;
+			} catch (Block::Session::Tx::Source::Packet_alloc_failed) {
+				return false; }
+
+			return true;
+		}
+
+		/*
+		 * Write back dirty chunks periodically
+		 *
+		 * Adjacent dirty chunks are coalesced into multi-block write
+		 * requests. Chunks that cannot be submitted because of congestion
+		 * or whose write-back failed stay dirty until the next period.
+		 */
+		void _write_behind()
+		{
+			Chunk_level_4 *run[MAX_WRITE_CHUNKS];
+			unsigned       n         = 0;
+			bool           congested = false;
+
+			auto submit_run = [&] () {
+				if (n && !congested)
+					congested = !_submit_write(run, n);
+				n = 0;
+			};
+
+			_cache.for_each_chunk([&] (Chunk_level_4 &chunk) {
+
+				if (congested)
+					return;
+
+				if (!chunk.dirty() || chunk.syncing()) {
+					submit_run();
+					return;
+				}
+
+				bool const adjacent = n && (run[n - 1]->base_offset()
+				                            + CACHE_BLK_SIZE == chunk.base_offset());
+				if (n == MAX_WRITE_CHUNKS || (n && !adjacent))
+					submit_run();
+
+				run[n++] = &chunk;
+			});
+
+			submit_run();
+
+			_blk.tx()->wakeup();
+		}
+
 		/*
 		 * Synchronize dirty chunks with backend device
+		 *
+		 * Returns not before all write requests are acknowledged by the
+		 * backend device.
 		 */
 		void _sync()
 		{
@@ -277,9 +647,15 @@ class Driver : public Block::Driver
 					 */
 					off = e.off;
 					len = _info.block_size * _info.block_count - off;
+					_blk.tx()->wakeup();
 					_env.ep().wait_and_dispatch_one_io_signal();
 				}
 			}
+
+			_blk.tx()->wakeup();
+
+			while (_writes_in_flight)
+				_env.ep().wait_and_dispatch_one_io_signal();
 		}
 
 		/*
@@ -318,8 +694,14 @@ class Driver : public Block::Driver
 			size_t const requested_ram_quota =
 				Arg_string::find_arg(args.string(), "ram_quota").ulong_value(0);
 
-			/* flush the requested amount of RAM from cache */
-			POLICY::flush(requested_ram_quota);
+			/*
+			 * Flush the requested amount of RAM from cache. Dirty chunks
+			 * are merely scheduled for write-back, so the flushed amount
+			 * may fall short of the request.
+			 */
+			try { POLICY::flush(requested_ram_quota); }
+			catch (Request_congestion) { }
+
 			_env.parent().yield_response();
 		}
 
@@ -328,26 +710,44 @@ class Driver : public Block::Driver
 		/*
 		 * Constructor
 		 *
-		 * \param ep  server entrypoint
+		 * \param env     component environment
+		 * \param heap    backing store of the cache
+		 * \param config  driver tunables
 		 */
-		Driver(Genode::Env &env, Genode::Heap &heap)
+		Driver(Genode::Env &env, Genode::Heap &heap, Driver_config const &config)
 		: Block::Driver(env.ram()),
 		  _env(env),
 		  _r_slab(&heap),
+		  _r_list(),
+		  _deferred(),
 		  _alloc(&heap, CACHE_BLK_SIZE),
-		  _blk(_env, &_alloc, Block::Session::TX_QUEUE_SIZE*CACHE_BLK_SIZE),
+		  _blk(_env, &_alloc, BUFFER_SIZE),
 		  _info(_blk.info()),
 		  _cache(heap, 0),
 		  _source_ack(env.ep(), *this, &Driver::_ack_avail),
 		  _source_submit(env.ep(), *this, &Driver::_ready_to_submit),
-		  _yield(env.ep(), *this, &Driver::_parent_yield)
+		  _write_back_handler(env.ep(), *this, &Driver::_write_back),
+		  _yield(env.ep(), *this, &Driver::_parent_yield),
+		  _reporter(env, "block_cache"),
+		  _write_behind_handler(env.ep(), *this, &Driver::_write_behind),
+		  _ra_max(Genode::min(config.read_ahead_max, (Genode::size_t)BUFFER_SIZE/2)
+		          / _info.block_size)
 		{
 			using namespace Genode;
 
 			_blk.tx_channel()->sigh_ack_avail(_source_ack);
 			_blk.tx_channel()->sigh_ready_to_submit(_source_submit);
+			Write_back::sigh(_write_back_handler);
 			env.parent().yield_sigh(_yield);
 
+			_reporter.enabled(config.report);
+
+			if (config.write_behind_ms) {
+				_timer.construct(env);
+				_timer->sigh(_write_behind_handler);
+				_timer->trigger_periodic(config.write_behind_ms*1000ULL);
+			}
+
 			if (CACHE_BLK_SIZE % _info.block_size) {
 				error("only devices that block size is divider of ",
 				      Hex(CACHE_BLK_SIZE, Hex::OMIT_PREFIX) ," supported");
@@ -360,14 +760,28 @@ class Driver : public Block::Driver
 
 		~Driver()
 		{
+			Write_back::sigh(Genode::Signal_context_capability());
+
 			/* when session gets closed, synchronize and flush the cache */
 			_sync();
 			POLICY::flush();
+			_report();
 		}
 
 		Block::Session_client* blk()    { return &_blk;   }
 		Genode::size_t         blk_sz() { return _info.block_size; }
 
+		/**
+		 * Submit write-back of a single chunk
+		 *
+		 * \return  false if the backend device cannot take the request
+		 */
+		bool submit_write(Chunk_level_4 &chunk)
+		{
+			Chunk_level_4 *c = &chunk;
+			return _submit_write(&c, 1);
+		}
+
 
 		/****************************
 		 ** Block-driver interface **
@@ -378,22 +792,80 @@ class Driver : public Block::Driver
 		void read(Block::sector_t           block_number,
 		          Genode::size_t            block_count,
 		          char*                     buffer,
-		          Block::Packet_descriptor &packet)
+		          Block::Packet_descriptor &packet) override
 		{
-			if (!_stat(block_number, block_count, buffer, packet))
+			/* preserve order of requests while others are deferred */
+			if (!_deferred.empty()) {
+				_defer(packet, buffer);
 				return;
+			}
 
-			_cache.read(buffer,
-			            block_count *_info.block_size,
-			            block_number*_info.block_size);
+			try {
+				if (_read(block_number, block_count, buffer, packet))
+					_hits++;
+				else
+					_misses++;
+			} catch (Request_congestion) {
+				_defer(packet, buffer);
+				return;
+			}
 
-			ack_packet(packet);
+			_track_stream(block_number, block_count);
+
+			if (((_hits + _misses) % REPORT_INTERVAL) == 0)
+				_report();
 		}
 
 		void write(Block::sector_t           block_number,
 		           Genode::size_t            block_count,
 		           const char *              buffer,
+		           Block::Packet_descriptor &packet) override
+		{
+			char * const buf = const_cast<char *>(buffer);
+
+			if (!_deferred.empty()) {
+				_defer(packet, buf);
+				return;
+			}
+
+			try { _write(block_number, block_count, buffer, packet); }
+			catch (Request_congestion) { _defer(packet, buf); }
+		}
+
+		void sync() override
+		{
+			_write_failed = false;
+			_sync();
+
+			if (_write_failed)
+				throw Io_error();
+		}
+
+	private:
+
+		/*
+		 * \return true if the request was served from the cache
+		 */
+		bool _read(Block::sector_t           block_number,
+		           Genode::size_t            block_count,
+		           char*                     buffer,
 		           Block::Packet_descriptor &packet)
+		{
+			if (!_stat(block_number, block_count, buffer, packet))
+				return false;
+
+			_cache.read(buffer,
+			            block_count *_info.block_size,
+			            block_number*_info.block_size);
+
+			ack_packet(packet);
+			return true;
+		}
+
+		void _write(Block::sector_t           block_number,
+		            Genode::size_t            block_count,
+		            const char *              buffer,
+		            Block::Packet_descriptor &packet)
 		{
 			if (!_info.writeable)
 				throw Io_error();
@@ -416,6 +888,4 @@ class Driver : public Block::Driver
 
 			ack_packet(packet);
 		}
-
-		void sync() { _sync(); }
 };
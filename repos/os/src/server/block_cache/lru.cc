@@ -16,19 +16,11 @@
 
 typedef Driver<Lru_policy>::Chunk_level_4 Chunk;
 
-static const Lru_policy::Element        *lru = 0;
-static Genode::List<Lru_policy::Element> lru_list;
+static Policy_list<Lru_policy::Element> lru_list;
 
 
-static void lru_access(const Lru_policy::Element *e)
-{
-	if (e == lru) return;
-
-	if (e->next()) lru_list.remove(e);
-
-	lru_list.insert(e, lru);
-	lru = e;
-}
+static void lru_access(const Lru_policy::Element *e) {
+	lru_list.requeue(*const_cast<Lru_policy::Element *>(e)); }
 
 
 void Lru_policy::read(const Lru_policy::Element  *e) {
@@ -39,24 +31,28 @@ void Lru_policy::write(const Lru_policy::Element *e) {
 	lru_access(e); }
 
 
+void Lru_policy::release(const Lru_policy::Element *e) {
+	lru_list.remove(*const_cast<Lru_policy::Element *>(e)); }
+
+
 void Lru_policy::flush(Cache::size_t size)
 {
 	Cache::size_t s = 0;
 	for (Lru_policy::Element *e = lru_list.first();
-		 e && ((size == 0) || (s < size));
-		 e = lru_list.first(), s += sizeof(Chunk)) {
+		 e && ((size == 0) || (s < size)); ) {
 		Chunk *cb = static_cast<Chunk*>(e);
-		e = e->next();
-		try {
-			cb->free(Driver<Lru_policy>::CACHE_BLK_SIZE,
-			         cb->base_offset());
-			lru_list.remove(cb);
-		} catch(Chunk::Dirty_chunk &e) {
-			cb->sync(e.size, e.off);
+		e = lru_list.next(*e);
+
+		/* dirty chunks are written back asynchronously and evicted later */
+		if (cb->dirty()) {
+			Write_back::schedule(*cb);
+			continue;
 		}
-	}
 
-	if (!lru_list.first()) lru = 0;
+		lru_list.remove(*cb);
+		cb->free(Driver<Lru_policy>::CACHE_BLK_SIZE, cb->base_offset());
+		s += sizeof(Chunk);
+	}
 
 	if (s < size) throw Block::Driver::Request_congestion();
 }
@@ -11,15 +11,29 @@
  * under the terms of the GNU Affero General Public License version 3.
  */
 
-#include <util/list.h>
+#ifndef _LRU_H_
+#define _LRU_H_
 
 #include "chunk.h"
+#include "policy_list.h"
+#include "write_back.h"
 
 struct Lru_policy
 {
-	class Element : public Genode::List<Element>::Element {};
+	class Element : public Policy_list<Element>::Element,
+	                public Write_back::Element
+	{
+		protected:
+
+			~Element() { Lru_policy::release(this); }
+	};
+
+	static char const *name() { return "lru"; }
 
 	static void read(const Element  *e);
 	static void write(const Element *e);
+	static void release(const Element *e);
 	static void flush(Cache::size_t size = 0);
 };
+
+#endif /* _LRU_H_ */
@@ -12,66 +12,133 @@
  */
 
 #include <base/component.h>
+#include <base/attached_rom_dataspace.h>
 
 #include "lru.h"
+#include "two_q.h"
+#include "clock.h"
 #include "driver.h"
 
-using Policy = Lru_policy;
-static Driver<Policy> * driver = nullptr;
+template <typename POLICY>
+static Driver<POLICY> * driver = nullptr;
 
 
 /**
  * Synchronize a chunk with the backend device
+ *
+ * The write request is not signalled to the backend device immediately.
+ * The caller is expected to call 'wakeup' on the packet stream after
+ * submitting a batch of write requests. The chunk stays dirty until the
+ * backend device acknowledged the write.
  */
 template <typename POLICY>
-void Driver<POLICY>::Policy::sync(const typename POLICY::Element *e, char *dst)
+void Driver<POLICY>::Policy::sync(const typename POLICY::Element *e, char *)
 {
-	Cache::offset_t off =
-		static_cast<const Driver<POLICY>::Chunk_level_4*>(e)->base_offset();
-
-	if (!driver) throw Write_failed(off);
-
-	if (!driver->blk()->tx()->ready_to_submit())
-		throw Write_failed(off);
-	try {
-		Block::Packet_descriptor
-			p(driver->blk()->alloc_packet(Driver::CACHE_BLK_SIZE),
-		      Block::Packet_descriptor::WRITE, off / driver->blk_sz(),
-		      Driver::CACHE_BLK_SIZE / driver->blk_sz());
-		driver->blk()->tx()->submit_packet(p);
-	} catch(Block::Session::Tx::Source::Packet_alloc_failed) {
-		throw Write_failed(off);
-	}
+	Chunk_level_4 &chunk =
+		*const_cast<Chunk_level_4 *>(static_cast<Chunk_level_4 const *>(e));
+
+	if (!driver<POLICY> || !driver<POLICY>->submit_write(chunk))
+		throw Write_failed(chunk.base_offset());
 }
 
 
 struct Main
 {
-	template <typename T>
 	struct Factory : Block::Driver_factory
 	{
+		enum Policy { LRU, TWO_Q, CLOCK };
+
 		Genode::Env  &env;
 		Genode::Heap &heap;
+		Policy        const policy;
+		Driver_config const config;
+
+		template <typename POLICY>
+		Block::Driver *_create()
+		{
+			driver<POLICY> = new (&heap) ::Driver<POLICY>(env, heap, config);
+			return driver<POLICY>;
+		}
+
+		template <typename POLICY>
+		void _destroy(Block::Driver *driver)
+		{
+			::driver<POLICY> = nullptr;
+			Genode::destroy(&heap, static_cast<::Driver<POLICY>*>(driver));
+		}
+
+		static Policy _policy(Genode::Xml_node config)
+		{
+			typedef Genode::String<8> Name;
+			Name const name = config.attribute_value("policy", Name(Lru_policy::name()));
+
+			if (name == Two_q_policy::name()) return TWO_Q;
+			if (name == Clock_policy::name()) return CLOCK;
+			if (name != Lru_policy::name())
+				Genode::warning("unknown policy '", name, "', using LRU");
 
-		Factory(Genode::Env &env, Genode::Heap &heap) : env(env), heap(heap) {}
+			return LRU;
+		}
+
+		static Driver_config _driver_config(Genode::Xml_node config)
+		{
+			enum { DEFAULT_READ_AHEAD = 256*1024 };
+
+			Genode::Number_of_bytes const read_ahead =
+				config.attribute_value("read_ahead",
+				                       Genode::Number_of_bytes(DEFAULT_READ_AHEAD));
+
+			return Driver_config { config.attribute_value("report", false),
+			                       read_ahead,
+			                       config.attribute_value("write_behind_ms", 0U) };
+		}
+
+		Factory(Genode::Env &env, Genode::Heap &heap, Genode::Xml_node config)
+		:
+			env(env), heap(heap), policy(_policy(config)),
+			config(_driver_config(config))
+		{ }
 
-		Block::Driver *create()
+		Block::Driver *create() override
 		{
-			driver = new (&heap) ::Driver<T>(env, heap);
-			return driver;
+			switch (policy) {
+			case TWO_Q: return _create<Two_q_policy>();
+			case CLOCK: return _create<Clock_policy>();
+			case LRU:   break;
+			}
+			return _create<Lru_policy>();
 		}
 
-		void destroy(Block::Driver *driver) {
-			Genode::destroy(&heap, static_cast<::Driver<T>*>(driver)); }
+		void destroy(Block::Driver *driver) override
+		{
+			switch (policy) {
+			case TWO_Q: _destroy<Two_q_policy>(driver); return;
+			case CLOCK: _destroy<Clock_policy>(driver); return;
+			case LRU:   _destroy<Lru_policy>(driver);   return;
+			}
+		}
 	};
 
 	void resource_handler() { }
 
-	Genode::Env                 &env;
-	Genode::Heap                 heap    { env.ram(), env.rm()     };
-	Factory<Lru_policy>          factory { env, heap               };
-	Block::Root                  root    { env.ep(), heap, env.rm(), factory, true };
-	Genode::Signal_handler<Main> resource_dispatcher {
+	/*
+	 * The configuration is optional, without it the LRU policy is used
+	 */
+	static Genode::Xml_node _config(Genode::Env &env)
+	{
+		static Genode::Constructible<Genode::Attached_rom_dataspace> config { };
+
+		try { config.construct(env, "config"); }
+		catch (...) { return Genode::Xml_node("<config/>"); }
+
+		return config->xml();
+	}
+
+	Genode::Env                  &env;
+	Genode::Heap                  heap    { env.ram(), env.rm()     };
+	Factory                       factory { env, heap, _config(env) };
+	Block::Root                   root    { env.ep(), heap, env.rm(), factory, true };
+	Genode::Signal_handler<Main>  resource_dispatcher {
 		env.ep(), *this, &Main::resource_handler };
 
 	Main(Genode::Env &env) : env(env)
@@ -0,0 +1,127 @@
+/*
+ * \brief  List of cache chunks organized by a replacement strategy
+ * \author Genode Labs
+ * \date   2026-10-15
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _POLICY_LIST_H_
+#define _POLICY_LIST_H_
+
+/**
+ * Doubly-linked list ordered from the oldest to the newest element
+ *
+ * In contrast to 'Genode::List', elements can be removed and requeued in
+ * constant time, which is needed on every cache hit.
+ *
+ * \param T  element type, must inherit 'Policy_list<T>::Element'
+ */
+template <typename T>
+class Policy_list
+{
+	public:
+
+		class Element
+		{
+			private:
+
+				friend class Policy_list;
+
+				T    *_prev   = nullptr;
+				T    *_next   = nullptr;
+				bool  _linked = false;
+
+			public:
+
+				bool linked() const { return _linked; }
+		};
+
+	private:
+
+		T            *_head  = nullptr;  /* oldest element */
+		T            *_tail  = nullptr;  /* newest element */
+		unsigned long _count = 0;
+
+	public:
+
+		/**
+		 * Append element as newest element
+		 */
+		void enqueue(T &e)
+		{
+			Element &le = e;
+
+			le._prev   = _tail;
+			le._next   = nullptr;
+			le._linked = true;
+
+			if (_tail) _tail->Element::_next = &e;
+			else       _head = &e;
+
+			_tail = &e;
+			_count++;
+		}
+
+		/**
+		 * Insert element right before 'pos'
+		 */
+		void insert_before(T &e, T &pos)
+		{
+			Element &le = e;
+			Element &lp = pos;
+
+			le._prev   = lp._prev;
+			le._next   = &pos;
+			le._linked = true;
+
+			if (lp._prev) lp._prev->Element::_next = &e;
+			else          _head = &e;
+
+			lp._prev = &e;
+			_count++;
+		}
+
+		void remove(T &e)
+		{
+			Element &le = e;
+
+			if (!le._linked)
+				return;
+
+			if (le._prev) le._prev->Element::_next = le._next;
+			else          _head = le._next;
+
+			if (le._next) le._next->Element::_prev = le._prev;
+			else          _tail = le._prev;
+
+			le._prev   = le._next = nullptr;
+			le._linked = false;
+			_count--;
+		}
+
+		/**
+		 * Move element to the newest position
+		 */
+		void requeue(T &e)
+		{
+			if (&e == _tail)
+				return;
+
+			remove(e);
+			enqueue(e);
+		}
+
+		T *first() const { return _head; }
+
+		T *next(T const &e) const { return e.Element::_next; }
+
+		unsigned long count() const { return _count; }
+};
+
+#endif /* _POLICY_LIST_H_ */
@@ -0,0 +1,187 @@
+/*
+ * \brief  Scan-resistant 2Q cache replacement strategy
+ * \author Genode Labs
+ * \date   2026-10-15
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include "two_q.h"
+#include "driver.h"
+
+typedef Driver<Two_q_policy>::Chunk_level_4 Chunk;
+typedef Two_q_policy::Element               Element;
+
+static Policy_list<Element> a1in;  /* chunks referenced once, FIFO */
+static Policy_list<Element> am;    /* chunks referenced repeatedly, LRU */
+
+
+/**
+ * Ghost queue of the offsets of chunks recently evicted from 'A1in'
+ *
+ * The queue is a ring of fixed size. Its lookup is a linear search, which
+ * is performed only when a chunk enters the cache, i.e., when a request to
+ * the backend device is issued anyway.
+ */
+class A1out
+{
+	private:
+
+		enum { ENTRIES = 4096 };
+
+		Cache::offset_t _offsets[ENTRIES] { };
+		unsigned        _head  = 0;
+		unsigned        _count = 0;
+
+		unsigned _oldest() const { return (_head + ENTRIES - _count) % ENTRIES; }
+
+		int _index(Cache::offset_t off) const
+		{
+			for (unsigned i = 0; i < _count; i++) {
+				unsigned const index = (_oldest() + i) % ENTRIES;
+				if (_offsets[index] == off)
+					return index;
+			}
+			return -1;
+		}
+
+	public:
+
+		void remember(Cache::offset_t off)
+		{
+			_offsets[_head] = off;
+			_head  = (_head + 1) % ENTRIES;
+			_count = Genode::min(_count + 1, (unsigned)ENTRIES);
+		}
+
+		/**
+		 * Return true if 'off' was remembered, and forget it
+		 */
+		bool forget(Cache::offset_t off)
+		{
+			int const i = _index(off);
+			if (i < 0)
+				return false;
+
+			/* invalidate entry by replacing it with the oldest one */
+			_offsets[i] = _offsets[_oldest()];
+			_count--;
+			return true;
+		}
+};
+
+static A1out a1out;
+
+
+static void two_q_access(const Element *e)
+{
+	Element &elem = *const_cast<Element *>(e);
+
+	switch (elem.queue) {
+
+	case Element::AM:
+		am.requeue(elem);
+		return;
+
+	case Element::A1IN:
+
+		/* correlated reference, keep FIFO position */
+		return;
+
+	case Element::NONE:
+
+		if (a1out.forget(static_cast<Chunk &>(elem).base_offset())) {
+			elem.queue = Element::AM;
+			am.enqueue(elem);
+		} else {
+			elem.queue = Element::A1IN;
+			a1in.enqueue(elem);
+		}
+		return;
+	}
+}
+
+
+void Two_q_policy::read(const Element *e) {
+	two_q_access(e); }
+
+
+void Two_q_policy::write(const Element *e) {
+	two_q_access(e); }
+
+
+void Two_q_policy::release(const Element *e)
+{
+	Element &elem = *const_cast<Element *>(e);
+
+	switch (elem.queue) {
+	case Element::A1IN: a1in.remove(elem); break;
+	case Element::AM:   am.remove(elem);   break;
+	case Element::NONE:                    break;
+	}
+	elem.queue = Element::NONE;
+}
+
+
+/**
+ * Evict clean chunks of 'queue' until 'size' bytes are freed
+ *
+ * \return number of freed bytes
+ */
+static Cache::size_t evict(Policy_list<Element> &queue, Cache::size_t size,
+                           bool remember)
+{
+	Cache::size_t s = 0;
+
+	for (Element *e = queue.first(); e && ((size == 0) || (s < size)); ) {
+		Chunk *cb = static_cast<Chunk*>(e);
+		e = queue.next(*e);
+
+		/* dirty chunks are written back asynchronously and evicted later */
+		if (cb->dirty()) {
+			Write_back::schedule(*cb);
+			continue;
+		}
+
+		if (remember)
+			a1out.remember(cb->base_offset());
+
+		Two_q_policy::release(cb);
+		cb->free(Driver<Two_q_policy>::CACHE_BLK_SIZE, cb->base_offset());
+		s += sizeof(Chunk);
+	}
+	return s;
+}
+
+
+void Two_q_policy::flush(Cache::size_t size)
+{
+	if (size == 0) {
+		evict(a1in, 0, false);
+		evict(am,   0, false);
+		return;
+	}
+
+	/*
+	 * Prefer evicting from 'A1in' as long as it holds more than a quarter
+	 * of the cached chunks.
+	 */
+	Cache::size_t s = 0;
+
+	unsigned long const total = a1in.count() + am.count();
+	if (a1in.count()*4 > total)
+		s += evict(a1in, size, true);
+
+	if (s < size)
+		s += evict(am, size - s, false);
+
+	if (s < size)
+		s += evict(a1in, size - s, true);
+
+	if (s < size) throw Block::Driver::Request_congestion();
+}
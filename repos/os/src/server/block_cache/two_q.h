@@ -0,0 +1,52 @@
+/*
+ * \brief  Scan-resistant 2Q cache replacement strategy
+ * \author Genode Labs
+ * \date   2026-10-15
+ *
+ * Chunks referenced for the first time enter the FIFO queue 'A1in'.
+ * Repeated references to a chunk within 'A1in', e.g., the fill of a chunk
+ * followed by the read of the client, are deliberately ignored. When a
+ * chunk is evicted from 'A1in', its offset is remembered in the ghost queue
+ * 'A1out'. Only if a chunk is referenced again while being remembered in
+ * 'A1out', it is considered hot and enters the LRU queue 'Am'. Hence, a
+ * large sequential read passes through 'A1in' without evicting the working
+ * set held in 'Am'.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _TWO_Q_H_
+#define _TWO_Q_H_
+
+#include "chunk.h"
+#include "policy_list.h"
+#include "write_back.h"
+
+struct Two_q_policy
+{
+	class Element : public Policy_list<Element>::Element,
+	                public Write_back::Element
+	{
+		public:
+
+			enum Queue { NONE, A1IN, AM } queue = NONE;
+
+		protected:
+
+			~Element() { Two_q_policy::release(this); }
+	};
+
+	static char const *name() { return "2q"; }
+
+	static void read(const Element  *e);
+	static void write(const Element *e);
+	static void release(const Element *e);
+	static void flush(Cache::size_t size = 0);
+};
+
+#endif /* _TWO_Q_H_ */
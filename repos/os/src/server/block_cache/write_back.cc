@@ -0,0 +1,67 @@
+/*
+ * \brief  Asynchronous write-back of dirty cache chunks
+ * \author Genode Labs
+ * \date   2026-10-15
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#include "write_back.h"
+
+static Genode::Signal_context_capability write_back_sigh;
+static unsigned long                     write_back_pending;
+
+
+Write_back::Queue &Write_back::_queue()
+{
+	static Queue queue;
+	return queue;
+}
+
+
+void Write_back::_wakeup()
+{
+	if (write_back_sigh.valid())
+		Genode::Signal_transmitter(write_back_sigh).submit();
+}
+
+
+void Write_back::sigh(Genode::Signal_context_capability sigh)
+{
+	write_back_sigh = sigh;
+
+	if (write_back_pending)
+		_wakeup();
+}
+
+
+void Write_back::schedule(Element const &e)
+{
+	Element &elem = const_cast<Element &>(e);
+
+	if (elem._queue_elem.enqueued())
+		return;
+
+	_queue().enqueue(elem._queue_elem);
+
+	if (write_back_pending++ == 0)
+		_wakeup();
+}
+
+
+void Write_back::cancel(Element &e)
+{
+	if (!e._queue_elem.enqueued())
+		return;
+
+	_queue().remove(e._queue_elem);
+	write_back_pending--;
+}
+
+
+unsigned long Write_back::pending() { return write_back_pending; }
@@ -0,0 +1,118 @@
+/*
+ * \brief  Asynchronous write-back of dirty cache chunks
+ * \author Genode Labs
+ * \date   2026-10-15
+ *
+ * Replacement policies do not synchronize dirty chunks while evicting.
+ * Instead, they schedule the chunks for write-back. The driver drains the
+ * queue in batches whenever the backend device accepts new requests.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _WRITE_BACK_H_
+#define _WRITE_BACK_H_
+
+/* Genode includes */
+#include <base/signal.h>
+#include <util/fifo.h>
+
+class Write_back
+{
+	public:
+
+		class Element;
+
+	private:
+
+		typedef Genode::Fifo_element<Element> Queue_element;
+		typedef Genode::Fifo<Queue_element>   Queue;
+
+		static Queue &_queue();
+
+		static void _wakeup();
+
+	public:
+
+		/**
+		 * Register signal handler for processing the write-back queue
+		 *
+		 * The handler is triggered whenever a chunk is scheduled for
+		 * write-back while the queue is empty.
+		 */
+		static void sigh(Genode::Signal_context_capability sigh);
+
+		/**
+		 * Schedule write-back of dirty chunk
+		 */
+		static void schedule(Element const &e);
+
+		/**
+		 * Withdraw chunk from the write-back queue
+		 */
+		static void cancel(Element &e);
+
+		/**
+		 * Return number of chunks waiting for write-back
+		 */
+		static unsigned long pending();
+
+		/**
+		 * Write back chunks in order of their scheduling
+		 *
+		 * The functor 'fn' is called with an 'Element &' argument and
+		 * returns true if the chunk got submitted to the backend device.
+		 * The iteration stops as soon as the functor returns false.
+		 */
+		template <typename FN>
+		static void process(FN const &fn);
+};
+
+
+class Write_back::Element
+{
+	private:
+
+		friend class Write_back;
+
+		Queue_element _queue_elem { *this };
+
+		/*
+		 * Noncopyable
+		 */
+		Element(Element const &);
+		Element &operator = (Element const &);
+
+	protected:
+
+		~Element() { Write_back::cancel(*this); }
+
+	public:
+
+		Element() { }
+};
+
+
+template <typename FN>
+void Write_back::process(FN const &fn)
+{
+	for (bool progress = true; progress; ) {
+
+		progress = false;
+
+		_queue().head([&] (Queue_element &qe) {
+			if (!fn(qe.object()))
+				return;
+
+			cancel(qe.object());
+			progress = true;
+		});
+	}
+}
+
+#endif /* _WRITE_BACK_H_ */
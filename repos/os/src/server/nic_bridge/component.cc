@@ -65,6 +65,7 @@ bool Session_component::handle_ip(Ethernet_frame &eth,
 
 				dhcp.broadcast(true);
 				udp.update_checksum(ip.src(), ip.dst());
+				_checksum_completed();
 			}
 		}
 	}
@@ -79,11 +80,11 @@ void Session_component::finalize_packet(Ethernet_frame *eth,
 	if (node)
 		node = node->find_by_address(eth->dst());
 	if (node)
-		node->component().send(eth, size);
+		node->component().send(eth, size, header());
 	else {
 		/* set our MAC as sender */
 		eth->src(_nic.mac());
-		_nic.send(eth, size);
+		_nic.send(eth, size, header());
 	}
 }
 
@@ -119,7 +120,8 @@ Session_component::Session_component(Genode::Ram_allocator       &ram,
                                      Net::Nic                    &nic,
                                      bool                  const &verbose,
                                      Genode::Session_label const &label,
-                                     Ip_addr               const &ip_addr)
+                                     Ip_addr               const &ip_addr,
+                                     ::Nic::Offload        const &offload)
 : Stream_allocator(ram, rm, ram_quota, cap_quota),
   Stream_dataspaces(ram, tx_buf_size, rx_buf_size),
   Session_rpc_object(rm,
@@ -131,6 +133,9 @@ Session_component::Session_component(Genode::Ram_allocator       &ram,
   _ipv4_node(*this),
   _nic(nic)
 {
+	/* offload features not supported by a peer are resolved in software */
+	_offload = offload;
+
 	vlan().mac_tree.insert(&_mac_node);
 	vlan().mac_list.insert(&_mac_node);
 
@@ -130,6 +130,7 @@ class Net::Session_component : private Net::Stream_allocator,
 		 * \param tx_buf_size  buffer size for tx channel
 		 * \param rx_buf_size  buffer size for rx channel
 		 * \param vmac         virtual mac address
+		 * \param offload      offload features of the session
 		 */
 		Session_component(Genode::Ram_allocator       &ram,
 		                  Genode::Region_map          &rm,
@@ -142,7 +143,8 @@ class Net::Session_component : private Net::Stream_allocator,
 		                  Net::Nic                    &nic,
 		                  bool                  const &verbose,
 		                  Genode::Session_label const &label,
-		                  Ip_addr               const &ip_addr);
+		                  Ip_addr               const &ip_addr,
+		                  ::Nic::Offload        const &offload);
 
 		~Session_component();
 
@@ -172,6 +174,8 @@ class Net::Session_component : private Net::Stream_allocator,
 		void link_state_sigh(Genode::Signal_context_capability sigh) override {
 			_link_state_sigh = sigh; }
 
+		::Nic::Offload offload() override { return _offload; }
+
 
 		/******************************
 		 ** Packet_handler interface **
@@ -232,6 +236,12 @@ class Net::Root : public Genode::Root_component<Net::Session_component>
 				throw Service_denied();
 			}
 
+			::Nic::Offload offload;
+			if (_config.attribute_value("offload", true)) {
+				offload.checksum = Arg_string::find_arg(args, "offload_checksum").bool_value(false);
+				offload.tso      = Arg_string::find_arg(args, "offload_tso").bool_value(false);
+			}
+
 			return new (md_alloc())
 				Session_component(_env.ram(), _env.rm(), _env.ep(),
 				                  ram_quota_from_args(args),
@@ -239,7 +249,8 @@ class Net::Root : public Genode::Root_component<Net::Session_component>
 				                  Arg_string::find_arg(args, "tx_buf_size").ulong_value(0),
 				                  Arg_string::find_arg(args, "rx_buf_size").ulong_value(0),
 				                  mac, _nic, _verbose, label,
-				                  policy.attribute_value("ip_addr", Session_component::Ip_addr()));
+				                  policy.attribute_value("ip_addr", Session_component::Ip_addr()),
+				                  offload);
 		}
 
 		
@@ -27,6 +27,13 @@
 
 struct Main
 {
+	static Nic::Offload _offload(Genode::Xml_node config)
+	{
+		Nic::Offload offload;
+		offload.checksum = offload.tso = config.attribute_value("offload", true);
+		return offload;
+	}
+
 	Genode::Env                    &env;
 	Genode::Entrypoint             &ep        { env.ep() };
 	Genode::Heap                    heap      { env.ram(), env.rm() };
@@ -34,8 +41,9 @@ struct Main
 	Net::Vlan                       vlan      { };
 	Genode::Session_label     const nic_label { "uplink" };
 	bool                      const verbose   { config.xml().attribute_value("verbose", false) };
+	Nic::Offload              const offload   { _offload(config.xml()) };
 	Net::Nic                        nic       { env, heap, vlan, verbose,
-	                                            nic_label };
+	                                            nic_label, offload };
 	Net::Root                       root      { env, nic, heap, verbose,
 	                                            config.xml() };
 
@@ -113,7 +113,7 @@ bool Net::Nic::handle_ip(Ethernet_frame &eth,
 				eth.dst(node->component().mac_address().addr);
 
 				/* deliver the packet to the client */
-				node->component().send(&eth, size_guard.total_size());
+				node->component().send(&eth, size_guard.total_size(), header());
 				return false;
 			}
 		}
@@ -126,12 +126,17 @@ Net::Nic::Nic(Genode::Env         &env,
               Genode::Heap        &heap,
               Net::Vlan           &vlan,
               bool          const &verbose,
-              Session_label const &label)
+              Session_label const &label,
+              ::Nic::Offload const &offload)
 : Packet_handler(env.ep(), vlan, label, verbose),
   _tx_block_alloc(&heap),
-  _nic(env, &_tx_block_alloc, BUF_SIZE, BUF_SIZE),
+  _nic(env, &_tx_block_alloc, BUF_SIZE, BUF_SIZE, "", offload),
   _mac(_nic.mac_address().addr)
 {
+	_offload = _nic.offload();
+	if (_offload.any())
+		Genode::log("uplink offload: ", _offload);
+
 	_nic.rx_channel()->sigh_ready_to_ack(_sink_ack);
 	_nic.rx_channel()->sigh_packet_avail(_sink_submit);
 	_nic.tx_channel()->sigh_ack_avail(_source_ack);
@@ -37,11 +37,17 @@ class Net::Nic : public Net::Packet_handler
 
 	public:
 
+		/**
+		 * Constructor
+		 *
+		 * \param offload  offload features requested from the uplink
+		 */
 		Nic(Genode::Env&,
 		    Genode::Heap&,
 		    Vlan&,
 		    bool                  const &verbose,
-		    Genode::Session_label const &label);
+		    Genode::Session_label const &label,
+		    ::Nic::Offload        const &offload);
 
 		::Nic::Connection          *nic() { return &_nic; }
 		Mac_address mac() { return _mac; }
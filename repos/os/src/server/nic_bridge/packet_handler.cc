@@ -16,6 +16,7 @@
 #include <net/dhcp.h>
 #include <net/ethernet.h>
 #include <net/ipv4.h>
+#include <net/offload.h>
 #include <net/udp.h>
 
 #include <component.h>
@@ -72,7 +73,7 @@ void Packet_handler::broadcast_to_clients(Ethernet_frame *eth, Genode::size_t si
 			_vlan.mac_list.first();
 		while (node) {
 			/* deliver packet */
-			node->component().send(eth, size);
+			node->component().send(eth, size, _header);
 			node = node->next();
 		}
 	}
@@ -81,6 +82,18 @@ void Packet_handler::broadcast_to_clients(Ethernet_frame *eth, Genode::size_t si
 
 void Packet_handler::handle_ethernet(void* src, Genode::size_t size)
 {
+	/* strip offload header */
+	_header = ::Nic::Offload_header();
+	if (_offload.any()) {
+		if (size < sizeof(_header)) {
+			Genode::warning("Packet without offload header dropped");
+			return;
+		}
+		Genode::memcpy(&_header, src, sizeof(_header));
+		src   = (char *)src + sizeof(_header);
+		size -= sizeof(_header);
+	}
+
 	try {
 		/* parse ethernet frame header */
 		Size_guard size_guard(size);
@@ -105,19 +118,39 @@ void Packet_handler::handle_ethernet(void* src, Genode::size_t size)
 }
 
 
-void Packet_handler::send(Ethernet_frame *eth, Genode::size_t size)
+void Packet_handler::send(Ethernet_frame *eth, Genode::size_t size,
+                          ::Nic::Offload_header const &header)
 {
 	if (_verbose) {
 		Genode::log("[", _label, "] snd ", *eth); }
-	try {
-		/* copy and submit packet */
-		Packet_descriptor packet  = source()->alloc_packet(size);
-		char             *content = source()->packet_content(packet);
-		Genode::memcpy((void*)content, (void*)eth, size);
-		source()->submit_packet(packet);
-	} catch(Packet_stream_source< ::Nic::Session::Policy>::Packet_alloc_failed) {
-		Genode::warning("Packet dropped");
+
+	if (header.supported_by(_offload)) {
+		_submit(size, header, [&] (void *dst) {
+			Genode::memcpy(dst, (void *)eth, size); });
+		return;
 	}
+
+	/* split super frame into segments with complete checksums */
+	if (header.super_frame()) {
+		try {
+			Tcp_super_frame const frame(eth, size, header);
+			for (unsigned i = 0; i < frame.num_segments(); i++)
+				_submit(frame.segment_size(i), ::Nic::Offload_header(),
+				        [&] (void *dst) { frame.write_segment(i, dst); });
+		}
+		catch (Tcp_super_frame::Invalid) {
+			Genode::warning("Invalid TCP super frame dropped"); }
+		return;
+	}
+
+	/* complete partial checksum */
+	::Nic::Offload_header completed = header;
+	completed.flags &= (Genode::uint8_t)~::Nic::Offload_header::NEEDS_CSUM;
+
+	_submit(size, completed, [&] (void *dst) {
+		Genode::memcpy(dst, (void *)eth, size);
+		if (!complete_checksum(dst, size, header))
+			Genode::warning("Invalid partial checksum"); });
 }
 
 
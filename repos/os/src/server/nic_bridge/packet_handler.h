@@ -44,6 +44,9 @@ class Net::Packet_handler
 		Genode::Session_label  _label;
 		bool            const &_verbose;
 
+		/* offload information of the frame currently handled */
+		::Nic::Offload_header  _header { };
+
 		/**
 		 * submit queue not empty anymore
 		 */
@@ -75,8 +78,38 @@ class Net::Packet_handler
 		 */
 		void _link_state();
 
+		/**
+		 * Submit frame of 'size' bytes written by 'write_fn(dst)'
+		 */
+		template <typename FN>
+		void _submit(Genode::size_t size, ::Nic::Offload_header const &header,
+		             FN const &write_fn)
+		{
+			Genode::size_t const header_size = _offload.any() ? sizeof(header) : 0;
+			try {
+				Packet_descriptor packet  = source()->alloc_packet(header_size + size);
+				char             *content = source()->packet_content(packet);
+				Genode::memcpy(content, &header, header_size);
+				write_fn(content + header_size);
+				source()->submit_packet(packet);
+			} catch(Packet_stream_source< ::Nic::Session::Policy>::Packet_alloc_failed) {
+				Genode::warning("Packet dropped");
+			}
+		}
+
 	protected:
 
+		/* offload features of the session */
+		::Nic::Offload _offload { };
+
+		/**
+		 * Mark checksum of the current frame as complete
+		 *
+		 * Called after a handler recomputed the checksum of a frame.
+		 */
+		void _checksum_completed() {
+			_header.flags &= (Genode::uint8_t)~::Nic::Offload_header::NEEDS_CSUM; }
+
 		Genode::Signal_handler<Packet_handler> _sink_ack;
 		Genode::Signal_handler<Packet_handler> _sink_submit;
 		Genode::Signal_handler<Packet_handler> _source_ack;
@@ -97,6 +130,8 @@ class Net::Packet_handler
 
 		Net::Vlan & vlan() { return _vlan; }
 
+		::Nic::Offload_header const &header() const { return _header; }
+
 		/**
 		 * Broadcasts ethernet frame to all clients,
 		 * as long as its really a broadcast packtet.
@@ -110,10 +145,15 @@ class Net::Packet_handler
 		/**
 		 * Send ethernet frame
 		 *
-		 * \param eth   ethernet frame to send.
-		 * \param size  ethernet frame's size.
+		 * Offload features of the frame that are not enabled for the
+		 * session are resolved in software.
+		 *
+		 * \param eth     ethernet frame to send.
+		 * \param size    ethernet frame's size.
+		 * \param header  offload information of the frame
 		 */
-		void send(Ethernet_frame *eth, Genode::size_t size);
+		void send(Ethernet_frame *eth, Genode::size_t size,
+		          ::Nic::Offload_header const &header = ::Nic::Offload_header());
 
 		/**
 		 * Handle an ethernet packet
@@ -70,68 +70,63 @@ class Nic_loopback::Session_component : public Nic::Session_component
 
 void Nic_loopback::Session_component::_handle_packet_stream()
 {
+	enum { MAX_BATCH = 32 };
+
 	size_t const alloc_size = Nic::Packet_allocator::DEFAULT_PACKET_SIZE;
 
+	Packet_descriptor packets_to_client[MAX_BATCH];
+	Packet_descriptor packets_from_client[MAX_BATCH];
+
 	/* loop while we can make progress */
 	for (;;) {
 
 		/* flush acknowledgements for the echoes packets */
 		while (_rx.source()->ack_avail())
-			_rx.source()->release_packet(_rx.source()->get_acked_packet());
-
-		/*
-		 * If the client cannot accept new acknowledgements for a sent packets,
-		 * we won't consume the sent packet.
-		 */
-		if (!_tx.sink()->ready_to_ack())
-			return;
+			_rx.source()->release_packet(_rx.source()->try_get_acked_packet());
 
 		/*
-		 * Nothing to be done if the client has not sent any packets.
+		 * Process as many packets as the client has sent and as fit into
+		 * both the acknowledgement queue of the tx channel and the submit
+		 * queue of the rx channel.
 		 */
-		if (!_tx.sink()->packet_avail())
-			return;
-
-		/*
-		 * Here we know that the client has submitted a packet to us and is also
-		 * able it receive the corresponding acknowledgement.
-		 */
-
-		/*
-		 * The client fails to pick up the packets from the rx channel. So we
-		 * won't try to submit new packets.
-		 */
-		if (!_rx.source()->ready_to_submit())
-			return;
-
-		/*
-		 * We are safe to process one packet without blocking.
-		 */
-
+		unsigned n = 0;
+		while (n < MAX_BATCH) {
+
+			if (!_tx.sink()->packet_avail()
+			 || _tx.sink()->ack_slots_free() <= n
+			 || !_rx.source()->ready_to_submit(n + 1))
+				break;
+
+			Packet_descriptor packet_to_client;
+			try {
+				packet_to_client = _rx.source()->alloc_packet(alloc_size); }
+			catch (Session::Rx::Source::Packet_alloc_failed) {
+				break; }
+
+			/* obtain packet */
+			Packet_descriptor const packet_from_client = _tx.sink()->try_get_packet();
+			if (!packet_from_client.size() || !_tx.sink()->packet_valid(packet_from_client)) {
+				warning("received invalid packet");
+				_rx.source()->release_packet(packet_to_client);
+				continue;
+			}
 
-		Packet_descriptor packet_to_client;
-		try {
-			packet_to_client = _rx.source()->alloc_packet(alloc_size); }
-		catch (Session::Rx::Source::Packet_alloc_failed) {
-			continue; }
+			memcpy(_rx.source()->packet_content(packet_to_client),
+			       _tx.sink()->packet_content(packet_from_client),
+			       packet_from_client.size());
 
-		/* obtain packet */
-		Packet_descriptor const packet_from_client = _tx.sink()->get_packet();
-		if (!packet_from_client.size() || !_tx.sink()->packet_valid(packet_from_client)) {
-			warning("received invalid packet");
-			_rx.source()->release_packet(packet_to_client);
-			continue;
+			packets_to_client[n]   = Packet_descriptor(packet_to_client.offset(),
+			                                           packet_from_client.size());
+			packets_from_client[n] = packet_from_client;
+			n++;
 		}
 
-		memcpy(_rx.source()->packet_content(packet_to_client),
-		       _tx.sink()->packet_content(packet_from_client),
-		       packet_from_client.size());
-
-		packet_to_client = Packet_descriptor(packet_to_client.offset(),
-		                                     packet_from_client.size());
-		_rx.source()->submit_packet(packet_to_client);
+		if (n == 0)
+			return;
 
-		_tx.sink()->acknowledge_packet(packet_from_client);
+		/* the client gets signalled once after '_handle_packet_stream' */
+		_rx.source()->try_submit_packets(packets_to_client, n);
+		_tx.sink()->try_ack_packets(packets_from_client, n);
 	}
 }
 
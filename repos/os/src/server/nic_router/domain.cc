@@ -178,7 +178,8 @@ void Domain::_read_transport_rules(Cstring  const      &protocol,
 	node.for_each_sub_node(type, [&] (Xml_node const node) {
 		try {
 			rules.insert(*new (_alloc)
-				Transport_rule(domains, node, _alloc, protocol, _config, *this));
+				Transport_rule(domains, node, _alloc, protocol, _config, *this),
+				_alloc);
 		}
 		catch (Transport_rule::Invalid)     { _invalid("invalid transport rule"); }
 		catch (Permit_any_rule::Invalid)    { _invalid("invalid permit-any rule"); }
@@ -294,12 +295,12 @@ void Domain::init(Domain_tree &domains)
 	});
 	/* read ICMP rules */
 	_node.for_each_sub_node("icmp", [&] (Xml_node const node) {
-		try { _icmp_rules.insert(*new (_alloc) Ip_rule(domains, node)); }
+		try { _icmp_rules.insert(*new (_alloc) Ip_rule(domains, node), _alloc); }
 		catch (Ip_rule::Invalid) { _invalid("invalid ICMP rule"); }
 	});
 	/* read IP rules */
 	_node.for_each_sub_node("ip", [&] (Xml_node const node) {
-		try { _ip_rules.insert(*new (_alloc) Ip_rule(domains, node)); }
+		try { _ip_rules.insert(*new (_alloc) Ip_rule(domains, node), _alloc); }
 		catch (Ip_rule::Invalid) { _invalid("invalid IP rule"); }
 	});
 }
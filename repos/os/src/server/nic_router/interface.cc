@@ -15,6 +15,7 @@
 #include <net/tcp.h>
 #include <net/udp.h>
 #include <net/icmp.h>
+#include <net/internet_checksum.h>
 #include <net/arp.h>
 #include <base/quota_guard.h>
 
@@ -26,6 +27,7 @@
 using namespace Net;
 using Genode::Deallocator;
 using Genode::size_t;
+using Genode::uint16_t;
 using Genode::uint32_t;
 using Genode::addr_t;
 using Genode::log;
@@ -134,31 +136,6 @@ static void _link_packet(L3_protocol  const  prot,
 }
 
 
-static void _update_checksum(L3_protocol   const prot,
-                             void         *const prot_base,
-                             size_t        const prot_size,
-                             Ipv4_address  const src,
-                             Ipv4_address  const dst,
-                             size_t        const ip_size)
-{
-	switch (prot) {
-	case L3_protocol::TCP:
-		((Tcp_packet *)prot_base)->update_checksum(src, dst, prot_size);
-		return;
-	case L3_protocol::UDP:
-		((Udp_packet *)prot_base)->update_checksum(src, dst);
-		return;
-	case L3_protocol::ICMP:
-		{
-			Icmp_packet &icmp = *(Icmp_packet *)prot_base;
-			icmp.update_checksum(ip_size - sizeof(Ipv4_packet) -
-			                               sizeof(Icmp_packet));
-			return;
-		}
-	default: throw Interface::Bad_transport_protocol(); }
-}
-
-
 static Port _dst_port(L3_protocol const prot, void *const prot_base)
 {
 	switch (prot) {
@@ -203,6 +180,58 @@ static void _src_port(L3_protocol  const prot,
 }
 
 
+/**
+ * Adapt transport checksum to the rewritten addresses and ports
+ *
+ * As only the header fields of the link identity change, the checksum is
+ * updated incrementally instead of being recomputed over the whole payload.
+ */
+static void _update_checksum(L3_protocol   const  prot,
+                             void         *const  prot_base,
+                             Link_side_id  const &old_id,
+                             Ipv4_packet   const &ip)
+{
+	Internet_checksum_diff icd;
+
+	auto add_up_ip_diff = [&] (Ipv4_address const &new_ip,
+	                           Ipv4_address const &old_ip)
+	{
+		icd.add_up_diff((uint16_t const *)new_ip.addr,
+		                (uint16_t const *)old_ip.addr, Ipv4_packet::ADDR_LEN);
+	};
+	auto add_up_port_diff = [&] (Port new_port, Port old_port)
+	{
+		uint16_t const new_be = host_to_big_endian(new_port.value);
+		uint16_t const old_be = host_to_big_endian(old_port.value);
+		icd.add_up_diff(&new_be, &old_be, sizeof(uint16_t));
+	};
+	switch (prot) {
+	case L3_protocol::TCP:
+	case L3_protocol::UDP:
+
+		/* the addresses are part of the pseudo IP header */
+		add_up_ip_diff(ip.src(), old_id.src_ip);
+		add_up_ip_diff(ip.dst(), old_id.dst_ip);
+		add_up_port_diff(_src_port(prot, prot_base), old_id.src_port);
+		add_up_port_diff(_dst_port(prot, prot_base), old_id.dst_port);
+		if (prot == L3_protocol::TCP) {
+			((Tcp_packet *)prot_base)->update_checksum(icd);
+		} else {
+			((Udp_packet *)prot_base)->update_checksum(icd);
+		}
+		return;
+
+	case L3_protocol::ICMP:
+
+		/* source and destination port both refer to the query ID */
+		add_up_port_diff(_src_port(prot, prot_base), old_id.src_port);
+		((Icmp_packet *)prot_base)->update_checksum(icd);
+		return;
+
+	default: throw Interface::Bad_transport_protocol(); }
+}
+
+
 static void *_prot_base(L3_protocol const  prot,
                         Size_guard        &size_guard,
                         Ipv4_packet       &ip)
@@ -273,15 +302,11 @@ void Interface::_destroy_link(Link &link)
 }
 
 
-void Interface::_pass_prot(Ethernet_frame       &eth,
-                           Size_guard           &size_guard,
-                           Ipv4_packet          &ip,
-                           L3_protocol    const  prot,
-                           void          *const  prot_base,
-                           size_t         const  prot_size)
+void Interface::_pass_prot(Ethernet_frame &eth,
+                           Size_guard     &size_guard,
+                           Ipv4_packet    &ip)
 {
 	eth.src(_router_mac);
-	_update_checksum(prot, prot_base, prot_size, ip.src(), ip.dst(), ip.total_length());
 	_pass_ip(eth, size_guard, ip);
 }
 
@@ -530,7 +555,6 @@ void Interface::_nat_link_and_pass(Ethernet_frame        &eth,
                                    Ipv4_packet           &ip,
                                    L3_protocol     const  prot,
                                    void           *const  prot_base,
-                                   size_t          const  prot_size,
                                    Link_side_id    const &local_id,
                                    Domain                &local_domain,
                                    Domain                &remote_domain)
@@ -549,9 +573,16 @@ void Interface::_nat_link_and_pass(Ethernet_frame        &eth,
 		catch (Nat_rule_tree::No_match) { }
 		Link_side_id const remote_id = { ip.dst(), _dst_port(prot, prot_base),
 		                                 ip.src(), _src_port(prot, prot_base) };
+
+		/*
+		 * Update the checksum before creating the link. If the latter fails
+		 * for lack of resources, the packet with the already adapted header
+		 * gets handled again and must therefore be consistent.
+		 */
+		_update_checksum(prot, prot_base, local_id, ip);
 		_new_link(prot, local_id, remote_port_alloc, remote_domain, remote_id);
 		remote_domain.interfaces().for_each([&] (Interface &interface) {
-			interface._pass_prot(eth, size_guard, ip, prot, prot_base, prot_size);
+			interface._pass_prot(eth, size_guard, ip);
 		});
 	} catch (Port_allocator_guard::Out_of_indices) {
 		switch (prot) {
@@ -906,7 +937,6 @@ void Interface::_handle_icmp_query(Ethernet_frame          &eth,
                                    Packet_descriptor const &pkt,
                                    L3_protocol              prot,
                                    void                    *prot_base,
-                                   size_t                   prot_size,
                                    Domain                  &local_domain)
 {
 	Link_side_id const local_id = { ip.src(), _src_port(prot, prot_base),
@@ -929,8 +959,9 @@ void Interface::_handle_icmp_query(Ethernet_frame          &eth,
 		_src_port(prot, prot_base, remote_side.dst_port());
 		_dst_port(prot, prot_base, remote_side.src_port());
 
+		_update_checksum(prot, prot_base, local_id, ip);
 		remote_domain.interfaces().for_each([&] (Interface &interface) {
-			interface._pass_prot(eth, size_guard, ip, prot, prot_base, prot_size);
+			interface._pass_prot(eth, size_guard, ip);
 		});
 		_link_packet(prot, prot_base, link, client);
 		return;
@@ -947,8 +978,8 @@ void Interface::_handle_icmp_query(Ethernet_frame          &eth,
 
 		Domain &remote_domain = rule.domain();
 		_adapt_eth(eth, local_id.dst_ip, pkt, remote_domain);
-		_nat_link_and_pass(eth, size_guard, ip, prot, prot_base, prot_size,
-		                   local_id, local_domain, remote_domain);
+		_nat_link_and_pass(eth, size_guard, ip, prot, prot_base, local_id,
+		                   local_domain, remote_domain);
 
 		return;
 	}
@@ -1050,7 +1081,7 @@ void Interface::_handle_icmp(Ethernet_frame            &eth,
 	/* try to act as ICMP router */
 	switch (icmp.type()) {
 	case Icmp_packet::Type::ECHO_REPLY:
-	case Icmp_packet::Type::ECHO_REQUEST:    _handle_icmp_query(eth, size_guard, ip, pkt, prot, prot_base, prot_size, local_domain); break;
+	case Icmp_packet::Type::ECHO_REQUEST:    _handle_icmp_query(eth, size_guard, ip, pkt, prot, prot_base, local_domain); break;
 	case Icmp_packet::Type::DST_UNREACHABLE: _handle_icmp_error(eth, size_guard, ip, pkt, local_domain, icmp, prot_size); break;
 	default: Drop_packet("unhandled type in ICMP"); }
 }
@@ -1129,8 +1160,9 @@ void Interface::_handle_ip(Ethernet_frame          &eth,
 			_src_port(prot, prot_base, remote_side.dst_port());
 			_dst_port(prot, prot_base, remote_side.src_port());
 
+			_update_checksum(prot, prot_base, local_id, ip);
 			remote_domain.interfaces().for_each([&] (Interface &interface) {
-				interface._pass_prot(eth, size_guard, ip, prot, prot_base, prot_size);
+				interface._pass_prot(eth, size_guard, ip);
 			});
 			_link_packet(prot, prot_base, link, client);
 			return;
@@ -1154,7 +1186,7 @@ void Interface::_handle_ip(Ethernet_frame          &eth,
 					_dst_port(prot, prot_base, rule.to_port());
 				}
 				_nat_link_and_pass(eth, size_guard, ip, prot, prot_base,
-				                   prot_size, local_id, local_domain, remote_domain);
+				                   local_id, local_domain, remote_domain);
 				return;
 			}
 			catch (Forward_rule_tree::No_match) { }
@@ -1173,8 +1205,8 @@ void Interface::_handle_ip(Ethernet_frame          &eth,
 			}
 			Domain &remote_domain = permit_rule.domain();
 			_adapt_eth(eth, local_id.dst_ip, pkt, remote_domain);
-			_nat_link_and_pass(eth, size_guard, ip, prot, prot_base, prot_size,
-			                   local_id, local_domain, remote_domain);
+			_nat_link_and_pass(eth, size_guard, ip, prot, prot_base, local_id,
+			                   local_domain, remote_domain);
 			return;
 		}
 		catch (Transport_rule_list::No_match) { }
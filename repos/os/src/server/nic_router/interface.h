@@ -232,7 +232,6 @@ class Net::Interface : private Interface_list::Element
 		                        Packet_descriptor const &pkt,
 		                        L3_protocol              prot,
 		                        void                    *prot_base,
-		                        Genode::size_t           prot_size,
 		                        Domain                  &local_domain);
 
 		void _handle_icmp_error(Ethernet_frame          &eth,
@@ -263,7 +262,6 @@ class Net::Interface : private Interface_list::Element
 		                        Ipv4_packet            &ip,
 		                        L3_protocol      const  prot,
 		                        void            *const  prot_base,
-		                        Genode::size_t   const  prot_size,
 		                        Link_side_id     const &local_id,
 		                        Domain                 &local_domain,
 		                        Domain                 &remote_domain);
@@ -275,12 +273,9 @@ class Net::Interface : private Interface_list::Element
 		                       Size_guard     &size_guard,
 		                       Domain         &local_domain);
 
-		void _pass_prot(Ethernet_frame         &eth,
-		                Size_guard             &size_guard,
-		                Ipv4_packet            &ip,
-		                L3_protocol      const  prot,
-		                void            *const  prot_base,
-		                Genode::size_t   const  prot_size);
+		void _pass_prot(Ethernet_frame &eth,
+		                Size_guard     &size_guard,
+		                Ipv4_packet    &ip);
 
 		void _pass_ip(Ethernet_frame       &eth,
 		              Size_guard           &size_guard,
@@ -0,0 +1,177 @@
+/*
+ * \brief  Path-compressed binary trie for longest-prefix matching
+ * \author Genode Labs
+ * \date   2026-10-15
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _IPV4_PREFIX_TRIE_H_
+#define _IPV4_PREFIX_TRIE_H_
+
+/* local includes */
+#include <ipv4_address_prefix.h>
+
+/* Genode includes */
+#include <base/allocator.h>
+
+namespace Net { template <typename> class Ipv4_prefix_trie; }
+
+
+/**
+ * Patricia trie that maps IPv4 address prefixes to items
+ *
+ * Each node covers a prefix and branches on the first bit behind it. Nodes
+ * without an item only exist where the prefixes of two sub-tries diverge.
+ * Hence, a lookup visits at most 33 nodes regardless of the number of
+ * prefixes.
+ */
+template <typename T>
+class Net::Ipv4_prefix_trie
+{
+	private:
+
+		using uint32_t = Genode::uint32_t;
+
+		struct Node
+		{
+			uint32_t const  key;
+			unsigned const  len;
+			T const        *item     { nullptr };
+			Node           *child[2] { nullptr, nullptr };
+
+			Node(uint32_t key, unsigned len) : key(key), len(len) { }
+
+			/*
+			 * Noncopyable
+			 */
+			Node(Node const &);
+			Node &operator = (Node const &);
+		};
+
+		Node *_root { nullptr };
+
+		static uint32_t _mask(unsigned len) {
+			return len ? ~(uint32_t)0 << (32 - len) : 0; }
+
+		static unsigned _bit(uint32_t key, unsigned pos) {
+			return (key >> (31 - pos)) & 1; }
+
+		static bool _matches(Node const &node, uint32_t key) {
+			return !((node.key ^ key) & _mask(node.len)); }
+
+		/**
+		 * Return length of the common prefix of two prefixes
+		 */
+		static unsigned _common_len(uint32_t key_a, unsigned len_a,
+		                            uint32_t key_b, unsigned len_b)
+		{
+			unsigned const max = len_a < len_b ? len_a : len_b;
+			uint32_t const diff = key_a ^ key_b;
+			unsigned len = diff ? __builtin_clz(diff) : 32;
+			return len < max ? len : max;
+		}
+
+		static void _destroy(Genode::Deallocator &dealloc, Node *node)
+		{
+			if (!node) {
+				return; }
+
+			_destroy(dealloc, node->child[0]);
+			_destroy(dealloc, node->child[1]);
+			destroy(dealloc, node);
+		}
+
+		/*
+		 * Noncopyable
+		 */
+		Ipv4_prefix_trie(Ipv4_prefix_trie const &);
+		Ipv4_prefix_trie &operator = (Ipv4_prefix_trie const &);
+
+	public:
+
+		Ipv4_prefix_trie() { }
+
+		/**
+		 * Add item for a prefix
+		 *
+		 * If the prefix is already present, its item gets replaced.
+		 *
+		 * \throw Out_of_ram
+		 * \throw Out_of_caps
+		 */
+		void insert(Ipv4_address_prefix const &prefix,
+		            T           const &item,
+		            Genode::Allocator &alloc)
+		{
+			unsigned const len = prefix.prefix < 32 ? prefix.prefix : 32;
+			uint32_t const key = prefix.address.to_uint32_little_endian() &
+			                     _mask(len);
+
+			Node **slot = &_root;
+			while (Node *node = *slot) {
+
+				unsigned const common = _common_len(node->key, node->len, key, len);
+
+				/* the node covers the new prefix, descend */
+				if (common == node->len) {
+					if (common == len) {
+						node->item = &item;
+						return;
+					}
+					slot = &node->child[_bit(key, node->len)];
+					continue;
+				}
+				/* the new prefix covers the node, insert it above */
+				if (common == len) {
+					Node &parent = *new (alloc) Node(key, len);
+					parent.item = &item;
+					parent.child[_bit(node->key, len)] = node;
+					*slot = &parent;
+					return;
+				}
+				/* prefixes diverge, insert a branch node above both */
+				Node &branch = *new (alloc) Node(key & _mask(common), common);
+				Node &leaf   = *new (alloc) Node(key, len);
+				leaf.item = &item;
+				branch.child[_bit(node->key, common)] = node;
+				branch.child[_bit(key,       common)] = &leaf;
+				*slot = &branch;
+				return;
+			}
+			*slot = new (alloc) Node(key, len);
+			(*slot)->item = &item;
+		}
+
+		/**
+		 * Return item of the longest prefix that matches 'ip' or nullptr
+		 */
+		T const *longest_prefix_match(Ipv4_address const &ip) const
+		{
+			uint32_t const key  = ip.to_uint32_little_endian();
+			T const       *best = nullptr;
+			for (Node const *node = _root; node && _matches(*node, key); ) {
+				if (node->item) {
+					best = node->item; }
+
+				if (node->len == 32) {
+					break; }
+
+				node = node->child[_bit(key, node->len)];
+			}
+			return best;
+		}
+
+		void destroy_each(Genode::Deallocator &dealloc)
+		{
+			_destroy(dealloc, _root);
+			_root = nullptr;
+		}
+};
+
+#endif /* _IPV4_PREFIX_TRIE_H_ */
@@ -23,6 +23,7 @@
 #include <framebuffer_session/connection.h>
 #include <os/session_policy.h>
 #include <nitpicker_gfx/tff_font.h>
+#include <timer_session/connection.h>
 
 /* local includes */
 #include "types.h"
@@ -31,6 +32,7 @@
 #include "clip_guard.h"
 #include "pointer_origin.h"
 #include "domain_registry.h"
+#include "tile_painter.h"
 
 namespace Nitpicker {
 	template <typename> class Root;
@@ -369,14 +371,77 @@ struct Nitpicker::Main : Focus_updater
 	 */
 	bool _motion_activity = false;
 
+	/**
+	 * Number of threads used for redrawing the screen
+	 *
+	 * With more than one thread, the dirty area is painted in tiles by the
+	 * tile painter.
+	 */
+	unsigned _paint_threads = 1;
+
+	Constructible<Tile_painter<PT> > _tile_painter { };
+
+	/**
+	 * Timer used for measuring the paint time, if enabled
+	 */
+	Constructible<Timer::Connection> _timer { };
+
+	/**
+	 * Paint-time statistics since the last displays report
+	 */
+	struct Paint_stats
+	{
+		unsigned long frames = 0;
+		uint64_t      sum_us = 0;
+		uint64_t      max_us = 0;
+
+		void add(uint64_t us)
+		{
+			frames++;
+			sum_us += us;
+			max_us  = max(max_us, us);
+		}
+	} _paint_stats { };
+
+	uint64_t _curr_time_us() {
+		return _timer->curr_time().trunc_to_plain_us().value; }
+
 	/**
 	 * Perform redraw and flush pixels to the framebuffer
 	 */
 	void _draw_and_flush()
 	{
-		_view_stack.draw(_fb_screen->screen, _font).flush([&] (Rect const &rect) {
+		uint64_t const start_us = _timer.constructed() ? _curr_time_us() : 0;
+
+		if (_tile_painter.constructed()) {
+
+			Rect const rect =
+				_tile_painter->draw(_view_stack, _fb_screen->fb_ds.local_addr<PT>(),
+				                    _fb_screen->size);
+			if (!rect.valid())
+				return;
+
+			if (_timer.constructed())
+				_paint_stats.add(_curr_time_us() - start_us);
+
+			/* refresh the whole frame at once */
+			_framebuffer.refresh(rect.x1(), rect.y1(), rect.w(), rect.h());
+			return;
+		}
+
+		Dirty_rect dirty = _view_stack.draw(_fb_screen->screen, _font);
+
+		uint64_t const end_us = _timer.constructed() ? _curr_time_us() : 0;
+
+		bool drawn = false;
+		dirty.flush([&] (Rect const &rect) {
 			_framebuffer.refresh(rect.x1(), rect.y1(),
-			                     rect.w(),  rect.h()); });
+			                     rect.w(),  rect.h());
+			drawn = true;
+		});
+
+		if (drawn && _timer.constructed())
+			_paint_stats.add(end_us - start_us);
 	}
 
 	Main(Env &env) : _env(env)
@@ -480,12 +545,15 @@ void Nitpicker::Main::_handle_input()
 		_view_stack.geometry(_pointer_origin, Rect(_user_state.pointer_pos(), Area()));
 
 	/* perform redraw and flush pixels to the framebuffer */
-	_view_stack.draw(_fb_screen->screen, _font).flush([&] (Rect const &rect) {
-		_framebuffer.refresh(rect.x1(), rect.y1(),
-		                     rect.w(),  rect.h()); });
+	_draw_and_flush();
 
 	_view_stack.mark_all_views_as_clean();
 
+	/* report paint times periodically */
+	if (_displays_reporter.enabled() && _paint_stats.frames
+	 && (_period_cnt % _activity_threshold == 0))
+		_report_displays();
+
 	/* deliver framebuffer synchronization events */
 	for (Session_component *s = _session_list.first(); s; s = s->next())
 		s->submit_sync();
@@ -586,6 +654,24 @@ void Nitpicker::Main::_handle_config()
 		_handle_focus();
 	}
 
+	/* enable tiled painting by multiple threads */
+	unsigned const paint_threads = config.attribute_value("paint_threads", 1U);
+	if (paint_threads != _paint_threads) {
+		_paint_threads = paint_threads;
+		_tile_painter.destruct();
+		if (_paint_threads > 1)
+			_tile_painter.construct(_env, _sliced_heap, _paint_threads,
+			                        _binary_default_tff_start);
+	}
+
+	/* measure paint times to be reported along with the displays report */
+	bool const paint_time = config.has_sub_node("report")
+	                     && config.sub_node("report").attribute_value("paint_time", false);
+	if (paint_time && !_timer.constructed())
+		_timer.construct(_env);
+	if (!paint_time)
+		_timer.destruct();
+
 	/* disable builtin focus handling when using an external focus policy */
 	_user_state.focus_via_click(!_focus_rom.constructed());
 
@@ -607,8 +693,21 @@ void Nitpicker::Main::_report_displays()
 		xml.node("display", [&] () {
 			xml.attribute("width",  _fb_screen->size.w());
 			xml.attribute("height", _fb_screen->size.h());
+
+			if (!_timer.constructed())
+				return;
+
+			xml.node("paint", [&] () {
+				xml.attribute("threads", _paint_threads);
+				xml.attribute("frames",  _paint_stats.frames);
+				if (_paint_stats.frames)
+					xml.attribute("avg_us", _paint_stats.sum_us / _paint_stats.frames);
+				xml.attribute("max_us",  _paint_stats.max_us);
+			});
 		});
 	});
+
+	_paint_stats = Paint_stats();
 }
 
 
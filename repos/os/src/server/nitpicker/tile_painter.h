@@ -0,0 +1,233 @@
+/*
+ * \brief  Parallel redraw of the view stack in screen tiles
+ * \author Genode Labs
+ * \date   2026-10-15
+ *
+ * The screen is split into a grid of square tiles. The dirty tiles are
+ * distributed round-robin among the entrypoint and a number of worker
+ * threads, each drawing via its own canvas and font. Each tile is drawn
+ * once by a single thread, clipped to the dirty parts of the tile. The
+ * view stack is not modified while drawing because the entrypoint waits
+ * for all workers to finish before returning.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+#ifndef _TILE_PAINTER_H_
+#define _TILE_PAINTER_H_
+
+/* Genode includes */
+#include <base/env.h>
+#include <base/semaphore.h>
+#include <base/thread.h>
+#include <nitpicker_gfx/tff_font.h>
+
+/* local includes */
+#include "view_stack.h"
+
+namespace Nitpicker { template <typename> class Tile_painter; }
+
+
+template <typename PT>
+class Nitpicker::Tile_painter
+{
+	public:
+
+		enum { TILE_SIZE = 128, MAX_THREADS = 16 };
+
+	private:
+
+		/**
+		 * Frame to be drawn, defined by the entrypoint
+		 */
+		struct Job
+		{
+			View_stack const *view_stack = nullptr;
+			PT               *base       = nullptr;
+			Area              size       { };
+			Dirty_rect        dirty      { };
+			Rect              area       { };  /* bounding box of 'dirty' */
+		};
+
+		struct Painter
+		{
+			Tff_font::Static_glyph_buffer<4096> _glyph_buffer { };
+
+			Tff_font const _font;
+
+			Painter(void const *tff) : _font(tff, _glyph_buffer) { }
+
+			/**
+			 * Return bounding box of the dirty parts of 'tile'
+			 */
+			static Rect _dirty_part(Job const &job, Rect const tile)
+			{
+				/* flush a copy to keep the job intact for the other painters */
+				Dirty_rect dirty = job.dirty;
+
+				Rect result { };
+				dirty.flush([&] (Rect const &dirty_rect) {
+					Rect const part = Rect::intersect(dirty_rect, tile);
+					if (part.valid())
+						result = result.valid() ? Rect::compound(result, part) : part;
+				});
+				return result;
+			}
+
+			/**
+			 * Draw the dirty tiles of the job that belong to 'index' of 'count'
+			 *
+			 * The tiles of the screen grid are disjoint. So no pixel is drawn
+			 * by more than one thread, even if the dirty rectangles overlap.
+			 */
+			void paint(Job const &job, unsigned index, unsigned count)
+			{
+				Canvas<PT> canvas(job.base, job.size);
+
+				/* align the tile grid to the screen origin */
+				int const x1 = job.area.x1() - job.area.x1() % TILE_SIZE;
+				int const y1 = job.area.y1() - job.area.y1() % TILE_SIZE;
+
+				unsigned tile = 0;
+				for (int y = y1; y <= job.area.y2(); y += TILE_SIZE)
+					for (int x = x1; x <= job.area.x2(); x += TILE_SIZE) {
+
+						Rect const clip =
+							_dirty_part(job, Rect(Point(x, y), Area(TILE_SIZE, TILE_SIZE)));
+
+						if (!clip.valid() || tile++ % count != index)
+							continue;
+
+						job.view_stack->draw(canvas, _font, clip);
+					}
+			}
+		};
+
+		struct Worker : Thread
+		{
+			enum { STACK_SIZE = 16*1024*sizeof(long) };
+
+			Tile_painter  &_tile_painter;
+			unsigned const _index;
+			Painter        _painter;
+			Semaphore      _start { };
+
+			Worker(Env &env, Tile_painter &tile_painter, unsigned index,
+			       Affinity::Location location, void const *tff)
+			:
+				Thread(env, "tile_painter", STACK_SIZE, location, Weight(), env.cpu()),
+				_tile_painter(tile_painter), _index(index), _painter(tff)
+			{ }
+
+			void entry() override
+			{
+				for (;;) {
+					_start.down();
+
+					if (_tile_painter._stop)
+						return;
+
+					_painter.paint(_tile_painter._job, _index, _tile_painter._count);
+					_tile_painter._done.up();
+				}
+			}
+		};
+
+		Allocator      &_alloc;
+		unsigned const  _count;
+		Painter         _painter;
+		Worker         *_workers[MAX_THREADS] { };
+		Semaphore       _done { };
+		Job             _job  { };
+		bool            _stop { false };
+
+		/*
+		 * Noncopyable
+		 */
+		Tile_painter(Tile_painter const &);
+		Tile_painter &operator = (Tile_painter const &);
+
+	public:
+
+		/**
+		 * Constructor
+		 *
+		 * \param threads  number of painting threads including the caller
+		 * \param tff      font used for view labels
+		 *
+		 * The workers are placed on consecutive CPUs of the affinity space,
+		 * starting with the CPU next to the first one.
+		 */
+		Tile_painter(Env &env, Allocator &alloc, unsigned threads, void const *tff)
+		:
+			_alloc(alloc),
+			_count(max(1U, min(threads, (unsigned)MAX_THREADS))),
+			_painter(tff)
+		{
+			Affinity::Space space = env.cpu().affinity_space();
+
+			for (unsigned i = 1; i < _count; i++) {
+				_workers[i] = new (_alloc)
+					Worker(env, *this, i, space.location_of_index(i), tff);
+				_workers[i]->start();
+			}
+		}
+
+		~Tile_painter()
+		{
+			/* let the workers leave their loop before destroying them */
+			_stop = true;
+
+			for (unsigned i = 1; i < _count; i++)
+				_workers[i]->_start.up();
+
+			for (unsigned i = 1; i < _count; i++) {
+				_workers[i]->join();
+				destroy(_alloc, _workers[i]);
+			}
+		}
+
+		unsigned threads() const { return _count; }
+
+		/**
+		 * Draw dirty areas of view stack
+		 *
+		 * \return  bounding box of the drawn areas
+		 */
+		Rect draw(View_stack &view_stack, PT *base, Area size)
+		{
+			_job.view_stack = &view_stack;
+			_job.base       = base;
+			_job.size       = size;
+			_job.dirty      = view_stack.take_dirty_rect();
+
+			Rect bounding_box { };
+			Dirty_rect dirty = _job.dirty;
+			dirty.flush([&] (Rect const &rect) {
+				bounding_box = bounding_box.valid()
+				             ? Rect::compound(bounding_box, rect) : rect; });
+
+			bounding_box = Rect::intersect(bounding_box, Rect(Point(), size));
+			if (!bounding_box.valid())
+				return bounding_box;
+
+			_job.area = bounding_box;
+
+			for (unsigned i = 1; i < _count; i++)
+				_workers[i]->_start.up();
+
+			_painter.paint(_job, 0, _count);
+
+			for (unsigned i = 1; i < _count; i++)
+				_done.down();
+
+			return bounding_box;
+		}
+};
+
+#endif /* _TILE_PAINTER_H_ */
@@ -130,6 +130,27 @@ class Nitpicker::View_stack
 			return result;
 		}
 
+		/**
+		 * Draw views within 'rect'
+		 */
+		void draw(Canvas_base &canvas, Font const &font, Rect rect) const
+		{
+			draw_rec(canvas, font, _first_view(), rect);
+		}
+
+		/**
+		 * Return dirty areas and reset them
+		 *
+		 * This method is meant for drawing the dirty areas piecewise via
+		 * 'draw(Canvas_base &, Font const &, Rect)'.
+		 */
+		Dirty_rect take_dirty_rect()
+		{
+			Dirty_rect result = _dirty_rect;
+			_dirty_rect = Dirty_rect();
+			return result;
+		}
+
 		/**
 		 * Trigger redraw of the whole view stack
 		 */
@@ -17,6 +17,7 @@
 /* Genode includes */
 #include <report_rom/rom_registry.h>
 #include <os/session_policy.h>
+#include <rm_session/connection.h>
 
 namespace Rom { struct Registry; }
 
@@ -25,11 +26,15 @@ struct Rom::Registry : Registry_for_reader, Registry_for_writer, Genode::Noncopy
 {
 	private:
 
+		Genode::Env                    &_env;
 		Genode::Allocator              &_md_alloc;
 		Genode::Ram_allocator          &_ram;
 		Genode::Region_map             &_rm;
 		Genode::Attached_rom_dataspace &_config_rom;
 
+		/* used for the read-only views of shared buffers */
+		Genode::Constructible<Genode::Rm_connection> _rm_connection { };
+
 		Module_list _modules { };
 
 		struct Read_write_policy : Module::Read_policy, Module::Write_policy
@@ -71,8 +76,15 @@ struct Rom::Registry : Registry_for_reader, Registry_for_writer, Genode::Noncopy
 			/* XXX proper accounting for the used memory is missing */
 			/* XXX if we run out of memory, the server will abort */
 
+			unsigned const num_buffers =
+				_config_rom.xml().attribute_value("shared_buffers", 0U);
+
+			if (num_buffers && !_rm_connection.constructed())
+				_rm_connection.construct(_env);
+
 			Module * const module = new (&_md_alloc)
-				Module(_ram, _rm, name, _read_write_policy, _read_write_policy);
+				Module(_ram, _rm, name, _read_write_policy, _read_write_policy,
+				       num_buffers ? &*_rm_connection : nullptr, num_buffers);
 
 			_modules.insert(module);
 			return *module;
@@ -133,11 +145,11 @@ struct Rom::Registry : Registry_for_reader, Registry_for_writer, Genode::Noncopy
 
 	public:
 
-		Registry(Genode::Allocator &md_alloc,
-		         Genode::Ram_allocator &ram, Genode::Region_map &rm,
+		Registry(Genode::Env &env, Genode::Allocator &md_alloc,
 		         Genode::Attached_rom_dataspace &config_rom)
 		:
-			_md_alloc(md_alloc), _ram(ram), _rm(rm), _config_rom(config_rom)
+			_env(env), _md_alloc(md_alloc), _ram(env.ram()), _rm(env.rm()),
+			_config_rom(config_rom)
 		{ }
 
 		Module &lookup(Writer &writer, Module::Name const &name) override
@@ -116,6 +116,9 @@ class Vfs_server::Session_component : private Session_resources,
 
 		bool const _writable;
 
+		/* number of packets processed concurrently per node */
+		unsigned const _queue_depth;
+
 
 		/****************************
 		 ** Handle to node mapping **
@@ -308,7 +311,8 @@ class Vfs_server::Session_component : private Session_resources,
 		                  Node_queue           &pending_nodes,
 		                  Session_queue        &pending_sessions,
 		                  char           const *root_path,
-		                  bool                  writable)
+		                  bool                  writable,
+		                  unsigned              queue_depth)
 		:
 			Session_resources(env.pd(), env.rm(), ram_quota, cap_quota, tx_buf_size),
 			Session_rpc_object(_packet_ds.cap(), env.rm(), env.ep().rpc_ep()),
@@ -318,7 +322,8 @@ class Vfs_server::Session_component : private Session_resources,
 			_pending_sessions(pending_sessions),
 			_root_path(root_path),
 			_label(label),
-			_writable(writable)
+			_writable(writable),
+			_queue_depth(queue_depth)
 		{
 			/*
 			 * Register an I/O signal handler for
@@ -376,7 +381,7 @@ class Vfs_server::Session_component : private Session_resources,
 			Directory *dir;
 			try { dir = new (_alloc) Directory(_node_space, _vfs, _alloc,
 			                                   _pending_nodes, _stream,
-			                                   path_str, create); }
+			                                   path_str, create, _queue_depth); }
 			catch (Out_of_memory) { throw Out_of_ram(); }
 
 			return Dir_handle(dir->id().value);
@@ -694,6 +699,21 @@ class Vfs_server::Root : public Genode::Root_component<Session_component>
 			if (!tx_buf_size)
 				throw Service_denied();
 
+			/*
+			 * The client may ask for several packets per node to be
+			 * processed in a pipelined fashion, bounded by the number of
+			 * packets the client keeps in flight and the capacity of the
+			 * packet-stream queue.
+			 */
+			unsigned long const tx_queue_size =
+				max(1UL, min((unsigned long)::File_system::Session::TX_QUEUE_SIZE,
+				             Arg_string::find_arg(args, "tx_queue_size")
+				                 .ulong_value(::File_system::Session::TX_QUEUE_SIZE)));
+
+			unsigned const queue_depth =
+				max(1UL, min(tx_queue_size,
+				             Arg_string::find_arg(args, "queue_depth").ulong_value(1)));
+
 			size_t session_size =
 				max((size_t)4096, sizeof(Session_component)) +
 				tx_buf_size;
@@ -756,7 +776,7 @@ class Vfs_server::Root : public Genode::Root_component<Session_component>
 				                  tx_buf_size, _vfs_env.root_dir(),
 				                  _progress_handler.pending_nodes,
 				                  _progress_handler.pending_sessions,
-				                  session_root.base(), writeable);
+				                  session_root.base(), writeable, queue_depth);
 
 			auto ram_used = _env.pd().used_ram().value - initial_ram_usage;
 			auto cap_used = _env.pd().used_caps().value - initial_cap_usage;
@@ -20,6 +20,7 @@
 #include <vfs/file_system.h>
 #include <os/path.h>
 #include <base/id_space.h>
+#include <util/construct_at.h>
 
 /* Local includes */
 #include "assert.h"
@@ -36,6 +37,7 @@ namespace Vfs_server {
 	typedef ::File_system::Session::Tx::Sink Packet_stream;
 
 	class Node;
+	class Packet_queue;
 	class Io_node;
 	class Watch_node;
 	class Directory;
@@ -151,8 +153,79 @@ class Vfs_server::Node : public  ::File_system::Node_base,
 };
 
 
+/**
+ * Packets of a node awaiting processing in the order of their arrival
+ */
+class Vfs_server::Packet_queue
+{
+	private:
+
+		/*
+		 * Noncopyable
+		 */
+		Packet_queue(Packet_queue const &);
+		Packet_queue &operator = (Packet_queue const &);
+
+		Genode::Allocator       &_alloc;
+		unsigned          const  _capacity;
+		Packet_descriptor *const _packets;
+
+		unsigned _head  = 0;
+		unsigned _count = 0;
+
+	public:
+
+		Packet_queue(Genode::Allocator &alloc, unsigned capacity)
+		:
+			_alloc(alloc), _capacity(Genode::max(capacity, 1U)),
+			_packets((Packet_descriptor *)alloc.alloc(_capacity*sizeof(Packet_descriptor)))
+		{ }
+
+		~Packet_queue() {
+			_alloc.free(_packets, _capacity*sizeof(Packet_descriptor)); }
+
+		unsigned capacity() const { return _capacity; }
+		unsigned count()    const { return _count; }
+
+		void enqueue(Packet_descriptor const &packet)
+		{
+			if (_count == _capacity)
+				return;
+
+			Genode::construct_at<Packet_descriptor>(
+				&_packets[(_head + _count) % _capacity], packet);
+			_count++;
+		}
+
+		/**
+		 * Remove oldest packet from queue
+		 *
+		 * \return false if the queue is empty
+		 */
+		bool dequeue(Packet_descriptor &packet)
+		{
+			if (_count == 0)
+				return false;
+
+			packet = _packets[_head];
+			_head = (_head + 1) % _capacity;
+			_count--;
+			return true;
+		}
+};
+
+
 /**
  * Super-class for nodes that process read/write packets
+ *
+ * A node accepts up to the session's queue depth of packets. They are
+ * processed one after another because the VFS handle supports only one
+ * pending operation. Hence, the queue does not add concurrency to a single
+ * handle. It merely keeps a busy node from stalling the session's packet
+ * stream so that packets for other nodes of the session are passed to the
+ * VFS meanwhile. Once the VFS completes an operation, the next packet of
+ * the node is processed immediately. A node that cannot make progress is
+ * retried by the post-signal hook.
  */
 class Vfs_server::Io_node : public Vfs_server::Node,
                             public Vfs::Io_response_handler{
@@ -173,6 +246,55 @@ class Vfs_server::Io_node : public Vfs_server::Node,
 		bool _packet_queued = false;
 		bool _packet_op_pending = false;
 
+		/* packets received after '_packet' */
+		Packet_queue _queue;
+
+		/*
+		 * Return true if the node cannot take another packet
+		 */
+		bool _queue_full() const {
+			return (_packet_queued ? 1 : 0) + _queue.count() >= _queue.capacity(); }
+
+		/**
+		 * Process the packet stored at '_packet'
+		 *
+		 * Return true if the packet was processed.
+		 */
+		bool _process_packet()
+		{
+			bool result = true;
+
+			switch (_packet.operation()) {
+			case Packet_descriptor::READ:  result =  _read(); break;
+			case Packet_descriptor::WRITE: result = _write(); break;
+			case Packet_descriptor::SYNC:  result =  _sync(); break;
+
+			case Packet_descriptor::READ_READY:
+				/*
+				 * the read-ready pending state is managed
+				 * by the VFS, this packet can be discarded
+				 */
+				_drop_packet();
+
+				if (_handle.fs().read_ready(&_handle)) {
+					/* if the handle is ready, send a packet back immediately */
+					read_ready_response();
+				} else {
+					/* register to send READ_READY later */
+					_handle.fs().notify_read_ready(&_handle);
+				}
+
+				break;
+
+			case Packet_descriptor::CONTENT_CHANGED:
+				/* discard this packet */
+				_drop_packet();
+				break;
+			}
+
+			return result;
+		}
+
 	protected:
 
 		Vfs::Vfs_handle &_handle;
@@ -183,6 +305,9 @@ class Vfs_server::Io_node : public Vfs_server::Node,
 		 */
 		Packet_descriptor _packet { };
 
+		/* maximum number of packets queued at this node */
+		unsigned const _queue_depth;
+
 		/**
 		 * Abstract read implementation
 		 *
@@ -315,6 +440,19 @@ class Vfs_server::Io_node : public Vfs_server::Node,
 			return true;
 		}
 
+		/**
+		 * Retry processing via the post-signal hook if the node is not idle
+		 *
+		 * Packets that cannot be processed immediately, e.g., because the
+		 * VFS cannot queue the request or the packet stream cannot take the
+		 * acknowledgement, are otherwise never retried.
+		 */
+		void _schedule_io(bool idle)
+		{
+			if (!idle && !enqueued())
+				_response_queue.enqueue(*this);
+		}
+
 		/**
 		 * Virtual methods for specialized node-type I/O
 		 */
@@ -325,9 +463,11 @@ class Vfs_server::Io_node : public Vfs_server::Node,
 
 		Io_node(Node_space &space, char const *node_path, Mode node_mode,
 		        Node_queue &response_queue, Packet_stream &stream,
-		        Vfs_handle &handle)
+		        Vfs_handle &handle, Genode::Allocator &alloc,
+		        unsigned queue_depth)
 		: Node(space, node_path, response_queue, stream),
-		  _mode(node_mode), _handle(handle)
+		  _mode(node_mode), _queue(alloc, queue_depth),
+		  _handle(handle), _queue_depth(queue_depth)
 		{
 			_handle.handler(this);
 		}
@@ -341,47 +481,25 @@ class Vfs_server::Io_node : public Vfs_server::Node,
 		using Node_space::Element::id;
 
 		/**
-		 * Process the packet that is queued at this handle
+		 * Process the packets that are queued at this handle
 		 *
 		 * Return true if the node was processed and is now idle.
 		 */
 		bool process_io() override
 		{
-			if (!_packet_queued) return true;
-			if (!_stream.ready_to_ack())
-				return false;
-
-			bool result = true;
-
-			switch (_packet.operation()) {
-			case Packet_descriptor::READ:  result =  _read(); break;
-			case Packet_descriptor::WRITE: result = _write(); break;
-			case Packet_descriptor::SYNC:  result =  _sync(); break;
-
-			case Packet_descriptor::READ_READY:
-				/*
-				 * the read-ready pending state is managed
-				 * by the VFS, this packet can be discarded
-				 */
-				_drop_packet();
-
-				if (_handle.fs().read_ready(&_handle)) {
-					/* if the handle is ready, send a packet back immediately */
-					read_ready_response();
-				} else {
-					/* register to send READ_READY later */
-					_handle.fs().notify_read_ready(&_handle);
+			for (;;) {
+				if (!_packet_queued) {
+					if (!_queue.dequeue(_packet))
+						return true;
+					_packet_queued = true;
 				}
 
-				break;
+				if (!_stream.ready_to_ack())
+					return false;
 
-			case Packet_descriptor::CONTENT_CHANGED:
-				/* discard this packet */
-				_drop_packet();
-				break;
+				if (!_process_packet())
+					return false;
 			}
-
-			return result;
 		}
 
 		/**
@@ -393,14 +511,17 @@ class Vfs_server::Io_node : public Vfs_server::Node,
 		 */
 		bool process_packet(Packet_descriptor const &packet)
 		{
-			/* attempt to clear any pending packet */
-			if (!process_io())
+			/* attempt to clear pending packets */
+			bool const idle = process_io();
+
+			if (_queue_full()) {
+				_schedule_io(idle);
 				return false;
+			}
 
 			/* otherwise store the packet locally and process */
-			_packet = packet;
-			_packet_queued = true;
-			process_io();
+			_queue.enqueue(packet);
+			_schedule_io(process_io());
 			return true;
 		}
 
@@ -590,9 +711,10 @@ struct Vfs_server::Symlink : Io_node
 		        Packet_stream     &stream,
 		        char       const  *link_path,
 		        Mode               mode,
-		        bool               create)
+		        bool               create,
+		        unsigned           queue_depth)
 		: Io_node(space, link_path, mode, response_queue, stream,
-		          _open(vfs, alloc, link_path, create))
+		          _open(vfs, alloc, link_path, create), alloc, queue_depth)
 		{ }
 };
 
@@ -681,10 +803,12 @@ class Vfs_server::File : public Io_node
 		     Packet_stream     &stream,
 		     char       const  *file_path,
 		     Mode               fs_mode,
-		     bool               create)
+		     bool               create,
+		     unsigned           queue_depth)
 		:
 			Io_node(space, file_path, fs_mode, response_queue, stream,
-			        _open(vfs, alloc, file_path, fs_mode, create))
+			        _open(vfs, alloc, file_path, fs_mode, create),
+			        alloc, queue_depth)
 		{
 			_leaf_path = vfs.leaf_path(path());
 		}
@@ -782,9 +906,10 @@ struct Vfs_server::Directory : Io_node
 		          Node_queue        &response_queue,
 		          Packet_stream     &stream,
 		          char const        *dir_path,
-		          bool               create)
+		          bool               create,
+		          unsigned           queue_depth)
 		: Io_node(space, dir_path, READ_ONLY, response_queue, stream,
-		          _open(vfs, alloc, dir_path, create))
+		          _open(vfs, alloc, dir_path, create), alloc, queue_depth)
 		{ }
 
 		/**
@@ -804,7 +929,8 @@ struct Vfs_server::Directory : Io_node
 			try {
 				file = new (alloc) File(space, vfs, alloc,
 				                        _response_queue, _stream,
-				                        path_str, mode, create);
+				                        path_str, mode, create,
+				                        _queue_depth);
 			} catch (Out_of_memory) { throw Out_of_ram(); }
 
 			if (create)
@@ -828,7 +954,8 @@ struct Vfs_server::Directory : Io_node
 			Symlink *link;
 			try { link = new (alloc) Symlink(space, vfs, alloc,
 			                                 _response_queue, _stream,
-			                                 path_str, mode, create); }
+			                                 path_str, mode, create,
+			                                 _queue_depth); }
 			catch (Out_of_memory) { throw Out_of_ram(); }
 			if (create)
 				mark_as_updated();
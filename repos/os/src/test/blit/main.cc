@@ -0,0 +1,164 @@
+/*
+ * \brief  Blit-library correctness and throughput test
+ * \author Genode Labs
+ * \date   2026-10-15
+ *
+ * The test first compares the result of blits with a bytewise reference
+ * copy for a range of alignments and widths. It then measures the
+ * throughput of full-screen blits, which take the non-temporal path, and of
+ * small rectangles, which take the cached path.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <blit/blit.h>
+#include <timer_session/connection.h>
+
+using namespace Genode;
+
+
+struct Main
+{
+	enum {
+		DURATION_MS = 1000,
+
+		/* full-HD screen at 32 bits per pixel */
+		LINE_BYTES  = 1920*4,
+		LINES       = 1080,
+		SIZE        = LINE_BYTES*LINES,
+	};
+
+	Env               &env;
+	Heap               heap  { env.ram(), env.rm() };
+	Timer::Connection  timer { env };
+
+	char *_alloc_buffer()
+	{
+		char *buf = nullptr;
+		heap.alloc(SIZE, (void **)&buf);
+		return buf;
+	}
+
+	char * const src = _alloc_buffer();
+	char * const dst = _alloc_buffer();
+	char * const ref = _alloc_buffer();
+
+	unsigned errors = 0;
+
+	/**
+	 * Check blit of 'w' x 'h' bytes at the given buffer offsets
+	 */
+	void check(unsigned src_off, unsigned dst_off, int w, int h)
+	{
+		/* limit the comparison to the lines touched by the blit */
+		unsigned const size = min((unsigned)(h + 1)*LINE_BYTES, (unsigned)SIZE);
+
+		memset(dst, 0x55, size);
+		memset(ref, 0x55, size);
+
+		blit(src + src_off, LINE_BYTES, dst + dst_off, LINE_BYTES, w, h);
+
+		/* blit operates at a granularity of 16 bit */
+		for (int y = 0; y < h; y++)
+			for (int x = 0; x < (w & ~1); x++)
+				ref[dst_off + y*LINE_BYTES + x] = src[src_off + y*LINE_BYTES + x];
+
+		for (unsigned i = 0; i < size; i++) {
+			if (dst[i] == ref[i])
+				continue;
+
+			error("blit of ", w, "x", h, " bytes from offset ", src_off,
+			      " to offset ", dst_off, " differs at byte ", i);
+			errors++;
+			return;
+		}
+	}
+
+	void measure(char const *name, unsigned src_off, unsigned dst_off,
+	             int w, int h)
+	{
+		/* move rectangles smaller than the screen across the buffer */
+		unsigned const cols = max(LINE_BYTES / (w + dst_off), 1U);
+		unsigned const rows = LINES / h;
+
+		unsigned long  bytes    = 0;
+		uint64_t const start_ms = timer.elapsed_ms();
+		uint64_t       end_ms   = start_ms;
+		for (unsigned i = 0; end_ms - start_ms < DURATION_MS; i++) {
+
+			unsigned const offset = (i % rows)*h*LINE_BYTES
+			                      + ((i / rows) % cols)*(w + dst_off);
+
+			blit(src + offset + src_off, LINE_BYTES,
+			     dst + offset + dst_off, LINE_BYTES, w, h);
+			bytes += (unsigned long)w*h;
+
+			/* avoid reading the timer for each small blit */
+			if (i % 256 == 0 || (unsigned long)w*h >= SIZE/2)
+				end_ms = timer.elapsed_ms();
+		}
+		log(name, ": ", bytes / ((end_ms - start_ms)*1024), " KiB/ms");
+	}
+
+	Main(Env &env) : env(env)
+	{
+		log("--- blit test ---");
+
+		for (unsigned i = 0; i < SIZE; i++)
+			src[i] = (char)(i*7 + (i >> 8));
+
+		/* widths around the 16-bit, 32-bit, and 32-byte granularities */
+		static int const widths[] = { 1, 2, 4, 6, 30, 32, 34, 62, 64, 66,
+		                              126, 1000, 4098, LINE_BYTES - 32 };
+
+		for (int w : widths)
+			for (unsigned src_off = 0; src_off < 32; src_off += 2)
+				for (unsigned dst_off = 0; dst_off < 32; dst_off += 2)
+					check(src_off, dst_off, w, 3);
+
+		/* large enough to take the non-temporal path */
+		check(0, 0, LINE_BYTES,      LINES);
+		check(2, 2, LINE_BYTES - 32, LINES);
+		check(4, 4, LINE_BYTES - 32, LINES);
+
+		log("correctness: ", errors, " errors");
+
+		measure("aligned screen",    0, 0, LINE_BYTES,      LINES);
+		measure("unaligned screen",  2, 2, LINE_BYTES - 32, LINES);
+		measure("misaligned screen", 4, 4, LINE_BYTES - 32, LINES);
+		measure("aligned 64x64",     0, 0, 64*4,            64);
+		measure("unaligned 64x64",   2, 2, 64*4,            64);
+		measure("narrow 4x1080",     0, 0, 4*4,             LINES);
+
+		heap.free(ref, SIZE);
+		heap.free(dst, SIZE);
+		heap.free(src, SIZE);
+
+		if (errors) {
+			error("test failed");
+			env.parent().exit(-1);
+			return;
+		}
+
+		log("--- blit test finished ---");
+		env.parent().exit(0);
+	}
+
+	/*
+	 * Noncopyable
+	 */
+	Main(Main const &);
+	Main &operator = (Main const &);
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
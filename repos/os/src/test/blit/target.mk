@@ -0,0 +1,3 @@
+TARGET = test-blit
+SRC_CC = main.cc
+LIBS   = base blit
@@ -0,0 +1,132 @@
+/*
+ * \brief  Heap allocation benchmark
+ * \author Genode Labs
+ * \date   2026-10-15
+ *
+ * The benchmark lets 1 to N threads allocate and free small blocks of
+ * varying size from one shared heap and reports the achieved throughput,
+ * once with the plain heap and once with the size-class caches enabled.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/thread.h>
+#include <base/attached_rom_dataspace.h>
+#include <timer_session/connection.h>
+
+using namespace Genode;
+
+
+struct Worker : Thread
+{
+	enum { ROUNDS = 2000, BLOCKS = 64, STACK_SIZE = 16*1024 };
+
+	/*
+	 * Noncopyable
+	 */
+	Worker(Worker const &);
+	Worker &operator = (Worker const &);
+
+	Heap &heap;
+
+	unsigned seed;
+
+	void *blocks[BLOCKS] { };
+
+	bool failed = false;
+
+	Worker(Env &env, Heap &heap, unsigned id)
+	: Thread(env, "worker", STACK_SIZE), heap(heap), seed(id + 1) { }
+
+	/* simple linear congruential generator */
+	size_t _random_size()
+	{
+		seed = seed*1103515245 + 12345;
+		return 8 + (seed >> 16) % 504;
+	}
+
+	void entry() override
+	{
+		for (unsigned r = 0; r < ROUNDS; r++) {
+
+			for (unsigned i = 0; i < BLOCKS; i++)
+				if (!heap.alloc(_random_size(), &blocks[i]))
+					failed = true;
+
+			for (unsigned i = 0; i < BLOCKS; i++)
+				heap.free(blocks[i], 0);
+		}
+	}
+};
+
+
+struct Main
+{
+	enum { MAX_THREADS = 16 };
+
+	Env               &env;
+	Heap               md_heap { env.ram(), env.rm() };
+	Timer::Connection  timer   { env };
+
+	Attached_rom_dataspace config { env, "config" };
+
+	unsigned const max_threads =
+		min((unsigned)MAX_THREADS, config.xml().attribute_value("threads", 4U));
+
+	void _bench(char const *name, unsigned num_threads, bool caches)
+	{
+		Heap heap { env.ram(), env.rm() };
+
+		if (caches && !heap.enable_size_class_caches()) {
+			error("could not enable size-class caches");
+			return;
+		}
+
+		Worker *workers[MAX_THREADS] { };
+		for (unsigned i = 0; i < num_threads; i++)
+			workers[i] = new (md_heap) Worker(env, heap, i);
+
+		uint64_t const start_ms = timer.elapsed_ms();
+
+		for (unsigned i = 0; i < num_threads; i++)
+			workers[i]->start();
+
+		bool failed = false;
+		for (unsigned i = 0; i < num_threads; i++) {
+			workers[i]->join();
+			failed |= workers[i]->failed;
+			destroy(md_heap, workers[i]);
+		}
+
+		uint64_t const ms = max(timer.elapsed_ms() - start_ms, (uint64_t)1);
+
+		uint64_t const ops = (uint64_t)num_threads * Worker::ROUNDS
+		                   * Worker::BLOCKS * 2;
+
+		log(name, ", ", num_threads, " thread(s): ", (ops*1000)/ms,
+		    " alloc+free ops/s", failed ? " (allocation failed)" : "");
+	}
+
+	Main(Env &env) : env(env)
+	{
+		log("--- heap benchmark ---");
+
+		for (unsigned n = 1; n <= max_threads; n *= 2) {
+			_bench("plain heap",        n, false);
+			_bench("size-class caches", n, true);
+		}
+
+		log("--- heap benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
@@ -0,0 +1,516 @@
+/*
+ * \brief  Test for checksum and TCP segmentation offloading of NIC sessions
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * The sender checks the software fallback of the net library locally and
+ * then sends a TCP super frame and a frame with a partial checksum to each
+ * configured receiver. A receiver without offloading expects the frames
+ * split into segments with complete checksums, a receiver with offloading
+ * expects them unmodified.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <nic/xml_node.h>  /* must precede 'util/xml_node.h' */
+#include <base/attached_rom_dataspace.h>
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <nic/packet_allocator.h>
+#include <nic_session/connection.h>
+#include <timer_session/connection.h>
+#include <net/ethernet.h>
+#include <net/internet_checksum.h>
+#include <net/ipv4.h>
+#include <net/offload.h>
+#include <net/tcp.h>
+
+namespace Test {
+
+	using namespace Genode;
+	using namespace Net;
+
+	struct Stream;
+	struct Sender;
+	struct Receiver;
+	struct Main;
+
+	enum {
+		PAYLOAD_SIZE       = 5000,
+		SMALL_PAYLOAD_SIZE = 100,
+		MSS                = 1448,
+		SUPER_PORT         = 5000,
+		SMALL_PORT         = 5001,
+		SEQ_NR             = 1000,
+		BUF_SIZE           = Nic::Packet_allocator::DEFAULT_PACKET_SIZE * 128,
+	};
+
+	/* headers of the test frames, without IP or TCP options */
+	static constexpr size_t IP_OFFSET   = 14;
+	static constexpr size_t TCP_OFFSET  = IP_OFFSET + 20;
+	static constexpr size_t HEADER_SIZE = TCP_OFFSET + 20;
+
+	struct Failed : Exception { };
+
+	template <typename... ARGS>
+	[[noreturn]] static void fail(ARGS &&... args)
+	{
+		error(args...);
+		throw Failed();
+	}
+}
+
+
+using namespace Test;
+
+
+static uint8_t payload_byte(size_t i) { return (uint8_t)(i*7 + 3); }
+
+
+static Nic::Offload_header checksum_header()
+{
+	Nic::Offload_header header;
+	header.flags       = Nic::Offload_header::NEEDS_CSUM;
+	header.csum_start  = TCP_OFFSET;
+	header.csum_offset = 16;
+	return header;
+}
+
+
+static Nic::Offload_header super_frame_header()
+{
+	Nic::Offload_header header = checksum_header();
+	header.gso_type = Nic::Offload_header::GSO_TCPV4;
+	header.hdr_len  = HEADER_SIZE;
+	header.gso_size = MSS;
+	return header;
+}
+
+
+/**
+ * Write TCP/IPv4 frame with a partial checksum to 'dst'
+ *
+ * \return  size of the frame
+ */
+static size_t write_frame(void *dst, Mac_address const &dst_mac,
+                          Mac_address const &src_mac, uint16_t port,
+                          size_t payload_size)
+{
+	uint8_t * const base = (uint8_t *)dst;
+	size_t    const size = HEADER_SIZE + payload_size;
+
+	memset(base, 0, HEADER_SIZE);
+
+	Ethernet_frame &eth = *(Ethernet_frame *)base;
+	eth.dst(dst_mac);
+	eth.src(src_mac);
+	eth.type(Ethernet_frame::Type::IPV4);
+
+	Ipv4_packet &ip = *(Ipv4_packet *)(base + IP_OFFSET);
+	ip.version(4);
+	ip.header_length(5);
+	ip.total_length(size - IP_OFFSET);
+	ip.identification(0x1000);
+	ip.time_to_live(64);
+	ip.protocol(Ipv4_packet::Protocol::TCP);
+	ip.src(Ipv4_packet::ip_from_string("10.0.0.1"));
+	ip.dst(Ipv4_packet::ip_from_string("10.0.0.2"));
+	ip.update_checksum();
+
+	Tcp_packet &tcp = *(Tcp_packet *)(base + TCP_OFFSET);
+	tcp.src_port(Port(4000));
+	tcp.dst_port(Port(port));
+	tcp.seq_nr(SEQ_NR);
+
+	/* data offset, flags ACK|PSH|FIN, and window in network byte order */
+	base[TCP_OFFSET + 12] = 5 << 4;
+	base[TCP_OFFSET + 13] = 0x19;
+	base[TCP_OFFSET + 14] = 0xff;
+	base[TCP_OFFSET + 15] = 0xff;
+
+	for (size_t i = 0; i < payload_size; i++)
+		base[HEADER_SIZE + i] = payload_byte(i);
+
+	/* the checksum field holds the sum of the pseudo header */
+	Ipv4_address src_ip = ip.src(), dst_ip = ip.dst();
+	uint16_t const sum = (uint16_t)~internet_checksum_pseudo_ip(
+		nullptr, 0, host_to_big_endian((uint16_t)(size - TCP_OFFSET)),
+		Ipv4_packet::Protocol::TCP, src_ip, dst_ip);
+	memcpy(base + TCP_OFFSET + 16, &sum, sizeof(sum));
+
+	return size;
+}
+
+
+static bool tcp_checksum_valid(uint8_t const *frame, size_t size)
+{
+	Ipv4_packet const &ip = *(Ipv4_packet const *)(frame + IP_OFFSET);
+
+	Ipv4_address   src_ip   = ip.src(), dst_ip = ip.dst();
+	size_t   const tcp_size = size - TCP_OFFSET;
+
+	return !internet_checksum_pseudo_ip((uint16_t const *)(frame + TCP_OFFSET),
+	                                    tcp_size,
+	                                    host_to_big_endian((uint16_t)tcp_size),
+	                                    Ipv4_packet::Protocol::TCP,
+	                                    src_ip, dst_ip);
+}
+
+
+/**
+ * Check of the segments of one super frame in the order of their arrival
+ */
+struct Test::Stream
+{
+	size_t   _received = 0;
+	unsigned _segments = 0;
+
+	/**
+	 * Check segment and account its payload
+	 *
+	 * \return  true once the whole payload arrived
+	 */
+	bool segment(uint8_t const *frame, size_t size)
+	{
+		if (size < HEADER_SIZE || size > HEADER_SIZE + MSS)
+			fail("segment of unexpected size ", size);
+
+		Ipv4_packet const &ip  = *(Ipv4_packet const *)(frame + IP_OFFSET);
+		Tcp_packet  const &tcp = *(Tcp_packet  const *)(frame + TCP_OFFSET);
+
+		if (ip.total_length() != size - IP_OFFSET || ip.checksum_error())
+			fail("invalid IPv4 header of segment ", _segments);
+
+		if (!tcp_checksum_valid(frame, size))
+			fail("invalid TCP checksum of segment ", _segments);
+
+		/* a segment of a repeated transfer restarts the check */
+		if (tcp.seq_nr() != SEQ_NR + _received) {
+			if (tcp.seq_nr() != SEQ_NR)
+				fail("unexpected sequence number ", tcp.seq_nr());
+
+			_received = 0;
+			_segments = 0;
+		}
+
+		size_t const payload_size = size - HEADER_SIZE;
+		for (size_t i = 0; i < payload_size; i++)
+			if (frame[HEADER_SIZE + i] != payload_byte(_received + i))
+				fail("corrupt payload of segment ", _segments);
+
+		_received += payload_size;
+		_segments++;
+
+		/* PSH and FIN belong to the last segment only */
+		bool const last  = (_received == PAYLOAD_SIZE);
+		bool const flags = (frame[TCP_OFFSET + 13] & 0x09) == 0x09;
+		if (flags != last)
+			fail("unexpected flags of segment ", _segments - 1);
+
+		return last;
+	}
+};
+
+
+/**
+ * Split super frame in software and check the segments
+ */
+static void check_super_frame(uint8_t const *frame, size_t size,
+                              Nic::Offload_header const &header)
+{
+	static uint8_t segment[HEADER_SIZE + MSS];
+
+	Tcp_super_frame const super_frame(frame, size, header);
+
+	if (super_frame.num_segments() != (PAYLOAD_SIZE + MSS - 1) / MSS)
+		fail("unexpected number of segments ", super_frame.num_segments());
+
+	Stream stream;
+	bool   complete = false;
+	for (unsigned i = 0; i < super_frame.num_segments(); i++) {
+		super_frame.write_segment(i, segment);
+		complete = stream.segment(segment, super_frame.segment_size(i));
+	}
+
+	if (!complete)
+		fail("segments of super frame incomplete");
+}
+
+
+/**
+ * Check software fallback of the net library
+ */
+static void check_offload_functions()
+{
+	static uint8_t frame[HEADER_SIZE + PAYLOAD_SIZE];
+
+	Mac_address const mac((uint8_t)0x02);
+
+	size_t const size = write_frame(frame, mac, mac, SUPER_PORT, PAYLOAD_SIZE);
+	check_super_frame(frame, size, super_frame_header());
+
+	size_t const small_size = write_frame(frame, mac, mac, SMALL_PORT,
+	                                      SMALL_PAYLOAD_SIZE);
+	if (tcp_checksum_valid(frame, small_size))
+		fail("partial checksum is complete");
+
+	if (!complete_checksum(frame, small_size, checksum_header()) ||
+	    !tcp_checksum_valid(frame, small_size))
+		fail("checksum completion failed");
+
+	bool rejected = false;
+	try { Tcp_super_frame const frame_without_gso(frame, small_size,
+	                                               checksum_header()); }
+	catch (Tcp_super_frame::Invalid) { rejected = true; }
+	if (!rejected)
+		fail("frame without segmentation accepted as super frame");
+
+	log("software fallback of offload features passed");
+}
+
+
+struct Test::Sender
+{
+	enum { MAX_ROUNDS = 10, PERIOD_US = 500*1000 };
+
+	Env            &_env;
+	Xml_node const  _config;
+
+	Heap                  _heap     { _env.ram(), _env.rm() };
+	Nic::Packet_allocator _tx_alloc { &_heap };
+
+	static Nic::Offload _requested_offload()
+	{
+		Nic::Offload offload;
+		offload.checksum = offload.tso = true;
+		return offload;
+	}
+
+	Nic::Connection   _nic   { _env, &_tx_alloc, BUF_SIZE, BUF_SIZE, "",
+	                           _requested_offload() };
+	Timer::Connection _timer { _env };
+	unsigned          _round { 0 };
+
+	void _send(Mac_address const &dst, uint16_t port, size_t payload_size,
+	           Nic::Offload_header const &header)
+	{
+		Nic::Packet_descriptor packet;
+		try {
+			packet = _nic.tx()->alloc_packet(sizeof(header) + HEADER_SIZE
+			                                 + payload_size);
+		} catch (Nic::Session::Tx::Source::Packet_alloc_failed) {
+			warning("tx packet alloc failed");
+			return;
+		}
+
+		char * const content = _nic.tx()->packet_content(packet);
+		memcpy(content, &header, sizeof(header));
+		Nic::Mac_address src = _nic.mac_address();
+		write_frame(content + sizeof(header), dst, Mac_address(src.addr), port,
+		            payload_size);
+
+		_nic.tx()->submit_packet(packet);
+	}
+
+	void _handle_timeout()
+	{
+		while (_nic.tx()->ack_avail())
+			_nic.tx()->release_packet(_nic.tx()->get_acked_packet());
+
+		if (++_round > MAX_ROUNDS)
+			return;
+
+		_config.for_each_sub_node("receiver", [&] (Xml_node const &node) {
+			Nic::Mac_address mac = node.attribute_value("mac", Nic::Mac_address());
+			_send(Mac_address(mac.addr), SUPER_PORT, PAYLOAD_SIZE,
+			      super_frame_header());
+			_send(Mac_address(mac.addr), SMALL_PORT, SMALL_PAYLOAD_SIZE,
+			      checksum_header());
+		});
+	}
+
+	Signal_handler<Sender> _timeout_handler {
+		_env.ep(), *this, &Sender::_handle_timeout };
+
+	Sender(Env &env, Xml_node const &config) : _env(env), _config(config)
+	{
+		check_offload_functions();
+
+		Nic::Offload const offload = _nic.offload();
+		log("negotiated offload: ", offload);
+		if (!offload.checksum || !offload.tso)
+			fail("offload features not granted");
+
+		_timer.sigh(_timeout_handler);
+		_timer.trigger_periodic(PERIOD_US);
+	}
+};
+
+
+struct Test::Receiver
+{
+	Env &_env;
+
+	Heap                  _heap     { _env.ram(), _env.rm() };
+	Nic::Packet_allocator _tx_alloc { &_heap };
+
+	static Nic::Offload _requested_offload(Xml_node const &config)
+	{
+		Nic::Offload offload;
+		offload.checksum = offload.tso = config.attribute_value("offload", false);
+		return offload;
+	}
+
+	Nic::Connection    _nic;
+	Nic::Offload const _offload { _nic.offload() };
+
+	Stream _stream      { };
+	bool   _super_frame { false };
+	bool   _small_frame { false };
+
+	void _check_frame(uint8_t *frame, size_t size,
+	                  Nic::Offload_header const &header)
+	{
+		if (size < HEADER_SIZE)
+			return;
+
+		Ethernet_frame const &eth = *(Ethernet_frame const *)frame;
+		Ipv4_packet    const &ip  = *(Ipv4_packet const *)(frame + IP_OFFSET);
+		Tcp_packet     const &tcp = *(Tcp_packet const *)(frame + TCP_OFFSET);
+
+		if (eth.type() != Ethernet_frame::Type::IPV4 ||
+		    ip.protocol() != Ipv4_packet::Protocol::TCP)
+			return;
+
+		if (tcp.dst_port() == Port(SMALL_PORT)) {
+
+			if (header.needs_checksum()) {
+				if (!_offload.checksum)
+					fail("partial checksum without checksum offload");
+
+				if (!complete_checksum(frame, size, header))
+					fail("invalid checksum location");
+			}
+			if (size != HEADER_SIZE + SMALL_PAYLOAD_SIZE ||
+			    !tcp_checksum_valid(frame, size))
+				fail("invalid frame with completed checksum");
+
+			_small_frame = true;
+			return;
+		}
+
+		if (!(tcp.dst_port() == Port(SUPER_PORT)))
+			return;
+
+		if (header.super_frame()) {
+			if (!_offload.tso)
+				fail("super frame without segmentation offload");
+
+			if (size != HEADER_SIZE + PAYLOAD_SIZE)
+				fail("super frame of unexpected size ", size);
+
+			check_super_frame(frame, size, header);
+			_super_frame = true;
+			return;
+		}
+
+		if (_offload.tso)
+			fail("super frame split despite segmentation offload");
+
+		if (_stream.segment(frame, size))
+			_super_frame = true;
+	}
+
+	void _handle_rx()
+	{
+		Nic::Session::Rx::Sink &rx = *_nic.rx();
+
+		try {
+			while (rx.packet_avail() && rx.ready_to_ack()) {
+
+				Nic::Packet_descriptor const packet = rx.get_packet();
+
+				uint8_t *frame = (uint8_t *)rx.packet_content(packet);
+				size_t   size  = packet.size();
+
+				Nic::Offload_header header;
+				if (_offload.any()) {
+					if (size < sizeof(header))
+						fail("packet without offload header");
+
+					memcpy(&header, frame, sizeof(header));
+					frame += sizeof(header);
+					size  -= sizeof(header);
+				}
+
+				_check_frame(frame, size, header);
+				rx.acknowledge_packet(packet);
+			}
+		} catch (Failed) {
+			_env.parent().exit(-1);
+			return;
+		}
+
+		if (_super_frame && _small_frame) {
+			log("received offloaded frames (", _offload, ")");
+			_env.parent().exit(0);
+		}
+	}
+
+	Signal_handler<Receiver> _rx_handler {
+		_env.ep(), *this, &Receiver::_handle_rx };
+
+	Receiver(Env &env, Xml_node const &config)
+	:
+		_env(env),
+		_nic(_env, &_tx_alloc, BUF_SIZE, BUF_SIZE, "",
+		     _requested_offload(config))
+	{
+		log("negotiated offload: ", _offload);
+		if (_offload.checksum != _requested_offload(config).checksum ||
+		    _offload.tso      != _requested_offload(config).tso)
+			fail("offload features differ from the requested ones");
+
+		_nic.rx_channel()->sigh_packet_avail(_rx_handler);
+		_nic.rx_channel()->sigh_ready_to_ack(_rx_handler);
+	}
+};
+
+
+struct Test::Main
+{
+	Env &_env;
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Constructible<Sender>   _sender   { };
+	Constructible<Receiver> _receiver { };
+
+	Main(Env &env) : _env(env)
+	{
+		typedef String<16> Role;
+
+		Xml_node const config = _config.xml();
+		Role     const role   = config.attribute_value("role", Role());
+
+		try {
+			if (role == "sender")
+				_sender.construct(_env, config);
+			else if (role == "receiver")
+				_receiver.construct(_env, config);
+			else
+				fail("unknown role '", role, "'");
+		}
+		catch (Failed) { _env.parent().exit(-1); }
+	}
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
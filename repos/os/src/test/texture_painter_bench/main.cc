@@ -0,0 +1,132 @@
+/*
+ * \brief  Texture-painter throughput test
+ * \author Genode Labs
+ * \date   2026-10-15
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/log.h>
+#include <nitpicker_gfx/texture_painter.h>
+#include <os/pixel_rgb565.h>
+#include <os/pixel_rgb888.h>
+#include <timer_session/connection.h>
+
+using namespace Genode;
+
+
+template <typename PT>
+struct Test
+{
+	enum { DURATION_MS = 1000, W = 1024, H = 768 };
+
+	typedef Surface_base::Area  Area;
+	typedef Surface_base::Point Point;
+
+	Env               &env;
+	Timer::Connection &timer;
+	Allocator         &alloc;
+
+	template <typename T>
+	T *_alloc_array()
+	{
+		T *array = nullptr;
+		alloc.alloc(W*H*sizeof(T), (void **)&array);
+		return array;
+	}
+
+	PT            * const dst_pixels = _alloc_array<PT>();
+	PT            * const tex_pixels = _alloc_array<PT>();
+	unsigned char * const tex_alpha  = _alloc_array<unsigned char>();
+
+	Surface<PT> surface { dst_pixels, Area(W, H) };
+
+	Test(Env &env, Timer::Connection &timer, Allocator &alloc)
+	: env(env), timer(timer), alloc(alloc)
+	{
+		/* gradient texture with a mix of opaque, translucent, and clear pixels */
+		for (unsigned y = 0; y < H; y++)
+			for (unsigned x = 0; x < W; x++) {
+				tex_pixels[y*W + x] = PT(x & 0xff, y & 0xff, (x ^ y) & 0xff);
+				tex_alpha [y*W + x] = (x + y) & 0xff;
+			}
+
+		memset(dst_pixels, 0x55, W*H*sizeof(PT));
+	}
+
+	~Test()
+	{
+		alloc.free(tex_alpha,  W*H);
+		alloc.free(tex_pixels, W*H*sizeof(PT));
+		alloc.free(dst_pixels, W*H*sizeof(PT));
+	}
+
+	void measure(char const *pixel_type, char const *mode_name,
+	             Texture_painter::Mode mode, bool alpha)
+	{
+		Texture<PT> const texture(tex_pixels, alpha ? tex_alpha : nullptr,
+		                          Area(W, H));
+
+		unsigned long  pixels   = 0;
+		uint64_t const start_ms = timer.elapsed_ms();
+		uint64_t       end_ms   = start_ms;
+		for (; end_ms - start_ms < DURATION_MS; end_ms = timer.elapsed_ms()) {
+			Texture_painter::paint(surface, texture, Color(127, 127, 127),
+			                       Point(0, 0), mode, true);
+			pixels += W*H;
+		}
+		log(pixel_type, " ", mode_name, ": ",
+		    pixels / ((end_ms - start_ms)*1000), " Mpixels/sec");
+	}
+
+	/*
+	 * Noncopyable
+	 */
+	Test(Test const &);
+	Test &operator = (Test const &);
+};
+
+
+struct Main
+{
+	Env               &env;
+	Heap               heap  { env.ram(), env.rm() };
+	Timer::Connection  timer { env };
+
+	Main(Env &env) : env(env)
+	{
+		log("--- Texture-painter benchmark ---");
+		{
+			Test<Pixel_rgb565> test(env, timer, heap);
+			test.measure("RGB565", "solid",       Texture_painter::SOLID,  false);
+			test.measure("RGB565", "solid alpha", Texture_painter::SOLID,  true);
+			test.measure("RGB565", "mixed",       Texture_painter::MIXED,  false);
+			test.measure("RGB565", "masked",      Texture_painter::MASKED, false);
+		}
+		{
+			Test<Pixel_rgb888> test(env, timer, heap);
+			test.measure("RGB888", "solid",       Texture_painter::SOLID,  false);
+			test.measure("RGB888", "solid alpha", Texture_painter::SOLID,  true);
+			test.measure("RGB888", "mixed",       Texture_painter::MIXED,  false);
+			test.measure("RGB888", "masked",      Texture_painter::MASKED, false);
+		}
+		log("--- Texture-painter benchmark finished ---");
+	}
+
+	/*
+	 * Noncopyable
+	 */
+	Main(Main const &);
+	Main &operator = (Main const &);
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }
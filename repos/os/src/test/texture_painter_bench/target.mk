@@ -0,0 +1,3 @@
+TARGET = test-texture_painter_bench
+SRC_CC = main.cc
+LIBS   = base blit
@@ -0,0 +1,232 @@
+/*
+ * \brief  Measure the overhead of tracing RPC events
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * The test performs RPCs to a local entrypoint, first untraced and then
+ * with the client and the server thread traced by different policies. Each
+ * RPC records four events (call, dispatch, reply, returned), so the
+ * difference of the cycles per RPC divided by four yields the cost of an
+ * event.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/log.h>
+#include <base/rpc_client.h>
+#include <base/rpc_server.h>
+#include <base/trace/buffer.h>
+#include <dataspace/client.h>
+#include <rom_session/connection.h>
+#include <trace/binary_record.h>
+#include <trace_session/connection.h>
+
+namespace Test {
+
+	using namespace Genode;
+
+	struct Nop;
+	struct Nop_client;
+	struct Nop_component;
+	struct Main;
+}
+
+
+struct Test::Nop : Interface
+{
+	virtual void nop() = 0;
+
+	GENODE_RPC(Rpc_nop, void, nop);
+	GENODE_RPC_INTERFACE(Rpc_nop);
+};
+
+
+struct Test::Nop_client : Rpc_client<Nop>
+{
+	explicit Nop_client(Capability<Nop> cap) : Rpc_client<Nop>(cap) { }
+
+	void nop() override { call<Rpc_nop>(); }
+};
+
+
+struct Test::Nop_component : Rpc_object<Nop, Nop_component>
+{
+	void nop() override { }
+};
+
+
+struct Test::Main
+{
+	enum {
+		ROUNDS           = 100*1000,
+		EVENTS_PER_ROUND = 4,
+		BUFFER_SIZE      = 64*1024,
+		MAX_SUBJECTS     = 64,
+		STACK_SIZE       = 4*1024*sizeof(long),
+	};
+
+	static constexpr char const *SERVER_NAME = "trace_overhead_server";
+
+	Env              &_env;
+	Entrypoint        _server_ep { _env, STACK_SIZE, SERVER_NAME, Affinity::Location() };
+	Nop_component     _component { };
+	Nop_client        _client    { _server_ep.manage(_component) };
+	Trace::Connection _trace     { _env, 1024*1024, MAX_SUBJECTS*sizeof(Trace::Subject_id), 0 };
+	Trace::Subject_id _subjects[MAX_SUBJECTS] { };
+	Trace::Subject_id _server_subject { };
+
+	/**
+	 * Return average number of cycles per RPC
+	 */
+	uint64_t _measure()
+	{
+		/* warm up caches and the trace buffers */
+		for (unsigned i = 0; i < ROUNDS / 100; i++)
+			_client.nop();
+
+		Trace::Timestamp const start = Trace::timestamp();
+
+		for (unsigned i = 0; i < ROUNDS; i++)
+			_client.nop();
+
+		return (Trace::timestamp() - start) / ROUNDS;
+	}
+
+	Trace::Policy_id _load_policy(char const *name)
+	{
+		Rom_connection rom(_env, name);
+		Rom_dataspace_capability const rom_ds = rom.dataspace();
+		size_t const size = Dataspace_client(rom_ds).size();
+
+		Trace::Policy_id const id = _trace.alloc_policy(size);
+
+		void *dst = _env.rm().attach(_trace.policy(id));
+		void *src = _env.rm().attach(rom_ds);
+		memcpy(dst, src, size);
+		_env.rm().detach(src);
+		_env.rm().detach(dst);
+
+		return id;
+	}
+
+	/**
+	 * Trace the client and the server thread with the given policy
+	 *
+	 * The client thread is named "ep" like the main thread of any other
+	 * component, e.g., init. Hence, only threads of the session that owns
+	 * the uniquely named server thread are considered.
+	 *
+	 * \return  number of traced threads
+	 */
+	unsigned _trace_threads(Trace::Policy_id policy)
+	{
+		size_t const num_subjects = _trace.subjects(_subjects, MAX_SUBJECTS);
+
+		auto for_each_alive_subject = [&] (auto const &fn) {
+			for (size_t i = 0; i < num_subjects; i++) {
+				Trace::Subject_info const info = _trace.subject_info(_subjects[i]);
+				if (info.state() != Trace::Subject_info::DEAD)
+					fn(_subjects[i], info);
+			}
+		};
+
+		Session_label label { };
+		unsigned servers = 0;
+		for_each_alive_subject([&] (Trace::Subject_id id, Trace::Subject_info const &info) {
+			if (info.thread_name() != SERVER_NAME)
+				return;
+
+			_server_subject = id;
+			label           = info.session_label();
+			servers++;
+		});
+
+		if (servers != 1)
+			return 0;
+
+		unsigned traced = 0;
+		for_each_alive_subject([&] (Trace::Subject_id id, Trace::Subject_info const &info) {
+			if (info.session_label() != label)
+				return;
+
+			if (info.thread_name() != SERVER_NAME && info.thread_name() != "ep")
+				return;
+
+			_trace.trace(id, policy, BUFFER_SIZE);
+			traced++;
+		});
+		return traced;
+	}
+
+	/**
+	 * Return number of valid binary records in the server's trace buffer
+	 */
+	unsigned _binary_records()
+	{
+		Trace::Buffer const &buffer =
+			*(Trace::Buffer const *)_env.rm().attach(_trace.buffer(_server_subject));
+
+		unsigned count = 0;
+		for (Trace::Buffer::Entry e = buffer.first(); !e.last(); e = buffer.next(e))
+			if (Trace::Binary_record::with_record(e.data(), e.length(),
+			                                      [] (auto const &, auto, auto) { }))
+				count++;
+
+		_env.rm().detach(&buffer);
+		return count;
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		log("--- trace overhead test (", (unsigned)ROUNDS, " RPCs per measurement) ---");
+
+		uint64_t const untraced = _measure();
+		log("untraced: ", untraced, " cycles per RPC");
+
+		static char const * const policies[] = { "null", "rpc_name", "binary" };
+
+		for (char const *name : policies) {
+
+			if (_trace_threads(_load_policy(name)) != 2) {
+				error("failed to trace client and server thread");
+				_env.parent().exit(-1);
+				return;
+			}
+
+			uint64_t const cycles   = _measure();
+			uint64_t const overhead = cycles > untraced ? cycles - untraced : 0;
+
+			log(name, ": ", cycles, " cycles per RPC, ",
+			    overhead / EVENTS_PER_ROUND, " cycles per event");
+		}
+
+		/* the buffer of the server holds the records of the last policy */
+		unsigned const records = _binary_records();
+		log("server trace buffer contains ", records, " binary records");
+
+		if (!records) {
+			error("no binary records were written");
+			_env.parent().exit(-1);
+			return;
+		}
+
+		log("--- trace overhead test finished ---");
+		_env.parent().exit(0);
+	}
+
+	/*
+	 * Noncopyable
+	 */
+	Main(Main const &);
+	Main &operator = (Main const &);
+};
+
+
+void Component::construct(Genode::Env &env) { static Test::Main main(env); }
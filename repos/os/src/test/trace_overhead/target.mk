@@ -0,0 +1,3 @@
+TARGET = test-trace_overhead
+SRC_CC = main.cc
+LIBS   = base
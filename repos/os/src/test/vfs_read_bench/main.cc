@@ -0,0 +1,120 @@
+/*
+ * \brief  Sequential read bandwidth of the fs VFS plugin
+ * \author Genode Labs
+ * \date   2026-10-16
+ *
+ * The benchmark reads a file of a file-system session sequentially, once
+ * for each '<depth>' node of the config, with the fs plugin keeping the
+ * given number of read packets in flight per handle.
+ */
+
+/*
+ * Copyright (C) 2026 Genode Labs GmbH
+ *
+ * This file is part of the Genode OS framework, which is distributed
+ * under the terms of the GNU Affero General Public License version 3.
+ */
+
+/* Genode includes */
+#include <base/component.h>
+#include <base/heap.h>
+#include <base/attached_rom_dataspace.h>
+#include <timer_session/connection.h>
+#include <util/xml_generator.h>
+#include <vfs/simple_env.h>
+
+using namespace Genode;
+
+
+struct Main
+{
+	enum { BLOCK_SIZE = 64*1024 };
+
+	Env &_env;
+
+	Heap _heap { _env.ram(), _env.rm() };
+
+	Attached_rom_dataspace _config { _env, "config" };
+
+	Timer::Connection _timer { _env };
+
+	char _block[BLOCK_SIZE];
+
+	uint64_t _curr_time_us() {
+		return _timer.curr_time().trunc_to_plain_us().value; }
+
+	void _measure(unsigned queue_depth, char const *path, Vfs::file_size size,
+	              size_t buffer_size)
+	{
+		using namespace Vfs;
+
+		char vfs_config[256];
+		Xml_generator xml(vfs_config, sizeof(vfs_config), "vfs", [&] () {
+			xml.node("fs", [&] () {
+				xml.attribute("queue_depth", queue_depth);
+				xml.attribute("buffer_size", buffer_size);
+			});
+		});
+
+		Simple_env vfs_env { _env, _heap, Xml_node(vfs_config) };
+
+		Vfs_handle *handle = nullptr;
+		if (vfs_env.root_dir().open(path, Directory_service::OPEN_MODE_RDONLY,
+		                            &handle, _heap) != Directory_service::OPEN_OK) {
+			error("could not open '", path, "'");
+			return;
+		}
+		Vfs_handle::Guard guard(handle);
+
+		uint64_t const start_us = _curr_time_us();
+
+		file_size total = 0;
+		while (total < size) {
+
+			file_size const count = min((file_size)BLOCK_SIZE, size - total);
+
+			while (!handle->fs().queue_read(handle, count))
+				_env.ep().wait_and_dispatch_one_io_signal();
+
+			file_size n = 0;
+			File_io_service::Read_result result;
+			while ((result = handle->fs().complete_read(handle, _block, count, n))
+			       == File_io_service::READ_QUEUED)
+				_env.ep().wait_and_dispatch_one_io_signal();
+
+			if (result != File_io_service::READ_OK || n == 0)
+				break;
+
+			handle->advance_seek(n);
+			total += n;
+		}
+
+		uint64_t const duration_us = max(_curr_time_us() - start_us, (uint64_t)1);
+
+		log("queue_depth=", queue_depth, ": read ", total/1024, " KiB in ",
+		    duration_us/1000, " ms, ", (total*1000*1000/duration_us)/1024, " KiB/s");
+	}
+
+	Main(Env &env) : _env(env)
+	{
+		Xml_node const config = _config.xml();
+
+		typedef String<64> Path;
+		Path const path = config.attribute_value("path", Path("/zero"));
+
+		Number_of_bytes const size =
+			config.attribute_value("size", Number_of_bytes(64*1024*1024));
+
+		Number_of_bytes const buffer_size =
+			config.attribute_value("buffer_size", Number_of_bytes(1024*1024));
+
+		config.for_each_sub_node("depth", [&] (Xml_node depth) {
+			_measure(depth.attribute_value("value", 1U), path.string(),
+			         size, buffer_size); });
+
+		log("--- vfs read benchmark finished ---");
+	}
+};
+
+
+void Component::construct(Env &env) { static Main main(env); }